@@ -0,0 +1,225 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <beyond/algorithm/sort_by_key.hpp>
+#include <beyond/concurrency/thread_pool.hpp>
+#include <beyond/random/generators/xorshift32.hpp>
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Render sort keys and the index of their draw call
+struct DrawList {
+  std::vector<std::uint64_t> keys;
+  std::vector<std::uint32_t> draws;
+};
+
+// The keys are made of a layer, a material, and a depth, so their top bytes
+// are always 0
+auto random_draws(std::size_t count) -> DrawList
+{
+  beyond::xorshift32 rng{1};
+  std::uniform_int_distribution<std::uint64_t> layer{0, 7};
+  std::uniform_int_distribution<std::uint64_t> material{0, 4095};
+  std::uniform_int_distribution<std::uint64_t> depth{0, (1u << 24) - 1};
+  DrawList list{std::vector<std::uint64_t>(count),
+                std::vector<std::uint32_t>(count)};
+  std::ranges::generate(list.keys, [&]() {
+    return layer(rng) << 36 | material(rng) << 24 | depth(rng);
+  });
+  std::iota(list.draws.begin(), list.draws.end(), std::uint32_t{0});
+  return list;
+}
+
+// std::sort over the proxy iterators, which is what sort_by_key did for every
+// key type before it got a radix sort path
+auto proxy_sort(DrawList& list) -> void
+{
+  using Iterator =
+      beyond::detail::SortByKeyIterator<std::uint64_t*, std::uint32_t*>;
+  std::sort(Iterator{0, list.keys.data(), list.draws.data()},
+            Iterator{list.keys.size(), list.keys.data(), list.draws.data()});
+}
+
+} // namespace
+
+TEST_CASE("Sort by key benchmark", "[!benchmark][sort_by_key]")
+{
+  // Every case copies the unsorted list first
+  const DrawList unsorted = random_draws(1'000'000);
+
+  BENCHMARK("Copy")
+  {
+    DrawList list = unsorted;
+    return list.keys.back();
+  };
+
+  BENCHMARK("Proxy std::sort")
+  {
+    DrawList list = unsorted;
+    proxy_sort(list);
+    return list.draws.front();
+  };
+
+  BENCHMARK("sort_by_key")
+  {
+    DrawList list = unsorted;
+    beyond::sort_by_key(list.keys.begin(), list.keys.end(),
+                        list.draws.begin());
+    return list.draws.front();
+  };
+
+  DrawList scratch = unsorted;
+  BENCHMARK("Radix sort with scratch buffers")
+  {
+    DrawList list = unsorted;
+    beyond::radix_sort_by_key(std::span{list.keys}, std::span{list.draws},
+                              std::span{scratch.keys},
+                              std::span{scratch.draws});
+    return list.draws.front();
+  };
+
+  for (const std::size_t thread_count : {1u, 2u, 4u, 8u}) {
+    beyond::ThreadPool pool{thread_count};
+    BENCHMARK("Radix sort with " + std::to_string(thread_count) + " threads")
+    {
+      DrawList list = unsorted;
+      beyond::radix_sort_by_key(std::span{list.keys}, std::span{list.draws},
+                                std::span{scratch.keys},
+                                std::span{scratch.draws}, pool);
+      return list.draws.front();
+    };
+  }
+}
+
+TEST_CASE("Sort by key of small ranges benchmark",
+          "[!benchmark][sort_by_key]")
+{
+  // Where sort_by_key switches from std::sort to the radix sort
+  for (const std::size_t size : {256u, 1024u, 4096u}) {
+    const DrawList unsorted = random_draws(size);
+    BENCHMARK("Proxy std::sort " + std::to_string(size))
+    {
+      DrawList list = unsorted;
+      proxy_sort(list);
+      return list.draws.front();
+    };
+
+    BENCHMARK("Radix sort " + std::to_string(size))
+    {
+      DrawList list = unsorted;
+      beyond::radix_sort_by_key(std::span{list.keys}, std::span{list.draws});
+      return list.draws.front();
+    };
+  }
+}
+
+namespace {
+
+// A mapped type much larger than its key
+struct LargeMapped {
+  std::array<float, 32> data{};
+};
+
+template <typename Mapped> struct LightList {
+  std::vector<float> distances;
+  std::vector<Mapped> lights;
+};
+
+template <typename Mapped> auto random_lights(std::size_t count)
+{
+  beyond::xorshift32 rng{2};
+  std::uniform_real_distribution<float> distance{0.f, 1000.f};
+  LightList<Mapped> list{std::vector<float>(count),
+                         std::vector<Mapped>(count)};
+  std::ranges::generate(list.distances, [&]() { return distance(rng); });
+  return list;
+}
+
+template <typename Mapped>
+auto proxy_begin(LightList<Mapped>& list)
+    -> beyond::detail::SortByKeyIterator<float*, Mapped*>
+{
+  return {0, list.distances.data(), list.lights.data()};
+}
+
+template <typename Mapped>
+auto proxy_end(LightList<Mapped>& list)
+    -> beyond::detail::SortByKeyIterator<float*, Mapped*>
+{
+  return {list.distances.size(), list.distances.data(), list.lights.data()};
+}
+
+template <typename Mapped>
+auto benchmark_variants(const std::string& mapped_name) -> void
+{
+  constexpr std::size_t top_count = 16;
+  // Every case copies the unsorted list first
+  const LightList<Mapped> unsorted = random_lights<Mapped>(100'000);
+  const auto middle = [](LightList<Mapped>& list) {
+    return list.distances.begin() + top_count;
+  };
+
+  // The proxy iterators do not support std::stable_sort, which compares
+  // buffered values with each other
+  BENCHMARK("Proxy std::sort, " + mapped_name)
+  {
+    LightList<Mapped> list = unsorted;
+    std::sort(proxy_begin(list), proxy_end(list));
+    return list.distances.front();
+  };
+
+  BENCHMARK("stable_sort_by_key, " + mapped_name)
+  {
+    LightList<Mapped> list = unsorted;
+    beyond::stable_sort_by_key(list.distances.begin(), list.distances.end(),
+                               list.lights.begin());
+    return list.distances.front();
+  };
+
+  BENCHMARK("Proxy std::partial_sort, " + mapped_name)
+  {
+    LightList<Mapped> list = unsorted;
+    std::partial_sort(proxy_begin(list), proxy_begin(list) + top_count,
+                      proxy_end(list));
+    return list.distances.front();
+  };
+
+  BENCHMARK("partial_sort_by_key, " + mapped_name)
+  {
+    LightList<Mapped> list = unsorted;
+    beyond::partial_sort_by_key(list.distances.begin(), middle(list),
+                                list.distances.end(), list.lights.begin());
+    return list.distances.front();
+  };
+
+  BENCHMARK("Proxy std::nth_element, " + mapped_name)
+  {
+    LightList<Mapped> list = unsorted;
+    std::nth_element(proxy_begin(list), proxy_begin(list) + top_count,
+                     proxy_end(list));
+    return list.distances.front();
+  };
+
+  BENCHMARK("nth_element_by_key, " + mapped_name)
+  {
+    LightList<Mapped> list = unsorted;
+    beyond::nth_element_by_key(list.distances.begin(), middle(list),
+                               list.distances.end(), list.lights.begin());
+    return list.distances.front();
+  };
+}
+
+} // namespace
+
+TEST_CASE("Sort by key variants benchmark", "[!benchmark][sort_by_key]")
+{
+  benchmark_variants<std::uint32_t>("4 B");
+  benchmark_variants<LargeMapped>("128 B");
+}
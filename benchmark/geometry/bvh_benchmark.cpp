@@ -0,0 +1,150 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <beyond/concurrency/thread_pool.hpp>
+#include <beyond/geometry/bvh.hpp>
+#include <beyond/geometry/wide_bvh.hpp>
+#include <beyond/random/generators/xorshift32.hpp>
+
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+auto random_boxes(std::size_t count) -> std::vector<beyond::AABB3>
+{
+  beyond::xorshift32 rng{1};
+  std::uniform_real_distribution<float> position{-100.f, 100.f};
+  std::uniform_real_distribution<float> size{0.1f, 2.f};
+
+  std::vector<beyond::AABB3> boxes;
+  for (std::size_t i = 0; i < count; ++i) {
+    const beyond::Point3 min{position(rng), position(rng), position(rng)};
+    boxes.emplace_back(min,
+                       min + beyond::Vec3{size(rng), size(rng), size(rng)});
+  }
+  return boxes;
+}
+
+} // namespace
+
+TEST_CASE("BVH benchmark", "[!benchmark][bvh]")
+{
+  constexpr std::size_t box_count = 10'000;
+  constexpr std::size_t ray_count = 1'000;
+  constexpr float inf = std::numeric_limits<float>::infinity();
+
+  const std::vector<beyond::AABB3> boxes = random_boxes(box_count);
+
+  beyond::xorshift32 rng{2};
+  std::uniform_real_distribution<float> position{-100.f, 100.f};
+  std::uniform_real_distribution<float> direction{-1.f, 1.f};
+  std::vector<beyond::Ray> rays;
+  for (std::size_t i = 0; i < ray_count; ++i) {
+    rays.emplace_back(
+        beyond::Point3{position(rng), position(rng), position(rng)},
+        beyond::Vec3{direction(rng), direction(rng), direction(rng)});
+  }
+
+  BENCHMARK("Build")
+  {
+    return beyond::BVH{boxes};
+  };
+
+  BENCHMARK("Build LBVH")
+  {
+    return beyond::BVH{boxes, beyond::BVH::linear_tag};
+  };
+
+  const beyond::BVH bvh{boxes};
+
+  BENCHMARK("Brute force rays")
+  {
+    std::size_t hits = 0;
+    for (const beyond::Ray& ray : rays) {
+      const beyond::Vec3 inv_direction{1 / ray.direction.x,
+                                       1 / ray.direction.y,
+                                       1 / ray.direction.z};
+      float nearest = inf;
+      for (const beyond::AABB3& box : boxes) {
+        nearest = std::min(nearest,
+                           beyond::detail::ray_box_entry(
+                               box, ray.origin, inv_direction, 0, nearest));
+      }
+      hits += nearest != inf;
+    }
+    return hits;
+  };
+
+  BENCHMARK("BVH rays")
+  {
+    std::size_t hits = 0;
+    for (const beyond::Ray& ray : rays) {
+      hits += bvh.intersect(ray, boxes, 0, inf).has_value();
+    }
+    return hits;
+  };
+
+  const beyond::BVH lbvh{boxes, beyond::BVH::linear_tag};
+  BENCHMARK("LBVH rays")
+  {
+    std::size_t hits = 0;
+    for (const beyond::Ray& ray : rays) {
+      hits += lbvh.intersect(ray, boxes, 0, inf).has_value();
+    }
+    return hits;
+  };
+
+  const beyond::BVH4 bvh4{bvh};
+  BENCHMARK("BVH4 rays")
+  {
+    std::size_t hits = 0;
+    for (const beyond::Ray& ray : rays) {
+      hits += bvh4.intersect(ray, boxes, 0, inf).has_value();
+    }
+    return hits;
+  };
+
+  const beyond::BVH8 bvh8{bvh};
+  BENCHMARK("BVH8 rays")
+  {
+    std::size_t hits = 0;
+    for (const beyond::Ray& ray : rays) {
+      hits += bvh8.intersect(ray, boxes, 0, inf).has_value();
+    }
+    return hits;
+  };
+}
+
+TEST_CASE("Parallel BVH build benchmark", "[!benchmark][bvh][parallel_bvh]")
+{
+  const std::vector<beyond::AABB3> boxes = random_boxes(1'000'000);
+
+  BENCHMARK("Sequential")
+  {
+    return beyond::BVH{boxes};
+  };
+
+  for (const std::size_t thread_count : {1u, 2u, 4u, 8u, 16u, 32u}) {
+    beyond::ThreadPool pool{thread_count};
+    BENCHMARK(std::to_string(thread_count) + " threads")
+    {
+      return beyond::BVH{boxes, pool};
+    };
+  }
+
+  BENCHMARK("Sequential LBVH")
+  {
+    return beyond::BVH{boxes, beyond::BVH::linear_tag};
+  };
+
+  for (const std::size_t thread_count : {1u, 2u, 4u, 8u, 16u, 32u}) {
+    beyond::ThreadPool pool{thread_count};
+    BENCHMARK("LBVH " + std::to_string(thread_count) + " threads")
+    {
+      return beyond::BVH{boxes, beyond::BVH::linear_tag, pool};
+    };
+  }
+}
@@ -0,0 +1,61 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <beyond/geometry/dynamic_aabb_tree.hpp>
+#include <beyond/random/generators/xorshift32.hpp>
+
+#include <random>
+#include <vector>
+
+TEST_CASE("Dynamic AABB tree broadphase benchmark",
+          "[!benchmark][dynamic_aabb_tree]")
+{
+  constexpr std::size_t count = 5'000;
+
+  beyond::xorshift32 rng{1};
+  std::uniform_real_distribution<float> position{-100.f, 100.f};
+  std::uniform_real_distribution<float> size{0.5f, 2.f};
+  std::uniform_real_distribution<float> step{-0.05f, 0.05f};
+
+  std::vector<beyond::AABB3> boxes;
+  std::vector<beyond::Vec3> velocities;
+  for (std::size_t i = 0; i < count; ++i) {
+    const beyond::Point3 min{position(rng), position(rng), position(rng)};
+    boxes.emplace_back(min,
+                       min + beyond::Vec3{size(rng), size(rng), size(rng)});
+    velocities.emplace_back(step(rng), step(rng), step(rng));
+  }
+
+  beyond::DynamicAABBTree tree;
+  std::vector<beyond::AABBProxy> proxies;
+  for (std::size_t i = 0; i < count; ++i) {
+    proxies.push_back(tree.insert(boxes[i], i));
+  }
+
+  // Moves every object, then finds the overlapping pairs, like one frame of a
+  // physics simulation
+  BENCHMARK("Dynamic AABB tree frame")
+  {
+    for (std::size_t i = 0; i < count; ++i) {
+      boxes[i] = beyond::AABB3{boxes[i].min() + velocities[i],
+                               boxes[i].max() + velocities[i],
+                               beyond::AABB3::unchecked_tag};
+      [[maybe_unused]] const bool moved =
+          tree.move(proxies[i], boxes[i], velocities[i]);
+    }
+    std::size_t pairs = 0;
+    tree.query_pairs([&](beyond::AABBProxy, beyond::AABBProxy) { ++pairs; });
+    return pairs;
+  };
+
+  BENCHMARK("Brute force pairs")
+  {
+    std::size_t pairs = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      for (std::size_t j = i + 1; j < count; ++j) {
+        pairs += overlaps(boxes[i], boxes[j]);
+      }
+    }
+    return pairs;
+  };
+}
@@ -0,0 +1,74 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <beyond/geometry/frustum.hpp>
+#include <beyond/math/transform.hpp>
+#include <beyond/random/generators/xorshift32.hpp>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+TEST_CASE("Frustum culling benchmark", "[!benchmark][frustum]")
+{
+  using namespace beyond::literals;
+  constexpr std::size_t object_count = 200'000;
+
+  beyond::xorshift32 rng{1};
+  std::uniform_real_distribution<float> position{-500.f, 500.f};
+  std::uniform_real_distribution<float> size{0.5f, 4.f};
+  std::vector<beyond::AABB3> boxes;
+  std::vector<beyond::Sphere> spheres;
+  for (std::size_t i = 0; i < object_count; ++i) {
+    const beyond::Point3 center{position(rng), position(rng), position(rng)};
+    const float s = size(rng);
+    const beyond::Vec3 h{s, s, s};
+    boxes.emplace_back(center - h, center + h);
+    spheres.push_back(beyond::Sphere{center, s});
+  }
+
+  const beyond::Frustum frustum{
+      beyond::perspective(beyond::Radian{60._deg}, 16.f / 9.f, 0.1f, 300.f) *
+      beyond::look_at(beyond::Vec3{0, 0, 0}, beyond::Vec3{1, 0.2f, -1},
+                      beyond::Vec3{0, 1, 0})};
+  auto visible = std::make_unique<bool[]>(object_count);
+  const std::span<bool> visible_span{visible.get(), object_count};
+
+  BENCHMARK("Scalar boxes")
+  {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < object_count; ++i) {
+      visible[i] = frustum.intersects(boxes[i]);
+      count += visible[i];
+    }
+    return count;
+  };
+
+  BENCHMARK("Batch boxes")
+  {
+    return frustum.intersects(boxes, visible_span);
+  };
+
+  BENCHMARK("Scalar spheres")
+  {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < object_count; ++i) {
+      visible[i] = frustum.intersects(spheres[i]);
+      count += visible[i];
+    }
+    return count;
+  };
+
+  BENCHMARK("Batch spheres")
+  {
+    return frustum.intersects(spheres, visible_span);
+  };
+
+  const beyond::BVH bvh{boxes};
+  BENCHMARK("BVH cull")
+  {
+    std::size_t count = 0;
+    frustum.cull(bvh, boxes, [&](std::uint32_t) { ++count; });
+    return count;
+  };
+}
@@ -0,0 +1,130 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <beyond/geometry/bvh.hpp>
+#include <beyond/geometry/ray_packet.hpp>
+#include <beyond/random/generators/xorshift32.hpp>
+
+#include <bit>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace {
+
+constexpr float t_max = 100.f;
+
+template <std::size_t N>
+auto count_packet_hits(std::span<const beyond::Ray> rays,
+                       std::span<const beyond::AABB3> boxes) -> std::size_t
+{
+  std::size_t hits = 0;
+  for (std::size_t first = 0; first < rays.size(); first += N) {
+    const beyond::RayPacket<N> packet{rays.subspan(first, N)};
+    for (const beyond::AABB3& box : boxes) {
+      hits += static_cast<std::size_t>(
+          std::popcount(intersect(packet, box, 0.f, t_max).mask.bits()));
+    }
+  }
+  return hits;
+}
+
+template <std::size_t N>
+auto count_wide_box_hits(std::span<const beyond::Ray> rays,
+                         std::span<const beyond::WideAABB3<N>> boxes)
+    -> std::size_t
+{
+  std::size_t hits = 0;
+  for (const beyond::Ray& ray : rays) {
+    const beyond::PrecomputedRay r{ray};
+    for (const beyond::WideAABB3<N>& wide : boxes) {
+      hits += static_cast<std::size_t>(
+          std::popcount(intersect(r, wide, 0.f, t_max).mask.bits()));
+    }
+  }
+  return hits;
+}
+
+template <std::size_t N>
+auto to_wide(std::span<const beyond::AABB3> boxes)
+    -> std::vector<beyond::WideAABB3<N>>
+{
+  std::vector<beyond::WideAABB3<N>> result;
+  for (std::size_t first = 0; first < boxes.size(); first += N) {
+    result.emplace_back(boxes.subspan(first, N));
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("Ray packet benchmark", "[!benchmark][ray_packet]")
+{
+  // Multiples of 8 so that every packet is full
+  constexpr std::size_t ray_count = 1024;
+  constexpr std::size_t box_count = 1024;
+
+  beyond::xorshift32 rng{3};
+  std::uniform_real_distribution<float> position{-50.f, 50.f};
+  std::uniform_real_distribution<float> direction{-1.f, 1.f};
+  std::uniform_real_distribution<float> size{0.5f, 5.f};
+
+  std::vector<beyond::Ray> rays;
+  for (std::size_t i = 0; i < ray_count; ++i) {
+    rays.emplace_back(
+        beyond::Point3{position(rng), position(rng), position(rng)},
+        beyond::Vec3{direction(rng), direction(rng), direction(rng)});
+  }
+  std::vector<beyond::AABB3> boxes;
+  for (std::size_t i = 0; i < box_count; ++i) {
+    const beyond::Point3 min{position(rng), position(rng), position(rng)};
+    boxes.emplace_back(min,
+                       min + beyond::Vec3{size(rng), size(rng), size(rng)});
+  }
+  const auto boxes4 = to_wide<4>(boxes);
+  const auto boxes8 = to_wide<8>(boxes);
+
+  BENCHMARK("AABB3::is_intersect_with")
+  {
+    std::size_t hits = 0;
+    for (const beyond::Ray& ray : rays) {
+      for (const beyond::AABB3& box : boxes) {
+        hits += box.is_intersect_with(ray, 0, t_max);
+      }
+    }
+    return hits;
+  };
+
+  BENCHMARK("Scalar with precomputed reciprocal")
+  {
+    std::size_t hits = 0;
+    for (const beyond::Ray& ray : rays) {
+      const beyond::PrecomputedRay r{ray};
+      for (const beyond::AABB3& box : boxes) {
+        hits += beyond::detail::ray_box_entry(box, r.origin, r.inv_direction,
+                                              0, t_max) <= t_max;
+      }
+    }
+    return hits;
+  };
+
+  BENCHMARK("4 rays vs 1 box")
+  {
+    return count_packet_hits<4>(rays, boxes);
+  };
+
+  BENCHMARK("8 rays vs 1 box")
+  {
+    return count_packet_hits<8>(rays, boxes);
+  };
+
+  BENCHMARK("1 ray vs 4 boxes")
+  {
+    return count_wide_box_hits<4>(rays, boxes4);
+  };
+
+  BENCHMARK("1 ray vs 8 boxes")
+  {
+    return count_wide_box_hits<8>(rays, boxes8);
+  };
+}
@@ -0,0 +1,62 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <beyond/concurrency/thread_pool.hpp>
+#include <beyond/geometry/spatial_hash_grid.hpp>
+#include <beyond/random/generators/xorshift32.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+TEST_CASE("Spatial hash grid benchmark", "[!benchmark][spatial_hash_grid]")
+{
+  // About one particle per unit cube, with neighbors within one unit. Cells
+  // twice as large as the radius make each query visit 2 x 2 x 2 cells
+  constexpr std::size_t point_count = 300'000;
+  constexpr float extent = 67.f;
+  constexpr float radius = 1.f;
+
+  beyond::xorshift32 rng{1};
+  std::uniform_real_distribution<float> position{-extent / 2, extent / 2};
+  std::vector<beyond::Point3> points;
+  for (std::size_t i = 0; i < point_count; ++i) {
+    points.emplace_back(position(rng), position(rng), position(rng));
+  }
+
+  beyond::SpatialHashGrid grid{2 * radius};
+  BENCHMARK("Rebuild")
+  {
+    grid.rebuild(points);
+    return grid.size();
+  };
+
+  for (const std::size_t thread_count : {1u, 4u}) {
+    beyond::ThreadPool pool{thread_count};
+    BENCHMARK("Rebuild with " + std::to_string(thread_count) + " threads")
+    {
+      grid.rebuild(points, pool);
+      return grid.size();
+    };
+  }
+
+  grid.rebuild(points);
+  BENCHMARK("Query the neighbors of every point")
+  {
+    std::size_t neighbor_count = 0;
+    for (const beyond::Point3& p : points) {
+      grid.query_radius(p, radius, [&](std::uint32_t) { ++neighbor_count; });
+    }
+    return neighbor_count;
+  };
+
+  // Neighboring points are close in memory in the order of the grid
+  BENCHMARK("Query the neighbors of every point in grid order")
+  {
+    std::size_t neighbor_count = 0;
+    for (const beyond::Point3& p : grid.sorted_points()) {
+      grid.query_radius(p, radius, [&](std::uint32_t) { ++neighbor_count; });
+    }
+    return neighbor_count;
+  };
+}
@@ -0,0 +1,52 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <beyond/math/batch_transform.hpp>
+#include <beyond/math/transform.hpp>
+
+#include <vector>
+
+TEST_CASE("Batch transform benchmark", "[!benchmark][batch_transform]")
+{
+  constexpr std::size_t count = 10'000;
+
+  const beyond::Mat4 m = beyond::translate(1.f, -2.f, 3.f) *
+                         beyond::rotate_y(beyond::Radian{0.5f}) *
+                         beyond::scale(2.f, 3.f, 0.5f);
+
+  std::vector<beyond::Point3> points;
+  std::vector<float> xs, ys, zs;
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto f = static_cast<float>(i);
+    points.emplace_back(f, -f, 0.5f * f);
+    xs.push_back(f);
+    ys.push_back(-f);
+    zs.push_back(0.5f * f);
+  }
+  std::vector<beyond::Point3> out(count);
+  std::vector<float> out_xs(count), out_ys(count), out_zs(count);
+
+  BENCHMARK("Scalar loop")
+  {
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto& p = points[i];
+      const beyond::Vec4 r = m * beyond::Vec4{p.x, p.y, p.z, 1};
+      out[i] = beyond::Point3{r.x, r.y, r.z};
+    }
+    return out.data();
+  };
+
+  BENCHMARK("transform_points AoS")
+  {
+    beyond::transform_points(m, points, out);
+    return out.data();
+  };
+
+  BENCHMARK("transform_points SoA")
+  {
+    beyond::transform_points(
+        m, beyond::SoASpan3<const float>{xs, ys, zs},
+        beyond::SoASpan3<float>{out_xs, out_ys, out_zs});
+    return out_xs.data();
+  };
+}
@@ -0,0 +1,27 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <beyond/math/matrix.hpp>
+#include <beyond/math/transform.hpp>
+
+TEST_CASE("Mat4 inverse benchmark", "[!benchmark][matrix_inverse]")
+{
+  const beyond::Mat4 rigid = beyond::translate(1.f, -2.f, 3.f) *
+                             beyond::rotate_y(beyond::Radian{0.5f});
+  const beyond::Mat4 affine = rigid * beyond::scale(2.f, 3.f, 0.5f);
+
+  BENCHMARK("inverse")
+  {
+    return inverse(affine);
+  };
+
+  BENCHMARK("inverse_affine")
+  {
+    return inverse_affine(affine);
+  };
+
+  BENCHMARK("inverse_rigid")
+  {
+    return inverse_rigid(rigid);
+  };
+}
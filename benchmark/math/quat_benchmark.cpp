@@ -0,0 +1,49 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <beyond/math/quat.hpp>
+
+#include <vector>
+
+TEST_CASE("Quaternion slerp benchmark", "[!benchmark][quat]")
+{
+  constexpr std::size_t count = 1'000;
+
+  std::vector<beyond::Quat> from, to;
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto f = static_cast<float>(i);
+    const auto axis = normalize(beyond::Vec3{1.f, f, 2.f});
+    from.push_back(
+        beyond::Quat::from_axis_angle(beyond::Radian{0.001f * f}, axis));
+    to.push_back(beyond::Quat::from_axis_angle(beyond::Radian{2.f}, axis));
+  }
+  std::vector<beyond::Quat> out(count);
+
+  BENCHMARK("Scalar slerp loop")
+  {
+    for (std::size_t i = 0; i < count; ++i) {
+      out[i] = slerp(from[i], to[i], 0.3f);
+    }
+    return out.data();
+  };
+
+  BENCHMARK("Batch slerp")
+  {
+    beyond::slerp(from, to, 0.3f, out);
+    return out.data();
+  };
+
+  BENCHMARK("Scalar nlerp loop")
+  {
+    for (std::size_t i = 0; i < count; ++i) {
+      out[i] = nlerp(from[i], to[i], 0.3f);
+    }
+    return out.data();
+  };
+
+  BENCHMARK("Batch nlerp")
+  {
+    beyond::nlerp(from, to, 0.3f, out);
+    return out.data();
+  };
+}
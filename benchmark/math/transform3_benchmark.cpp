@@ -0,0 +1,52 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <beyond/math/transform3.hpp>
+
+#include <vector>
+
+TEST_CASE("Transform hierarchy benchmark", "[!benchmark][transform3]")
+{
+  constexpr std::size_t count = 100'000;
+
+  // Every node is the child of the node half its index, a balanced tree
+  std::vector<std::uint32_t> parents;
+  std::vector<beyond::Transform3> local;
+  std::vector<beyond::Mat4> local_matrices;
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto f = static_cast<float>(i);
+    parents.push_back(i == 0 ? beyond::no_parent
+                             : static_cast<std::uint32_t>(i / 2));
+    local.push_back(
+        {beyond::Vec3{f, 1, 2},
+         beyond::Quat::from_axis_angle(beyond::Radian{0.001f * f},
+                                       beyond::Vec3{0, 1, 0}),
+         beyond::Vec3{1, 1, 1}});
+    local_matrices.push_back(to_mat4(local.back()));
+  }
+  std::vector<beyond::Transform3> world(count);
+  std::vector<beyond::Mat4> world_matrices(count);
+
+  BENCHMARK("Mat4 products")
+  {
+    for (std::size_t i = 0; i < count; ++i) {
+      world_matrices[i] =
+          parents[i] == beyond::no_parent
+              ? local_matrices[i]
+              : world_matrices[parents[i]] * local_matrices[i];
+    }
+    return world_matrices.data();
+  };
+
+  BENCHMARK("Transform3")
+  {
+    beyond::propagate_transforms(local, parents, world);
+    return world.data();
+  };
+
+  BENCHMARK("Transform3 to matrices")
+  {
+    beyond::propagate_transforms(local, parents, world, world_matrices);
+    return world_matrices.data();
+  };
+}
@@ -0,0 +1,316 @@
+#ifndef BEYOND_CORE_ALGORITHM_RADIX_SORT_HPP
+#define BEYOND_CORE_ALGORITHM_RADIX_SORT_HPP
+
+/**
+ * @file radix_sort.hpp
+ * @brief Provides least significant digit radix sorts of integer and floating
+ * point keys
+ * @ingroup algorithm
+ */
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "../concurrency/thread_pool.hpp"
+#include "../utils/assert.hpp"
+
+/**
+ * @defgroup algorithm Algorithms
+ * @brief Generic algorithms over ranges
+ * @ingroup core
+ */
+
+namespace beyond {
+
+/**
+ * @addtogroup core
+ * @{
+ * @addtogroup algorithm
+ * @{
+ */
+
+/// @brief Keys that the radix sorts can order by their bits
+template <typename T>
+concept RadixSortKey =
+    (std::integral<T> && !std::same_as<T, bool>) ||
+    (std::floating_point<T> && std::numeric_limits<T>::is_iec559 &&
+     (sizeof(T) == 4 || sizeof(T) == 8));
+
+/** @}
+ *  @} */
+
+namespace detail {
+
+inline constexpr std::size_t radix_digit_bits = 8;
+inline constexpr std::size_t radix_digit_count = std::size_t{1}
+                                                 << radix_digit_bits;
+
+// The parallel sort gives each task at least this many keys
+inline constexpr std::size_t radix_parallel_grain_size = 16384;
+
+using RadixHistogram = std::array<std::size_t, radix_digit_count>;
+
+template <std::size_t size> struct RadixUnsigned;
+template <> struct RadixUnsigned<1> {
+  using type = std::uint8_t;
+};
+template <> struct RadixUnsigned<2> {
+  using type = std::uint16_t;
+};
+template <> struct RadixUnsigned<4> {
+  using type = std::uint32_t;
+};
+template <> struct RadixUnsigned<8> {
+  using type = std::uint64_t;
+};
+
+// Maps a key to unsigned bits that compare in the same order as the key
+template <RadixSortKey Key>
+[[nodiscard]] constexpr auto radix_bits(Key key) noexcept
+{
+  using Bits = typename RadixUnsigned<sizeof(Key)>::type;
+  constexpr Bits sign_bit = Bits{1} << (8 * sizeof(Key) - 1);
+  if constexpr (std::unsigned_integral<Key>) {
+    return key;
+  } else if constexpr (std::integral<Key>) {
+    // Negative keys come first once their sign bit is cleared
+    return static_cast<Bits>(static_cast<Bits>(key) ^ sign_bit);
+  } else {
+    // Negative floats are ordered by decreasing magnitude, so all of their
+    // bits are flipped
+    const auto bits = std::bit_cast<Bits>(key);
+    const Bits mask = (bits & sign_bit) != 0 ? static_cast<Bits>(~Bits{0})
+                                             : sign_bit;
+    return static_cast<Bits>(bits ^ mask);
+  }
+}
+
+template <RadixSortKey Key>
+[[nodiscard]] constexpr auto radix_digit(Key key, std::size_t pass) noexcept
+    -> std::size_t
+{
+  return static_cast<std::size_t>(radix_bits(key) >>
+                                  (pass * radix_digit_bits)) &
+         (radix_digit_count - 1);
+}
+
+// Moves the elements of [begin, end) to `destination_*` at the offsets of
+// their digits, and advances the offsets
+template <typename Key, typename Mapped>
+auto radix_scatter(const Key* source_keys, Mapped* source_mapped,
+                   Key* destination_keys, Mapped* destination_mapped,
+                   std::size_t begin, std::size_t end, std::size_t pass,
+                   RadixHistogram& offsets) -> void
+{
+  for (std::size_t i = begin; i < end; ++i) {
+    const std::size_t destination =
+        offsets[radix_digit(source_keys[i], pass)]++;
+    destination_keys[destination] = source_keys[i];
+    destination_mapped[destination] = std::move(source_mapped[i]);
+  }
+}
+
+// Sorts on `pool` if it is not null. The scratch buffers are at least as
+// large as `keys`
+template <RadixSortKey Key, std::movable Mapped>
+auto radix_sort_by_key_on(std::span<Key> keys, std::span<Mapped> mapped,
+                          std::span<Key> key_scratch,
+                          std::span<Mapped> mapped_scratch, ThreadPool* pool)
+    -> void
+{
+  const std::size_t size = keys.size();
+  BEYOND_ASSERT(mapped.size() >= size);
+  BEYOND_ASSERT(key_scratch.size() >= size && mapped_scratch.size() >= size);
+  if (size < 2) { return; }
+
+  std::size_t chunk_count = 1;
+  if (pool != nullptr) {
+    chunk_count = std::min(size / radix_parallel_grain_size, pool->size());
+  }
+
+  Key* source_keys = keys.data();
+  Mapped* source_mapped = mapped.data();
+  Key* destination_keys = key_scratch.data();
+  Mapped* destination_mapped = mapped_scratch.data();
+  const auto swap_buffers = [&]() {
+    std::swap(source_keys, destination_keys);
+    std::swap(source_mapped, destination_mapped);
+  };
+
+  constexpr std::size_t pass_count = sizeof(Key);
+  if (chunk_count < 2) {
+    // Counts the digits of all passes at once
+    std::array<RadixHistogram, pass_count> histograms{};
+    for (const Key key : keys) {
+      for (std::size_t pass = 0; pass < pass_count; ++pass) {
+        ++histograms[pass][radix_digit(key, pass)];
+      }
+    }
+
+    for (std::size_t pass = 0; pass < pass_count; ++pass) {
+      RadixHistogram& offsets = histograms[pass];
+      // Skips the passes over bytes that are the same for every key
+      if (offsets[radix_digit(source_keys[0], pass)] == size) { continue; }
+
+      std::size_t offset = 0;
+      for (std::size_t& count : offsets) {
+        offset += std::exchange(count, offset);
+      }
+      radix_scatter(source_keys, source_mapped, destination_keys,
+                    destination_mapped, 0, size, pass, offsets);
+      swap_buffers();
+    }
+  } else {
+    BEYOND_ASSERT(pool != nullptr);
+    std::vector<RadixHistogram> histograms(chunk_count);
+    for (std::size_t pass = 0; pass < pass_count; ++pass) {
+      parallel_for_chunks(
+          pool, chunk_count, 0, size,
+          [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            RadixHistogram& counts = histograms[chunk];
+            counts.fill(0);
+            for (std::size_t i = begin; i < end; ++i) {
+              ++counts[radix_digit(source_keys[i], pass)];
+            }
+          });
+
+      // The elements with the same digit are ordered by chunk, which keeps
+      // the sort stable
+      const std::size_t first_digit = radix_digit(source_keys[0], pass);
+      std::size_t first_digit_count = 0;
+      std::size_t offset = 0;
+      for (std::size_t digit = 0; digit < radix_digit_count; ++digit) {
+        for (RadixHistogram& counts : histograms) {
+          if (digit == first_digit) { first_digit_count += counts[digit]; }
+          offset += std::exchange(counts[digit], offset);
+        }
+      }
+      if (first_digit_count == size) { continue; }
+
+      parallel_for_chunks(
+          pool, chunk_count, 0, size,
+          [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            radix_scatter(source_keys, source_mapped, destination_keys,
+                          destination_mapped, begin, end, pass,
+                          histograms[chunk]);
+          });
+      swap_buffers();
+    }
+  }
+
+  // Moves the elements back if the last pass left them in the scratch buffers
+  if (source_keys != keys.data()) {
+    std::copy(source_keys, source_keys + size, keys.data());
+    std::move(source_mapped, source_mapped + size, mapped.data());
+  }
+}
+
+} // namespace detail
+
+/**
+ * @addtogroup core
+ * @{
+ * @addtogroup algorithm
+ * @{
+ */
+
+/**
+ * @brief Sorts `keys` in ascending order and applies the same permutation to
+ * `mapped`
+ *
+ * The sort is stable and takes one pass over the elements per byte of the
+ * keys, plus one pass to count the digits of all bytes. Passes over bytes that
+ * are the same for every key are skipped.
+ *
+ * Floating point keys are ordered by their bits, so `-0` comes before `+0`,
+ * and NaNs come either first or last depending on their sign bit.
+ *
+ * @pre `mapped.size() >= keys.size()`
+ */
+template <RadixSortKey Key, std::default_initializable Mapped>
+  requires std::movable<Mapped>
+auto radix_sort_by_key(std::span<Key> keys, std::span<Mapped> mapped) -> void
+{
+  std::vector<Key> key_scratch(keys.size());
+  std::vector<Mapped> mapped_scratch(keys.size());
+  detail::radix_sort_by_key_on(keys, mapped, std::span{key_scratch},
+                               std::span{mapped_scratch}, nullptr);
+}
+
+/**
+ * @brief Sorts `keys` in ascending order and applies the same permutation to
+ * `mapped`, using caller provided scratch buffers
+ *
+ * Keeping the scratch buffers between calls avoids allocating them for every
+ * sort, such as when sorting draw calls every frame. Their content is
+ * unspecified afterwards.
+ *
+ * @pre `mapped`, `key_scratch`, and `mapped_scratch` are at least as large as
+ * `keys`
+ */
+template <RadixSortKey Key, std::movable Mapped>
+auto radix_sort_by_key(std::span<Key> keys, std::span<Mapped> mapped,
+                       std::span<Key> key_scratch,
+                       std::span<Mapped> mapped_scratch) -> void
+{
+  detail::radix_sort_by_key_on(keys, mapped, key_scratch, mapped_scratch,
+                               nullptr);
+}
+
+/**
+ * @brief Sorts `keys` in ascending order and applies the same permutation to
+ * `mapped` with the worker threads of `pool`
+ *
+ * Each pass splits the keys into one chunk per thread. Every chunk counts its
+ * digits into a private histogram, and then scatters its elements to the
+ * offsets given by the histograms of all chunks. The result is the same as the
+ * one of the sequential sort.
+ *
+ * @warning Blocks until the sort finishes, so it must not be called from a
+ * worker thread of `pool`
+ * @pre `mapped.size() >= keys.size()`
+ */
+template <RadixSortKey Key, std::default_initializable Mapped>
+  requires std::movable<Mapped>
+auto radix_sort_by_key(std::span<Key> keys, std::span<Mapped> mapped,
+                       ThreadPool& pool) -> void
+{
+  std::vector<Key> key_scratch(keys.size());
+  std::vector<Mapped> mapped_scratch(keys.size());
+  detail::radix_sort_by_key_on(keys, mapped, std::span{key_scratch},
+                               std::span{mapped_scratch}, &pool);
+}
+
+/**
+ * @brief Sorts `keys` in ascending order and applies the same permutation to
+ * `mapped` with the worker threads of `pool`, using caller provided scratch
+ * buffers
+ *
+ * @warning Blocks until the sort finishes, so it must not be called from a
+ * worker thread of `pool`
+ * @pre `mapped`, `key_scratch`, and `mapped_scratch` are at least as large as
+ * `keys`
+ */
+template <RadixSortKey Key, std::movable Mapped>
+auto radix_sort_by_key(std::span<Key> keys, std::span<Mapped> mapped,
+                       std::span<Key> key_scratch,
+                       std::span<Mapped> mapped_scratch, ThreadPool& pool)
+    -> void
+{
+  detail::radix_sort_by_key_on(keys, mapped, key_scratch, mapped_scratch,
+                               &pool);
+}
+
+/** @}
+ *  @} */
+
+} // namespace beyond
+
+#endif // BEYOND_CORE_ALGORITHM_RADIX_SORT_HPP
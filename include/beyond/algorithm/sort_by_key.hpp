@@ -2,7 +2,16 @@
 #define BEYOND_CORE_ALGORITHM_SORT_BY_KEY_HPP
 
 #include <algorithm>
+#include <concepts>
 #include <cstdint>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "radix_sort.hpp"
 
 namespace beyond {
 
@@ -168,6 +177,108 @@ template <typename KeyItr, typename MappedItr> struct SortByKeyIterator {
   }
 };
 
+// Below this size, std::sort is faster than the radix sort
+inline constexpr std::size_t radix_sort_by_key_threshold = 1024;
+
+// Key-value ranges that can be sorted with radix_sort_by_key
+template <typename KeyItr, typename MappedItr>
+concept RadixSortableByKey =
+    std::contiguous_iterator<KeyItr> && std::contiguous_iterator<MappedItr> &&
+    RadixSortKey<std::iter_value_t<KeyItr>> &&
+    std::default_initializable<std::iter_value_t<MappedItr>> &&
+    std::movable<std::iter_value_t<MappedItr>> &&
+    std::same_as<std::iter_reference_t<KeyItr>, std::iter_value_t<KeyItr>&> &&
+    std::same_as<std::iter_reference_t<MappedItr>,
+                 std::iter_value_t<MappedItr>&>;
+
+// Key-value ranges whose elements SortByKeyIterator can move cheaply. Its
+// references leave value-initialized keys and mapped values behind when moved
+// from, and copy them around one at a time
+template <typename KeyItr, typename MappedItr>
+concept ProxySortableByKey =
+    std::default_initializable<std::iter_value_t<KeyItr>> &&
+    std::default_initializable<std::iter_value_t<MappedItr>> &&
+    std::is_trivially_copyable_v<std::iter_value_t<KeyItr>> &&
+    std::is_trivially_copyable_v<std::iter_value_t<MappedItr>>;
+
+template <typename Itr>
+[[nodiscard]] constexpr auto contiguous_span(Itr begin, std::size_t size)
+{
+  return std::span{std::to_address(begin), size};
+}
+
+template <typename Key> struct KeyIndex {
+  Key key;
+  std::size_t index;
+};
+
+// Mapped values up to this size are applied to their sorted positions with a
+// gather into a buffer, which reads them in random order but writes them
+// sequentially. Larger ones are moved along the cycles of the permutation,
+// which moves each of them once instead of twice
+inline constexpr std::size_t permutation_gather_max_size = 16;
+
+/*
+ * Sorts the keys together with their original indices with
+ * `sort(begin, end, less)`, and then moves the mapped values to their new
+ * positions. Unlike the proxy iterators, this never default constructs keys or
+ * mapped values.
+ */
+template <typename KeyItr, typename MappedItr, typename Sort>
+auto sort_by_key_permutation(KeyItr keys_begin, KeyItr keys_end,
+                             MappedItr mapped_begin, const Sort& sort) -> void
+{
+  using Key = std::iter_value_t<KeyItr>;
+  using Mapped = std::iter_value_t<MappedItr>;
+  const auto size = static_cast<std::size_t>(keys_end - keys_begin);
+  const auto key_at = [&](std::size_t i) -> decltype(auto) {
+    return keys_begin[static_cast<std::iter_difference_t<KeyItr>>(i)];
+  };
+  const auto mapped_at = [&](std::size_t i) -> decltype(auto) {
+    return mapped_begin[static_cast<std::iter_difference_t<MappedItr>>(i)];
+  };
+
+  std::vector<KeyIndex<Key>> order;
+  order.reserve(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    order.push_back({std::move(key_at(i)), i});
+  }
+  sort(order.begin(), order.end(),
+       [](const KeyIndex<Key>& lhs, const KeyIndex<Key>& rhs) {
+         return lhs.key < rhs.key;
+       });
+
+  for (std::size_t i = 0; i < size; ++i) {
+    key_at(i) = std::move(order[i].key);
+  }
+
+  if constexpr (sizeof(Mapped) <= permutation_gather_max_size) {
+    std::vector<Mapped> sorted_mapped;
+    sorted_mapped.reserve(size);
+    for (const KeyIndex<Key>& element : order) {
+      sorted_mapped.push_back(std::move(mapped_at(element.index)));
+    }
+    for (std::size_t i = 0; i < size; ++i) {
+      mapped_at(i) = std::move(sorted_mapped[i]);
+    }
+  } else {
+    // Position i receives the value at order[i].index. Visited positions are
+    // marked by pointing them to themselves
+    for (std::size_t start = 0; start < size; ++start) {
+      if (order[start].index == start) { continue; }
+      Mapped first = std::move(mapped_at(start));
+      std::size_t i = start;
+      while (order[i].index != start) {
+        const std::size_t next = std::exchange(order[i].index, i);
+        mapped_at(i) = std::move(mapped_at(next));
+        i = next;
+      }
+      order[i].index = i;
+      mapped_at(i) = std::move(first);
+    }
+  }
+}
+
 } // namespace detail
 
 /**
@@ -180,6 +291,10 @@ template <typename KeyItr, typename MappedItr> struct SortByKeyIterator {
  * @param keys_begin The beginning of the key sequence.
  * @param keys_end The end of the mapped sequence.
  * @param mapped_begin The beginning of the value sequence.
+ *
+ * Contiguous ranges of integer or floating point keys are sorted with
+ * `radix_sort_by_key` outside of constant evaluation, see its documentation
+ * for the order of floating point keys.
  * @pre The range [keys_begin, keys_end)) shall not overlap the range
  [mapped_begin, mapped_begin + (keys_end - keys_begin)).
  */
@@ -188,12 +303,187 @@ template <std::random_access_iterator KeyItr,
 constexpr void sort_by_key(KeyItr keys_begin, KeyItr keys_end,
                            MappedItr mapped_begin)
 {
+  if constexpr (detail::RadixSortableByKey<KeyItr, MappedItr>) {
+    if !consteval {
+      const auto size = static_cast<std::size_t>(keys_end - keys_begin);
+      if (size >= detail::radix_sort_by_key_threshold) {
+        radix_sort_by_key(detail::contiguous_span(keys_begin, size),
+                          detail::contiguous_span(mapped_begin, size));
+        return;
+      }
+    }
+  }
+
   std::sort(
       detail::SortByKeyIterator<KeyItr, MappedItr>{0, keys_begin, mapped_begin},
       detail::SortByKeyIterator<KeyItr, MappedItr>{
           static_cast<std::size_t>(keys_end - keys_begin), keys_begin,
           mapped_begin});
 }
+
+/**
+ * @brief Performs the same sort as `sort_by_key` with the worker threads of
+ * `pool`
+ *
+ * @warning Blocks until the sort finishes, so it must not be called from a
+ * worker thread of `pool`
+ * @see radix_sort_by_key
+ */
+template <std::random_access_iterator KeyItr,
+          std::random_access_iterator MappedItr>
+  requires detail::RadixSortableByKey<KeyItr, MappedItr>
+void sort_by_key(KeyItr keys_begin, KeyItr keys_end, MappedItr mapped_begin,
+                 ThreadPool& pool)
+{
+  const auto size = static_cast<std::size_t>(keys_end - keys_begin);
+  if (size < detail::radix_sort_by_key_threshold) {
+    sort_by_key(keys_begin, keys_end, mapped_begin);
+    return;
+  }
+  radix_sort_by_key(detail::contiguous_span(keys_begin, size),
+                    detail::contiguous_span(mapped_begin, size), pool);
+}
+
+/**
+ * @brief Performs the same sort as `sort_by_key`, but preserves the relative
+ * order of elements with equivalent keys
+ *
+ * Contiguous ranges of integer or floating point keys are sorted with
+ * `radix_sort_by_key`, which is stable. Other keys are sorted with
+ * `std::stable_sort` together with their indices, and the mapped values are
+ * then moved to their sorted positions.
+ */
+template <std::random_access_iterator KeyItr,
+          std::random_access_iterator MappedItr>
+void stable_sort_by_key(KeyItr keys_begin, KeyItr keys_end,
+                        MappedItr mapped_begin)
+{
+  const auto size = static_cast<std::size_t>(keys_end - keys_begin);
+  if constexpr (detail::RadixSortableByKey<KeyItr, MappedItr>) {
+    if (size >= detail::radix_sort_by_key_threshold) {
+      radix_sort_by_key(detail::contiguous_span(keys_begin, size),
+                        detail::contiguous_span(mapped_begin, size));
+      return;
+    }
+  }
+  detail::sort_by_key_permutation(
+      keys_begin, keys_end, mapped_begin,
+      [](auto begin, auto end, const auto& less) {
+        std::stable_sort(begin, end, less);
+      });
+}
+
+/**
+ * @brief Rearranges the elements such that [keys_begin, keys_middle) holds
+ * the smallest keys in ascending order, and applies the same permutation to
+ * the mapped values
+ *
+ * The order of the rest of the elements is unspecified. The smallest keys are
+ * selected with a heap of copies of the keys and their indices, and only then
+ * are the selected elements and the ones they replace moved. Selecting a few
+ * elements out of many, such as the nearest lights, moves few of them.
+ */
+template <std::random_access_iterator KeyItr,
+          std::random_access_iterator MappedItr>
+  requires std::copyable<std::iter_value_t<KeyItr>>
+void partial_sort_by_key(KeyItr keys_begin, KeyItr keys_middle,
+                         KeyItr keys_end, MappedItr mapped_begin)
+{
+  using Key = std::iter_value_t<KeyItr>;
+  using Mapped = std::iter_value_t<MappedItr>;
+  const auto middle = static_cast<std::size_t>(keys_middle - keys_begin);
+  const auto size = static_cast<std::size_t>(keys_end - keys_begin);
+  if (middle == 0) { return; }
+  const auto key_at = [&](std::size_t i) -> decltype(auto) {
+    return keys_begin[static_cast<std::iter_difference_t<KeyItr>>(i)];
+  };
+  const auto mapped_at = [&](std::size_t i) -> decltype(auto) {
+    return mapped_begin[static_cast<std::iter_difference_t<MappedItr>>(i)];
+  };
+  const auto less = [](const detail::KeyIndex<Key>& lhs,
+                       const detail::KeyIndex<Key>& rhs) {
+    return lhs.key < rhs.key;
+  };
+
+  // A max heap of the smallest keys so far
+  std::vector<detail::KeyIndex<Key>> selected;
+  selected.reserve(middle);
+  for (std::size_t i = 0; i < middle; ++i) {
+    selected.push_back({key_at(i), i});
+  }
+  std::ranges::make_heap(selected, less);
+  for (std::size_t i = middle; i < size; ++i) {
+    if (key_at(i) < selected.front().key) {
+      std::ranges::pop_heap(selected, less);
+      selected.back() = {key_at(i), i};
+      std::ranges::push_heap(selected, less);
+    }
+  }
+  std::ranges::sort_heap(selected, less);
+
+  // The elements selected from [middle, end) swap places with the elements
+  // of [0, middle) that were not selected
+  std::vector<char> stays(middle);
+  std::vector<std::size_t> vacated;
+  for (const detail::KeyIndex<Key>& element : selected) {
+    if (element.index < middle) {
+      stays[element.index] = 1;
+    } else {
+      vacated.push_back(element.index);
+    }
+  }
+
+  std::vector<Mapped> selected_mapped;
+  selected_mapped.reserve(middle);
+  for (const detail::KeyIndex<Key>& element : selected) {
+    selected_mapped.push_back(std::move(mapped_at(element.index)));
+  }
+  auto destination = vacated.begin();
+  for (std::size_t i = 0; i < middle; ++i) {
+    if (stays[i] != 0) { continue; }
+    key_at(*destination) = std::move(key_at(i));
+    mapped_at(*destination) = std::move(mapped_at(i));
+    ++destination;
+  }
+  for (std::size_t i = 0; i < middle; ++i) {
+    key_at(i) = std::move(selected[i].key);
+    mapped_at(i) = std::move(selected_mapped[i]);
+  }
+}
+
+/**
+ * @brief Rearranges the elements such that `keys_nth` holds the key that
+ * would be there if the range was sorted, and applies the same permutation to
+ * the mapped values
+ *
+ * The keys before `keys_nth` are not greater than it, and the ones after it
+ * are not less than it. Trivially copyable keys and mapped values that can be
+ * default initialized are rearranged in place with `std::nth_element`. Other
+ * keys are selected together with their indices, and the mapped values are
+ * then moved to their new positions.
+ */
+template <std::random_access_iterator KeyItr,
+          std::random_access_iterator MappedItr>
+void nth_element_by_key(KeyItr keys_begin, KeyItr keys_nth, KeyItr keys_end,
+                        MappedItr mapped_begin)
+{
+  const auto nth = keys_nth - keys_begin;
+  if constexpr (detail::ProxySortableByKey<KeyItr, MappedItr>) {
+    using Iterator = detail::SortByKeyIterator<KeyItr, MappedItr>;
+    const auto size = static_cast<std::size_t>(keys_end - keys_begin);
+    std::nth_element(Iterator{0, keys_begin, mapped_begin},
+                     Iterator{static_cast<std::size_t>(nth), keys_begin,
+                              mapped_begin},
+                     Iterator{size, keys_begin, mapped_begin});
+  } else {
+    detail::sort_by_key_permutation(
+        keys_begin, keys_end, mapped_begin,
+        [nth](auto begin, auto end, const auto& less) {
+          std::nth_element(begin, begin + nth, end, less);
+        });
+  }
+}
+
 } // namespace beyond
 
 #endif // BEYOND_CORE_ALGORITHM_SORT_BY_KEY_HPP
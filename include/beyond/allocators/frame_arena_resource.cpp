@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+#include "../utils/assert.hpp"
+#include "frame_arena_resource.hpp"
+
+namespace beyond {
+
+namespace {
+
+constexpr std::size_t max_alignment = alignof(std::max_align_t);
+
+[[nodiscard]] constexpr auto align_up(std::uintptr_t n,
+                                      std::size_t alignment) noexcept
+    -> std::uintptr_t
+{
+  return (n + alignment - 1) & ~(alignment - 1);
+}
+
+// Bumps offset inside the block [base, base + capacity). Returns nullptr if
+// the block does not have enough space left
+[[nodiscard]] auto bump(std::byte* base, std::size_t capacity,
+                        std::size_t& offset, std::size_t bytes,
+                        std::size_t alignment) noexcept -> void*
+{
+  if (base == nullptr) { return nullptr; }
+
+  const auto base_address = reinterpret_cast<std::uintptr_t>(base);
+  const auto address = align_up(base_address + offset, alignment);
+  const auto new_offset = address - base_address + bytes;
+  if (new_offset > capacity) { return nullptr; }
+
+  offset = new_offset;
+  return reinterpret_cast<void*>(address);
+}
+
+} // anonymous namespace
+
+FrameArenaResource::FrameArenaResource(std::size_t frame_capacity,
+                                       std::size_t frames_in_flight,
+                                       MemoryResource& upstream)
+    : upstream_{&upstream}, frame_capacity_{frame_capacity},
+      arenas_(frames_in_flight)
+{
+  BEYOND_ENSURE_MSG(frames_in_flight > 0,
+                    "FrameArenaResource needs at least one frame in flight");
+
+  if (frame_capacity_ != 0) {
+    // Round up so that every arena starts at a max_align_t boundary
+    frame_capacity_ = align_up(frame_capacity_, max_alignment);
+    buffer_ = static_cast<std::byte*>(upstream_->allocate(
+        frame_capacity_ * frames_in_flight, max_alignment));
+    for (std::size_t i = 0; i < frames_in_flight; ++i) {
+      arenas_[i].buffer = buffer_ + i * frame_capacity_;
+    }
+  }
+}
+
+FrameArenaResource::~FrameArenaResource() noexcept
+{
+  for (auto& arena : arenas_) {
+    release_overflow(arena);
+  }
+  if (buffer_ != nullptr) {
+    upstream_->deallocate(buffer_, frame_capacity_ * arenas_.size(),
+                          max_alignment);
+  }
+}
+
+auto FrameArenaResource::begin_frame() -> void
+{
+  BEYOND_ASSERT_MSG(!in_frame_, "begin_frame() is called twice without "
+                                "end_frame()");
+
+  if (frame_count_ != 0) { current_ = (current_ + 1) % arenas_.size(); }
+  ++frame_count_;
+  in_frame_ = true;
+
+  // The arena was last used frames_in_flight() frames ago, so the memory in
+  // it is free to reuse
+  auto& arena = arenas_[current_];
+  release_overflow(arena);
+  arena.offset = 0;
+  arena.bytes_allocated = 0;
+}
+
+auto FrameArenaResource::end_frame() noexcept -> void
+{
+  BEYOND_ASSERT_MSG(in_frame_, "end_frame() is called without begin_frame()");
+  in_frame_ = false;
+}
+
+auto FrameArenaResource::bytes_allocated() const noexcept -> std::size_t
+{
+  return arenas_[current_].bytes_allocated;
+}
+
+auto FrameArenaResource::do_allocate(std::size_t bytes, std::size_t alignment)
+    -> void*
+{
+  BEYOND_ASSERT_MSG(in_frame_, "Allocate outside of a frame");
+
+  auto& arena = arenas_[current_];
+  arena.bytes_allocated += bytes;
+  if (void* p =
+          bump(arena.buffer, frame_capacity_, arena.offset, bytes, alignment);
+      p != nullptr) {
+    return p;
+  }
+  return allocate_overflow(arena, bytes, alignment);
+}
+
+auto FrameArenaResource::do_deallocate(void* /*p*/, std::size_t /*bytes*/,
+                                       std::size_t /*alignment*/) -> void
+{
+  // Memory is reclaimed in bulk when the arena get recycled
+}
+
+auto FrameArenaResource::do_is_equal(
+    const MemoryResource& other) const noexcept -> bool
+{
+  return &other == this;
+}
+
+auto FrameArenaResource::allocate_overflow(Arena& arena, std::size_t bytes,
+                                           std::size_t alignment) -> void*
+{
+  constexpr std::size_t header_size =
+      align_up(sizeof(OverflowBlock), max_alignment);
+
+  if (arena.overflow != nullptr) {
+    auto* base = reinterpret_cast<std::byte*>(arena.overflow) + header_size;
+    if (void* p = bump(base, arena.overflow->size, arena.overflow_offset,
+                       bytes, alignment);
+        p != nullptr) {
+      return p;
+    }
+  }
+
+  // Overflow blocks are at least as large as an arena to amortize the cost of
+  // upstream allocations when a frame goes over its budget by a lot
+  const std::size_t block_size =
+      std::max(frame_capacity_, bytes + std::max(alignment, max_alignment));
+  void* memory = upstream_->allocate(header_size + block_size, max_alignment);
+  arena.overflow =
+      ::new (memory) OverflowBlock{.next = arena.overflow, .size = block_size};
+  arena.overflow_offset = 0;
+
+  auto* base = static_cast<std::byte*>(memory) + header_size;
+  void* p = bump(base, block_size, arena.overflow_offset, bytes, alignment);
+  BEYOND_ASSERT(p != nullptr);
+  return p;
+}
+
+auto FrameArenaResource::release_overflow(Arena& arena) noexcept -> void
+{
+  constexpr std::size_t header_size =
+      align_up(sizeof(OverflowBlock), max_alignment);
+
+  while (arena.overflow != nullptr) {
+    OverflowBlock* block = arena.overflow;
+    arena.overflow = block->next;
+    upstream_->deallocate(block, header_size + block->size, max_alignment);
+  }
+  arena.overflow_offset = 0;
+}
+
+} // namespace beyond
@@ -0,0 +1,123 @@
+#ifndef BEYOND_CORE_ALLOCATORS_FRAME_ARENA_RESOURCE_HPP
+#define BEYOND_CORE_ALLOCATORS_FRAME_ARENA_RESOURCE_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "../utils/copy_move.hpp"
+#include "global_resource.hpp"
+#include "memory_resource.hpp"
+
+namespace beyond {
+
+/**
+ * @brief A ring of monotonic arenas for memory that lives for a fixed number
+ * of frames
+ *
+ * Every frame gets its own linear arena. An allocation is a pointer bump in the
+ * arena of the current frame, and deallocation is a no-op. The arena of a frame
+ * is recycled as a whole when the ring wraps around to it again, so memory
+ * allocated in frame `n` stays valid until `begin_frame()` of frame
+ * `n + frames_in_flight()`.
+ *
+ * If an arena runs out of space, the allocation spills into overflow blocks
+ * requested from the upstream resource, which are released when the arena is
+ * recycled.
+ *
+ * @warning FrameArenaResource is not thread-safe
+ */
+class FrameArenaResource final : public MemoryResource {
+public:
+  /**
+   * @brief Creates a ring of `frames_in_flight` arenas, each with
+   * `frame_capacity` bytes
+   * @pre frames_in_flight shall be at least 1
+   */
+  explicit FrameArenaResource(
+      std::size_t frame_capacity, std::size_t frames_in_flight = 2,
+      MemoryResource& upstream = get_default_resource());
+  ~FrameArenaResource() noexcept override;
+
+  BEYOND_DELETE_COPY(FrameArenaResource)
+  BEYOND_DELETE_MOVE(FrameArenaResource)
+
+  /**
+   * @brief Starts a new frame
+   *
+   * Moves to the next arena in the ring and recycles all the memory that was
+   * allocated from it `frames_in_flight()` frames ago.
+   * @pre The previous frame shall have been ended by `end_frame()`
+   */
+  auto begin_frame() -> void;
+
+  /**
+   * @brief Ends the current frame
+   *
+   * No allocation is allowed until the next `begin_frame()`.
+   */
+  auto end_frame() noexcept -> void;
+
+  /// @brief Gets the number of frames before an arena get recycled
+  [[nodiscard]] auto frames_in_flight() const noexcept -> std::size_t
+  {
+    return arenas_.size();
+  }
+
+  /// @brief Gets the size in bytes of the preallocated buffer of each arena
+  [[nodiscard]] auto frame_capacity() const noexcept -> std::size_t
+  {
+    return frame_capacity_;
+  }
+
+  /// @brief Gets the number of frames that have been begun
+  [[nodiscard]] auto frame_count() const noexcept -> std::size_t
+  {
+    return frame_count_;
+  }
+
+  /// @brief Gets the number of bytes allocated in the current frame
+  [[nodiscard]] auto bytes_allocated() const noexcept -> std::size_t;
+
+  /// @brief Gets the upstream resource that provide the backing memory
+  [[nodiscard]] auto upstream_resource() const noexcept -> MemoryResource&
+  {
+    return *upstream_;
+  }
+
+private:
+  struct OverflowBlock {
+    OverflowBlock* next = nullptr;
+    std::size_t size = 0;
+  };
+
+  struct Arena {
+    std::byte* buffer = nullptr;
+    std::size_t offset = 0;
+    OverflowBlock* overflow = nullptr; // Most recent overflow block
+    std::size_t overflow_offset = 0;
+    std::size_t bytes_allocated = 0;
+  };
+
+  MemoryResource* upstream_;
+  std::byte* buffer_ = nullptr;
+  std::size_t frame_capacity_ = 0;
+  std::vector<Arena> arenas_;
+  std::size_t current_ = 0;
+  std::size_t frame_count_ = 0;
+  bool in_frame_ = false;
+
+  [[nodiscard]] auto do_allocate(std::size_t bytes, std::size_t alignment)
+      -> void* override;
+  auto do_deallocate(void* p, std::size_t bytes, std::size_t alignment)
+      -> void override;
+  [[nodiscard]] auto do_is_equal(const MemoryResource& other) const noexcept
+      -> bool override;
+
+  [[nodiscard]] auto allocate_overflow(Arena& arena, std::size_t bytes,
+                                       std::size_t alignment) -> void*;
+  auto release_overflow(Arena& arena) noexcept -> void;
+};
+
+} // namespace beyond
+
+#endif // BEYOND_CORE_ALLOCATORS_FRAME_ARENA_RESOURCE_HPP
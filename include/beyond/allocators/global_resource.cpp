@@ -13,9 +13,9 @@ struct NewDeleteResource : MemoryResource {
   }
 
   void do_deallocate(void* p, std::size_t /*bytes*/,
-                     std::size_t /*alignment*/) override
+                     std::size_t alignment) override
   {
-    ::operator delete[](p /*bytes, std::align_val_t{alignment}*/);
+    ::operator delete[](p, std::align_val_t{alignment});
   }
 
   [[nodiscard]] auto do_is_equal(const MemoryResource& other) const noexcept
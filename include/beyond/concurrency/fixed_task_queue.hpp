@@ -0,0 +1,174 @@
+#pragma once
+
+#ifndef BEYOND_CORE_CONCURRENCY_FIXED_TASK_QUEUE_HPP
+#define BEYOND_CORE_CONCURRENCY_FIXED_TASK_QUEUE_HPP
+
+#include <beyond/utils/inplace_function.hpp>
+
+#include "../types/optional.hpp"
+
+#include <array>
+#include <condition_variable>
+#include <mutex>
+
+namespace beyond {
+
+/**
+ * @addtogroup core
+ * @{
+ * @addtogroup concurrency
+ * @{
+ */
+
+/**
+ * @brief A serial queue of tasks with a fixed capacity that never allocates
+ *
+ * Tasks are stored as `inplace_function`s in a ring buffer, so pushing a task
+ * whose captures are larger than `task_size` bytes fails to compile instead of
+ * allocating. Real-time threads should submit with `try_push`, which neither
+ * allocates nor blocks.
+ *
+ * @see TaskQueue
+ */
+template <std::size_t capacity, std::size_t task_size = 48>
+class FixedTaskQueue {
+  static_assert(capacity > 0);
+
+public:
+  using Task = beyond::inplace_function<void() const, task_size>;
+
+  FixedTaskQueue() = default;
+
+  /**
+   * @brief Gives up the rest of the tasks in the task queue
+   */
+  auto done() -> void
+  {
+    {
+      std::lock_guard lock{mutex_};
+      done_ = true;
+    }
+    not_empty_.notify_all();
+    not_full_.notify_all();
+  }
+
+  /**
+   * @brief Pops a element from the FixedTaskQueue
+   *
+   * IF the queue is empty, this function will block. If the queue is done. then
+   * this function will return a `std::nullopt`.
+   * @note Block if the queue is empty
+   */
+  [[nodiscard]] auto pop() -> beyond::optional<Task>
+  {
+    beyond::optional<Task> task;
+    {
+      std::unique_lock lock{mutex_};
+      not_empty_.wait(lock, [&]() { return size_ != 0 || done_; });
+      if (done_) { return beyond::nullopt; }
+      task = pop_front();
+    }
+    not_full_.notify_one();
+    return task;
+  }
+
+  /**
+   * @brief Pushes elements into the FixedTaskQueue
+   *
+   * If the queue is full, this function will block until there is space. If
+   * the queue is done, the task is discarded.
+   */
+  template <typename Func> auto push(Func&& f) -> void
+  {
+    {
+      std::unique_lock lock{mutex_};
+      not_full_.wait(lock, [&]() { return size_ != capacity || done_; });
+      if (done_) { return; }
+      push_back(std::forward<Func>(f));
+    }
+    not_empty_.notify_one();
+  }
+
+  /**
+   * @brief Tries to pop a task from the queue
+   *
+   * If the queue is busy or if queue is empty, return `std::nullopt`. Otherwise
+   * return the task poped from the queue.
+   */
+  [[nodiscard]] auto try_pop() -> beyond::optional<Task>
+  {
+    beyond::optional<Task> task;
+    {
+      std::unique_lock lock{mutex_, std::try_to_lock};
+      if (!lock || size_ == 0) { return beyond::nullopt; }
+      task = pop_front();
+    }
+    not_full_.notify_one();
+    return task;
+  }
+
+  /**
+   * @brief Tries to push a task to the queue
+   *
+   * If the queue is busy or full, does not push to the queue and returns false.
+   * Otherwise pushes to the queue and returns true.
+   */
+  template <typename F> auto try_push(F&& f) -> bool
+  {
+    {
+      std::unique_lock lock{mutex_, std::try_to_lock};
+      if (!lock || size_ == capacity) { return false; }
+      push_back(std::forward<F>(f));
+    }
+    not_empty_.notify_one();
+    return true;
+  }
+
+  /**
+   * @brief Returns `true` if the queue is empty
+   */
+  [[nodiscard]] auto empty() const noexcept -> bool
+  {
+    std::lock_guard lock{mutex_};
+    return size_ == 0;
+  }
+
+  /**
+   * @brief Returns the maximum number of tasks the queue can hold
+   */
+  [[nodiscard]] static constexpr auto max_size() noexcept -> std::size_t
+  {
+    return capacity;
+  }
+
+private:
+  std::array<Task, capacity> tasks_; // Protected by the mutex
+  std::size_t head_{0};              // Protected by the mutex
+  std::size_t size_{0};              // Protected by the mutex
+  bool done_{false};                 // Protected by the mutex
+  mutable std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+
+  // @pre Holds the mutex and the queue is not full
+  template <typename Func> auto push_back(Func&& f) -> void
+  {
+    tasks_[(head_ + size_) % capacity] = Task{std::forward<Func>(f)};
+    ++size_;
+  }
+
+  // @pre Holds the mutex and the queue is not empty
+  auto pop_front() -> Task
+  {
+    Task task = std::move(tasks_[head_]);
+    head_ = (head_ + 1) % capacity;
+    --size_;
+    return task;
+  }
+};
+
+/** @}@} */
+
+} // namespace beyond
+
+#endif // BEYOND_CORE_CONCURRENCY_FIXED_TASK_QUEUE_HPP
@@ -31,7 +31,9 @@ namespace beyond {
  */
 class TaskQueue {
 public:
-  using Task = beyond::unique_function<void() const>;
+  /// Tasks store up to 64 bytes of captures inline, enough for a `Mat4` or a
+  /// handle and a few pointers
+  using Task = beyond::unique_function<void() const, 64>;
 
   TaskQueue() = default;
 
@@ -104,7 +106,7 @@ public:
   {
     {
       std::unique_lock lock{mutex_, std::try_to_lock};
-      if (lock.owns_lock()) { return false; }
+      if (!lock) { return false; }
       queue_.emplace(std::forward<F>(f));
     }
     ready_.notify_one();
@@ -0,0 +1,212 @@
+#pragma once
+
+#ifndef BEYOND_CORE_CONCURRENCY_THREAD_POOL_HPP
+#define BEYOND_CORE_CONCURRENCY_THREAD_POOL_HPP
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <latch>
+#include <thread>
+#include <vector>
+
+#include <jthread.hpp>
+
+#include "task_queue.hpp"
+
+namespace beyond {
+
+/**
+ * @addtogroup core
+ * @{
+ * @addtogroup concurrency
+ * @{
+ */
+
+/**
+ * @brief A pool of worker threads
+ *
+ * Every worker owns a TaskQueue. Tasks are pushed to the queues in a
+ * round-robin fashion, and an idle worker steals tasks from the queues of
+ * other workers before it blocks on its own queue.
+ */
+class ThreadPool {
+public:
+  /**
+   * @brief Creates a thread pool with `thread_count` worker threads
+   */
+  explicit ThreadPool(
+      std::size_t thread_count = std::thread::hardware_concurrency())
+      : count_{thread_count == 0 ? 1 : thread_count}, queues_(count_)
+  {
+    threads_.reserve(count_);
+    for (std::size_t i = 0; i < count_; ++i) {
+      threads_.emplace_back([this, i] { run(i); });
+    }
+  }
+
+  /**
+   * @brief Waits for every task to finish, then stops the workers
+   *
+   * Tasks started by other tasks while the pool is being destroyed also run,
+   * so coroutines suspended in `schedule_on` are resumed rather than leaked.
+   * A task that never finishes blocks the destructor.
+   */
+  ~ThreadPool()
+  {
+    for (std::size_t pending = pending_.load(); pending != 0;
+         pending = pending_.load()) {
+      pending_.wait(pending);
+    }
+    for (auto& queue : queues_) {
+      queue.done();
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  auto operator=(const ThreadPool&) & -> ThreadPool& = delete;
+  ThreadPool(ThreadPool&&) noexcept = delete;
+  auto operator=(ThreadPool&&) & noexcept -> ThreadPool& = delete;
+
+  /**
+   * @brief Gets the number of worker threads
+   */
+  [[nodiscard]] auto size() const noexcept -> std::size_t
+  {
+    return count_;
+  }
+
+  /**
+   * @brief Runs `f` on one of the worker threads
+   */
+  template <typename F> auto async(F&& f) -> void
+  {
+    TaskQueue::Task task{std::forward<F>(f)};
+    pending_.fetch_add(1);
+    const auto i = index_++;
+
+    for (std::size_t n = 0; n != count_; ++n) {
+      if (queues_[(i + n) % count_].try_push(std::move(task))) { return; }
+    }
+
+    queues_[i % count_].push(std::move(task));
+  }
+
+private:
+  std::size_t count_;
+  std::vector<TaskQueue> queues_;
+  std::atomic<std::size_t> index_ = 0;
+  // The number of tasks that are queued or running
+  std::atomic<std::size_t> pending_ = 0;
+  // Workers are declared last so that they are joined before the queues die
+  std::vector<nostd::jthread> threads_;
+
+  auto run(std::size_t i) -> void
+  {
+    while (true) {
+      beyond::optional<TaskQueue::Task> task;
+      for (std::size_t n = 0; n != count_ && !task; ++n) {
+        task = queues_[(i + n) % count_].try_pop();
+      }
+      if (!task) { task = queues_[i].pop(); }
+      if (!task) { break; }
+      (*task)();
+      if (pending_.fetch_sub(1) == 1) { pending_.notify_all(); }
+    }
+  }
+};
+
+/**
+ * @brief Awaiter that resumes the awaiting coroutine on a worker thread of a
+ * ThreadPool
+ * @see schedule_on
+ */
+class ThreadPoolScheduleAwaiter {
+public:
+  explicit ThreadPoolScheduleAwaiter(ThreadPool& pool) noexcept : pool_{&pool}
+  {
+  }
+
+  [[nodiscard]] auto await_ready() const noexcept -> bool
+  {
+    return false;
+  }
+
+  auto await_suspend(std::coroutine_handle<> continuation) -> void
+  {
+    pool_->async([continuation]() { continuation.resume(); });
+  }
+
+  auto await_resume() const noexcept -> void {}
+
+private:
+  ThreadPool* pool_;
+};
+
+/**
+ * @brief Transfers the execution of the current coroutine to `pool`
+ *
+ * @example
+ * ```cpp
+ * auto load_mesh(ThreadPool& pool, Path path) -> Task<Mesh>
+ * {
+ *   co_await schedule_on(pool);
+ *   // Runs on a worker thread from here
+ *   co_return parse_mesh(read_file(path));
+ * }
+ * ```
+ */
+[[nodiscard]] inline auto schedule_on(ThreadPool& pool) noexcept
+    -> ThreadPoolScheduleAwaiter
+{
+  return ThreadPoolScheduleAwaiter{pool};
+}
+
+/**
+ * @brief Runs `f(i)` for every i in [0, count) on the worker threads of `pool`
+ * and returns once all of them are done
+ *
+ * Runs everything on the calling thread if `pool` is null or `count` is 1. The
+ * calling thread blocks rather than helping, so `f` must not wait for other
+ * tasks of `pool`.
+ */
+template <typename F>
+auto parallel_for(ThreadPool* pool, std::size_t count, const F& f) -> void
+{
+  if (pool == nullptr || count == 1) {
+    for (std::size_t i = 0; i < count; ++i) { f(i); }
+    return;
+  }
+
+  std::latch done{static_cast<std::ptrdiff_t>(count)};
+  for (std::size_t i = 0; i < count; ++i) {
+    pool->async([&f, &done, i]() {
+      f(i);
+      done.count_down();
+    });
+  }
+  done.wait();
+}
+
+/**
+ * @brief Splits [begin, end) into `chunk_count` contiguous chunks of nearly
+ * equal size and runs `f(chunk, chunk_begin, chunk_end)` for each of them with
+ * parallel_for
+ */
+template <typename F>
+auto parallel_for_chunks(ThreadPool* pool, std::size_t chunk_count,
+                         std::size_t begin, std::size_t end, const F& f)
+    -> void
+{
+  const std::size_t size = end - begin;
+  parallel_for(pool, chunk_count, [&](std::size_t chunk) {
+    f(chunk, begin + size * chunk / chunk_count,
+      begin + size * (chunk + 1) / chunk_count);
+  });
+}
+
+/** @}@} */
+
+} // namespace beyond
+
+#endif // BEYOND_CORE_CONCURRENCY_THREAD_POOL_HPP
@@ -0,0 +1,230 @@
+#ifndef BEYOND_CORE_COROUTINE_ASYNC_GENERATOR_HPP
+#define BEYOND_CORE_COROUTINE_ASYNC_GENERATOR_HPP
+
+#include <concepts>
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#include "frame_allocator.hpp"
+
+namespace beyond {
+
+/**
+ * @brief A lazily evaluated sequence of values produced by a coroutine that
+ * can `co_await` between yields
+ *
+ * Unlike Generator, the coroutine body of an AsyncGenerator may suspend on
+ * other awaitables, for example to wait for an I/O completion. Consequently,
+ * it is consumed from another coroutine by awaiting `begin()` and the
+ * increments of its iterator:
+ *
+ * ```cpp
+ * auto stream_chunks(File& file) -> AsyncGenerator<Chunk>
+ * {
+ *   while (auto chunk = co_await file.read_chunk()) {
+ *     co_yield *chunk;
+ *   }
+ * }
+ *
+ * auto decode(File& file) -> Task<>
+ * {
+ *   auto chunks = stream_chunks(file);
+ *   for (auto itr = co_await chunks.begin(); itr != chunks.end();
+ *        co_await ++itr) {
+ *     decode_chunk(*itr);
+ *   }
+ * }
+ * ```
+ *
+ * When the generator yields, the consumer is resumed by symmetric transfer on
+ * whatever thread the generator is running on.
+ *
+ * Since an AsyncGenerator usually runs and finishes on other threads, its
+ * frame is allocated with the global `operator new` regardless of
+ * `set_coroutine_frame_resource`. To allocate it from a specific resource,
+ * make `std::allocator_arg_t, MemoryResource&` the first two parameters of the
+ * coroutine.
+ */
+template <std::movable T> class AsyncGenerator {
+public:
+  struct promise_type;
+  using Handle = std::coroutine_handle<promise_type>;
+
+  struct promise_type : detail::AllocatorArgPromise {
+    using value_type = std::remove_reference_t<T>;
+    using reference_type = const value_type&;
+    using pointer_type = const value_type*;
+
+    // Suspends the generator and resumes the consumer that awaits it
+    struct YieldAwaiter {
+      [[nodiscard]] auto await_ready() const noexcept -> bool
+      {
+        return false;
+      }
+      [[nodiscard]] auto await_suspend(Handle handle) const noexcept
+          -> std::coroutine_handle<>
+      {
+        return handle.promise().continuation_;
+      }
+      auto await_resume() const noexcept -> void {}
+    };
+
+    [[nodiscard]] auto get_return_object() noexcept -> AsyncGenerator
+    {
+      return AsyncGenerator{Handle::from_promise(*this)};
+    }
+    static auto initial_suspend() noexcept -> std::suspend_always
+    {
+      return {};
+    }
+    static auto final_suspend() noexcept -> YieldAwaiter
+    {
+      return {};
+    }
+    auto yield_value(reference_type v) noexcept -> YieldAwaiter
+    {
+      value_ = std::addressof(v);
+      return {};
+    }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept
+    {
+      exception_ = std::current_exception();
+    }
+
+    void rethrow_if_exception() const
+    {
+      if (exception_) { std::rethrow_exception(exception_); }
+    }
+
+    std::coroutine_handle<> continuation_;
+    std::exception_ptr exception_;
+    pointer_type value_ = nullptr;
+  };
+
+  class Iter;
+
+private:
+  // Resumes the generator until it yields the next value or finishes
+  struct AdvanceAwaiter {
+    Handle handle_;
+
+    [[nodiscard]] auto await_ready() const noexcept -> bool
+    {
+      return !handle_ || handle_.done();
+    }
+    [[nodiscard]] auto await_suspend(std::coroutine_handle<> consumer) noexcept
+        -> std::coroutine_handle<>
+    {
+      handle_.promise().continuation_ = consumer;
+      return handle_;
+    }
+  };
+
+  struct BeginAwaiter : AdvanceAwaiter {
+    auto await_resume() -> Iter
+    {
+      if (this->handle_) { this->handle_.promise().rethrow_if_exception(); }
+      return Iter{this->handle_};
+    }
+  };
+
+  struct IncrementAwaiter : AdvanceAwaiter {
+    Iter* iter_;
+
+    auto await_resume() -> Iter&
+    {
+      this->handle_.promise().rethrow_if_exception();
+      return *iter_;
+    }
+  };
+
+public:
+  class Iter {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = typename promise_type::value_type;
+    using reference = typename promise_type::reference_type;
+    using pointer = typename promise_type::pointer_type;
+    using difference_type = std::ptrdiff_t;
+
+    Iter() = default;
+    explicit Iter(const Handle coroutine) noexcept : handle_{coroutine} {}
+
+    /**
+     * @brief Resumes the generator to produce the next element
+     * @note The result shall be `co_await`ed before the iterator is used again
+     */
+    [[nodiscard]] auto operator++() noexcept -> IncrementAwaiter
+    {
+      return IncrementAwaiter{{handle_}, this};
+    }
+
+    [[nodiscard]] auto operator*() const -> reference
+    {
+      return *handle_.promise().value_;
+    }
+
+    [[nodiscard]] auto operator->() const -> pointer
+    {
+      return handle_.promise().value_;
+    }
+
+    [[nodiscard]] auto operator==(std::default_sentinel_t) const noexcept
+        -> bool
+    {
+      return !handle_ || handle_.done();
+    }
+
+  private:
+    Handle handle_;
+  };
+
+  explicit AsyncGenerator(const Handle handle) noexcept : handle_{handle} {}
+
+  AsyncGenerator() = default;
+  ~AsyncGenerator()
+  {
+    if (handle_) { handle_.destroy(); }
+  }
+
+  AsyncGenerator(const AsyncGenerator&) = delete;
+  auto operator=(const AsyncGenerator&) -> AsyncGenerator& = delete;
+
+  AsyncGenerator(AsyncGenerator&& other) noexcept
+      : handle_{std::exchange(other.handle_, {})}
+  {
+  }
+  auto operator=(AsyncGenerator&& other) & noexcept -> AsyncGenerator&
+  {
+    if (this != &other) {
+      if (handle_) { handle_.destroy(); }
+      handle_ = std::exchange(other.handle_, {});
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Starts the generator
+   * @return An awaitable that produces an iterator to the first element
+   */
+  [[nodiscard]] auto begin() noexcept -> BeginAwaiter
+  {
+    return BeginAwaiter{{handle_}};
+  }
+
+  [[nodiscard]] auto end() const noexcept -> std::default_sentinel_t
+  {
+    return {};
+  }
+
+private:
+  Handle handle_;
+};
+
+} // namespace beyond
+
+#endif // BEYOND_CORE_COROUTINE_ASYNC_GENERATOR_HPP
@@ -0,0 +1,194 @@
+#ifndef BEYOND_CORE_COROUTINE_BATCH_GENERATOR_HPP
+#define BEYOND_CORE_COROUTINE_BATCH_GENERATOR_HPP
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <utility>
+
+#include "frame_allocator.hpp"
+
+namespace beyond {
+
+/**
+ * @brief A lazily evaluated sequence of values that a coroutine produces in
+ * batches
+ *
+ * Iterating a Generator costs a resume and a suspend per element, which
+ * dominates when the elements are tiny. Instead, the coroutine of a
+ * BatchGenerator fills a buffer and yields it as a `std::span<const T>`. The
+ * consumer either takes whole batches with `next_batch()`, or iterates over
+ * the elements one by one, in which case the coroutine is only resumed after
+ * the iterator walks past the end of the current batch:
+ *
+ * ```cpp
+ * auto emit(std::size_t count) -> BatchGenerator<float>
+ * {
+ *   std::array<float, 256> buffer;
+ *   for (std::size_t i = 0; i < count; i += buffer.size()) {
+ *     const auto n = std::min(buffer.size(), count - i);
+ *     fill_particles(std::span{buffer}.first(n));
+ *     co_yield std::span{buffer}.first(n);
+ *   }
+ * }
+ * ```
+ *
+ * The yielded buffer must stay valid until the coroutine is resumed. Empty
+ * batches are skipped.
+ *
+ * @see Generator
+ */
+template <typename T> class BatchGenerator {
+public:
+  using value_type = T;
+  using Batch = std::span<const T>;
+
+  struct promise_type : detail::FrameAllocatingPromise {
+    [[nodiscard]] auto get_return_object() -> BatchGenerator
+    {
+      return BatchGenerator{Handle::from_promise(*this)};
+    }
+    static auto initial_suspend() noexcept -> std::suspend_always
+    {
+      return {};
+    }
+    static auto final_suspend() noexcept -> std::suspend_always
+    {
+      return {};
+    }
+    auto yield_value(Batch batch) noexcept -> std::suspend_always
+    {
+      batch_ = batch;
+      return {};
+    }
+    void return_void() noexcept {}
+    // Disallow co_await in generator coroutines.
+    void await_transform() = delete;
+    void unhandled_exception()
+    {
+      exception_ = std::current_exception();
+    }
+
+    void rethrow_if_exception()
+    {
+      if (exception_) { std::rethrow_exception(exception_); }
+    }
+
+    std::exception_ptr exception_;
+    Batch batch_;
+  };
+
+  using Handle = std::coroutine_handle<promise_type>;
+
+  class Iter {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = T;
+    using reference = const T&;
+    using pointer = const T*;
+    using difference_type = std::ptrdiff_t;
+
+    Iter() = default;
+    Iter(BatchGenerator* generator, Batch batch) noexcept
+        : generator_{generator}, batch_{batch}
+    {
+    }
+
+    auto operator++() -> Iter&
+    {
+      if (++index_ == batch_.size()) {
+        batch_ = generator_->next_batch();
+        index_ = 0;
+      }
+      return *this;
+    }
+
+    void operator++(int)
+    {
+      this->operator++();
+    }
+
+    [[nodiscard]] auto operator*() const -> reference
+    {
+      return batch_[index_];
+    }
+
+    [[nodiscard]] auto operator==(std::default_sentinel_t) const noexcept
+        -> bool
+    {
+      return batch_.empty();
+    }
+
+  private:
+    BatchGenerator* generator_ = nullptr;
+    Batch batch_;
+    std::size_t index_ = 0;
+  };
+
+  explicit BatchGenerator(const Handle handle) : handle_{handle} {}
+
+  BatchGenerator() = default;
+  ~BatchGenerator()
+  {
+    if (handle_) { handle_.destroy(); }
+  }
+
+  BatchGenerator(const BatchGenerator&) = delete;
+  auto operator=(const BatchGenerator&) -> BatchGenerator& = delete;
+
+  BatchGenerator(BatchGenerator&& other) noexcept
+      : handle_{std::exchange(other.handle_, {})}
+  {
+  }
+  auto operator=(BatchGenerator&& other) & noexcept -> BatchGenerator&
+  {
+    if (this != &other) {
+      if (handle_) { handle_.destroy(); }
+      handle_ = std::exchange(other.handle_, {});
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Resumes the coroutine until it yields the next non-empty batch
+   * @return The next batch, or an empty span if the generator is finished
+   * @note The batch is invalidated when the generator is resumed again
+   */
+  [[nodiscard]] auto next_batch() -> Batch
+  {
+    while (handle_ && !handle_.done()) {
+      handle_.resume();
+      if (handle_.done()) {
+        handle_.promise().rethrow_if_exception();
+        break;
+      }
+      if (const Batch batch = handle_.promise().batch_; !batch.empty()) {
+        return batch;
+      }
+    }
+    return {};
+  }
+
+  [[nodiscard]] auto begin() -> Iter
+  {
+    return Iter{this, next_batch()};
+  }
+  [[nodiscard]] auto end() const noexcept -> std::default_sentinel_t
+  {
+    return {};
+  }
+
+private:
+  Handle handle_;
+};
+
+} // namespace beyond
+
+template <class T>
+inline constexpr bool std::ranges::enable_view<beyond::BatchGenerator<T>> =
+    true;
+
+#endif // BEYOND_CORE_COROUTINE_BATCH_GENERATOR_HPP
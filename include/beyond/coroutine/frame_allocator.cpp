@@ -0,0 +1,106 @@
+#include <new>
+
+#include "frame_allocator.hpp"
+
+namespace beyond {
+
+namespace {
+
+constexpr std::size_t max_alignment = alignof(std::max_align_t);
+
+// Gets the index of the freelist that serves blocks of `bytes` bytes
+[[nodiscard]] constexpr auto bucket_index(std::size_t bytes) noexcept
+    -> std::size_t
+{
+  constexpr std::size_t granularity = CoroutineFramePool::bucket_granularity;
+  return bytes == 0 ? 0 : (bytes - 1) / granularity;
+}
+
+[[nodiscard]] constexpr auto is_pooled(std::size_t bytes,
+                                       std::size_t alignment) noexcept -> bool
+{
+  return bytes <= CoroutineFramePool::max_pooled_size &&
+         alignment <= max_alignment;
+}
+
+} // anonymous namespace
+
+CoroutineFramePool::~CoroutineFramePool() noexcept
+{
+  release();
+}
+
+auto CoroutineFramePool::release() noexcept -> void
+{
+  for (std::size_t i = 0; i < bucket_count; ++i) {
+    const std::size_t block_size = (i + 1) * bucket_granularity;
+    while (free_lists_[i] != nullptr) {
+      FreeBlock* block = free_lists_[i];
+      free_lists_[i] = block->next;
+      upstream_->deallocate(block, block_size, max_alignment);
+    }
+  }
+}
+
+auto CoroutineFramePool::do_allocate(std::size_t bytes, std::size_t alignment)
+    -> void*
+{
+  if (!is_pooled(bytes, alignment)) {
+    return upstream_->allocate(bytes, alignment);
+  }
+
+  const std::size_t i = bucket_index(bytes);
+  if (FreeBlock* block = free_lists_[i]; block != nullptr) {
+    free_lists_[i] = block->next;
+    return block;
+  }
+  return upstream_->allocate((i + 1) * bucket_granularity, max_alignment);
+}
+
+auto CoroutineFramePool::do_deallocate(void* p, std::size_t bytes,
+                                       std::size_t alignment) -> void
+{
+  if (!is_pooled(bytes, alignment)) {
+    upstream_->deallocate(p, bytes, alignment);
+    return;
+  }
+
+  const std::size_t i = bucket_index(bytes);
+  free_lists_[i] = ::new (p) FreeBlock{.next = free_lists_[i]};
+}
+
+auto CoroutineFramePool::do_is_equal(
+    const MemoryResource& other) const noexcept -> bool
+{
+  return &other == this;
+}
+
+namespace {
+
+// Null while frames are allocated with the global operator new. Unlike a
+// per-thread pool, that lets frames be freed on any thread, even after the
+// thread that allocated them has exited
+thread_local MemoryResource* thread_frame_resource = nullptr;
+
+} // anonymous namespace
+
+auto detail::thread_coroutine_frame_resource() noexcept -> MemoryResource*
+{
+  return thread_frame_resource;
+}
+
+auto get_coroutine_frame_resource() noexcept -> MemoryResource&
+{
+  return thread_frame_resource != nullptr ? *thread_frame_resource
+                                          : new_delete_resource();
+}
+
+auto set_coroutine_frame_resource(MemoryResource& r) noexcept
+    -> MemoryResource&
+{
+  MemoryResource& previous = get_coroutine_frame_resource();
+  thread_frame_resource = &r == &new_delete_resource() ? nullptr : &r;
+  return previous;
+}
+
+} // namespace beyond
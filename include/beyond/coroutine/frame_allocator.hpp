@@ -0,0 +1,187 @@
+#ifndef BEYOND_CORE_COROUTINE_FRAME_ALLOCATOR_HPP
+#define BEYOND_CORE_COROUTINE_FRAME_ALLOCATOR_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+
+#include "../allocators/global_resource.hpp"
+#include "../allocators/memory_resource.hpp"
+#include "../utils/copy_move.hpp"
+
+namespace beyond {
+
+/**
+ * @brief A memory resource that recycles coroutine frames
+ *
+ * Freed blocks are kept in freelists bucketed by size in steps of
+ * `bucket_granularity` bytes, so a coroutine that is created and destroyed
+ * over and over reuses the same frame without touching the upstream resource.
+ * Blocks larger than `max_pooled_size` or with an extended alignment are
+ * forwarded to the upstream resource.
+ *
+ * @warning CoroutineFramePool is not thread-safe
+ */
+class CoroutineFramePool final : public MemoryResource {
+public:
+  static constexpr std::size_t bucket_granularity = 64;
+  static constexpr std::size_t bucket_count = 32;
+  static constexpr std::size_t max_pooled_size =
+      bucket_granularity * bucket_count;
+
+  explicit CoroutineFramePool(
+      MemoryResource& upstream = new_delete_resource()) noexcept
+      : upstream_{&upstream}
+  {
+  }
+  ~CoroutineFramePool() noexcept override;
+
+  BEYOND_DELETE_COPY(CoroutineFramePool)
+  BEYOND_DELETE_MOVE(CoroutineFramePool)
+
+  /**
+   * @brief Returns all the cached blocks to the upstream resource
+   */
+  auto release() noexcept -> void;
+
+  /// @brief Gets the upstream resource that provide the backing memory
+  [[nodiscard]] auto upstream_resource() const noexcept -> MemoryResource&
+  {
+    return *upstream_;
+  }
+
+private:
+  struct FreeBlock {
+    FreeBlock* next = nullptr;
+  };
+
+  MemoryResource* upstream_;
+  std::array<FreeBlock*, bucket_count> free_lists_{};
+
+  [[nodiscard]] auto do_allocate(std::size_t bytes, std::size_t alignment)
+      -> void* override;
+  auto do_deallocate(void* p, std::size_t bytes, std::size_t alignment)
+      -> void override;
+  [[nodiscard]] auto do_is_equal(const MemoryResource& other) const noexcept
+      -> bool override;
+};
+
+/**
+ * @brief Gets the memory resource that coroutine frames of the current thread
+ * are allocated from by default
+ *
+ * Initially, frames are allocated with the global `operator new` and this
+ * returns `new_delete_resource()`, so coroutines can be destroyed on any
+ * thread.
+ *
+ * @warning A coroutine whose frame comes from a resource that is not
+ * thread-safe, such as a CoroutineFramePool, shall be destroyed on the thread
+ * that created it, while the resource is still alive
+ */
+auto get_coroutine_frame_resource() noexcept -> MemoryResource&;
+
+/**
+ * @brief Sets the memory resource that coroutine frames of the current thread
+ * are allocated from by default
+ * @return The previous resource
+ */
+auto set_coroutine_frame_resource(MemoryResource& r) noexcept
+    -> MemoryResource&;
+
+namespace detail {
+
+// The resource set with set_coroutine_frame_resource on the current thread, or
+// nullptr if frames are allocated with the global operator new
+[[nodiscard]] auto thread_coroutine_frame_resource() noexcept
+    -> MemoryResource*;
+
+// Frames store a pointer to their memory resource after the frame itself, so
+// they can be deallocated without knowing which resource they came from. A
+// null resource stands for the global operator new
+[[nodiscard]] constexpr auto frame_resource_offset(std::size_t size) noexcept
+    -> std::size_t
+{
+  constexpr std::size_t alignment = alignof(MemoryResource*);
+  return (size + alignment - 1) & ~(alignment - 1);
+}
+
+[[nodiscard]] inline auto allocate_frame(MemoryResource* resource,
+                                         std::size_t size) -> void*
+{
+  const std::size_t offset = frame_resource_offset(size);
+  const std::size_t total_size = offset + sizeof(MemoryResource*);
+  void* frame = resource != nullptr ? resource->allocate(total_size)
+                                    : ::operator new(total_size);
+  std::memcpy(static_cast<std::byte*>(frame) + offset, &resource,
+              sizeof(MemoryResource*));
+  return frame;
+}
+
+inline auto deallocate_frame(void* frame, std::size_t size) noexcept -> void
+{
+  const std::size_t offset = frame_resource_offset(size);
+  MemoryResource* resource = nullptr;
+  std::memcpy(&resource, static_cast<std::byte*>(frame) + offset,
+              sizeof(MemoryResource*));
+  const std::size_t total_size = offset + sizeof(MemoryResource*);
+  if (resource != nullptr) {
+    resource->deallocate(frame, total_size);
+  } else {
+    ::operator delete(frame, total_size);
+  }
+}
+
+// Base class of promise types whose coroutine frames are allocated with the
+// global operator new, or from the MemoryResource passed after
+// `std::allocator_arg`
+struct AllocatorArgPromise {
+  [[nodiscard]] static auto operator new(std::size_t size) -> void*
+  {
+    return allocate_frame(nullptr, size);
+  }
+
+  // Selected for free functions whose first parameters are
+  // `std::allocator_arg_t, MemoryResource&`
+  template <typename... Args>
+  [[nodiscard]] static auto operator new(std::size_t size, std::allocator_arg_t,
+                                         MemoryResource& resource,
+                                         const Args&...) -> void*
+  {
+    return allocate_frame(std::addressof(resource), size);
+  }
+
+  // Selected for member functions whose first parameters are
+  // `std::allocator_arg_t, MemoryResource&`
+  template <typename Class, typename... Args>
+  [[nodiscard]] static auto operator new(std::size_t size, const Class&,
+                                         std::allocator_arg_t,
+                                         MemoryResource& resource,
+                                         const Args&...) -> void*
+  {
+    return allocate_frame(std::addressof(resource), size);
+  }
+
+  static auto operator delete(void* frame, std::size_t size) noexcept -> void
+  {
+    deallocate_frame(frame, size);
+  }
+};
+
+// Base class of promise types that also allocate their coroutine frames from
+// the resource set with set_coroutine_frame_resource
+struct FrameAllocatingPromise : AllocatorArgPromise {
+  using AllocatorArgPromise::operator new;
+
+  [[nodiscard]] static auto operator new(std::size_t size) -> void*
+  {
+    return allocate_frame(thread_coroutine_frame_resource(), size);
+  }
+};
+
+} // namespace detail
+
+} // namespace beyond
+
+#endif // BEYOND_CORE_COROUTINE_FRAME_ALLOCATOR_HPP
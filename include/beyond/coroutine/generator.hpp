@@ -4,17 +4,116 @@
 #include <concepts>
 #include <coroutine>
 #include <exception>
+#include <iterator>
 #include <memory>
+#include <ranges>
+#include <utility>
+
+#include "frame_allocator.hpp"
 
 namespace beyond {
 
+template <std::movable T> class Generator;
+
+/**
+ * @brief Wraps a range so that `co_yield` in a Generator yields its elements
+ * one by one
+ * @see Generator
+ */
+template <typename Range> struct ElementsOf {
+  Range range;
+};
+
+template <typename Range>
+[[nodiscard]] auto elements_of(Range&& range) noexcept -> ElementsOf<Range&&>
+{
+  return ElementsOf<Range&&>{std::forward<Range>(range)};
+}
+
+/**
+ * @brief A lazily evaluated sequence of values produced by a coroutine
+ *
+ * A generator can yield all the elements of another range with
+ * `co_yield elements_of(range)`. When the range is another Generator, the
+ * nested generator is resumed directly by the consumer, so the cost of getting
+ * an element does not depend on how deep the generators are nested:
+ *
+ * ```cpp
+ * auto visit(const Node& node) -> Generator<int>
+ * {
+ *   co_yield node.value;
+ *   for (const Node& child : node.children) {
+ *     co_yield elements_of(visit(child));
+ *   }
+ * }
+ * ```
+ *
+ * Coroutine frames are allocated from `get_coroutine_frame_resource()`, which
+ * is the global `operator new` unless a thread sets a resource such as a
+ * CoroutineFramePool. To allocate the frame from a specific resource, make
+ * `std::allocator_arg_t, MemoryResource&` the first two parameters of the
+ * coroutine:
+ *
+ * ```cpp
+ * auto range(std::allocator_arg_t, MemoryResource&, int n) -> Generator<int>;
+ * ```
+ */
 template <std::movable T> class Generator {
 public:
-  struct promise_type {
+  struct promise_type;
+  using Handle = std::coroutine_handle<promise_type>;
+
+  struct promise_type : detail::FrameAllocatingPromise {
     using value_type = std::remove_reference_t<T>;
     using reference_type = const value_type&;
     using pointer_type = const value_type*;
 
+    // Resumes the generator that yields the elements of this one, if any
+    struct FinalAwaiter {
+      [[nodiscard]] auto await_ready() const noexcept -> bool
+      {
+        return false;
+      }
+      [[nodiscard]] auto await_suspend(Handle handle) const noexcept
+          -> std::coroutine_handle<>
+      {
+        promise_type& promise = handle.promise();
+        if (promise.parent_ == nullptr) { return std::noop_coroutine(); }
+        promise.root_->leaf_ = Handle::from_promise(*promise.parent_);
+        return promise.root_->leaf_;
+      }
+      auto await_resume() const noexcept -> void {}
+    };
+
+    // Starts a nested generator, which becomes the leaf that the consumer
+    // resumes until it finishes
+    struct NestedAwaiter {
+      Generator nested_;
+
+      // A generator that already ran to completion has nothing to yield, and
+      // must not be resumed again
+      [[nodiscard]] auto await_ready() const noexcept -> bool
+      {
+        return !nested_.handle_ || nested_.handle_.done();
+      }
+      [[nodiscard]] auto await_suspend(Handle handle) noexcept
+          -> std::coroutine_handle<>
+      {
+        promise_type& nested = nested_.handle_.promise();
+        promise_type& parent = handle.promise();
+        nested.root_ = parent.root_;
+        nested.parent_ = &parent;
+        parent.root_->leaf_ = nested_.handle_;
+        return nested_.handle_;
+      }
+      auto await_resume() -> void
+      {
+        if (nested_.handle_) {
+          nested_.handle_.promise().rethrow_if_exception();
+        }
+      }
+    };
+
     auto return_void() -> std::suspend_always
     {
       return {};
@@ -22,21 +121,34 @@ public:
 
     [[nodiscard]] auto get_return_object() -> Generator
     {
-      return Generator{Handle::from_promise(*this)};
+      leaf_ = Handle::from_promise(*this);
+      return Generator{leaf_};
     }
     static auto initial_suspend() noexcept -> std::suspend_always
     {
       return {};
     }
-    static auto final_suspend() noexcept -> std::suspend_always
+    static auto final_suspend() noexcept -> FinalAwaiter
     {
       return {};
     }
     auto yield_value(reference_type v) noexcept -> std::suspend_always
     {
-      value_ = std::addressof(v);
+      root_->value_ = std::addressof(v);
       return {};
     }
+    auto yield_value(ElementsOf<Generator&&> elements) noexcept
+        -> NestedAwaiter
+    {
+      return NestedAwaiter{std::move(elements.range)};
+    }
+    template <std::ranges::input_range Range>
+      requires std::convertible_to<std::ranges::range_reference_t<Range>,
+                                   reference_type>
+    auto yield_value(ElementsOf<Range> elements) -> NestedAwaiter
+    {
+      return NestedAwaiter{yield_all(std::forward<Range>(elements.range))};
+    }
     // Disallow co_await in generator coroutines.
     void await_transform() = delete;
     void unhandled_exception()
@@ -50,10 +162,20 @@ public:
     }
 
     std::exception_ptr exception_;
-    pointer_type value_ = nullptr;
-  };
+    pointer_type value_ = nullptr; // Only used by the root
 
-  using Handle = std::coroutine_handle<promise_type>;
+    promise_type* root_ = this;      // The outermost generator
+    promise_type* parent_ = nullptr; // The generator that yields this one
+    Handle leaf_;                    // The innermost active generator of a root
+
+  private:
+    template <typename Range> static auto yield_all(Range&& range) -> Generator
+    {
+      for (auto&& element : range) {
+        co_yield static_cast<reference_type>(element);
+      }
+    }
+  };
 
   explicit Generator(const Handle handle) : handle_{handle} {}
 
@@ -113,7 +235,7 @@ public:
 
     auto operator++() -> Iter&
     {
-      handle_.resume();
+      handle_.promise().leaf_.resume();
       if (handle_.done()) { handle_.promise().rethrow_if_exception(); }
       return *this;
     }
@@ -0,0 +1,335 @@
+#ifndef BEYOND_CORE_COROUTINE_TASK_HPP
+#define BEYOND_CORE_COROUTINE_TASK_HPP
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <utility>
+
+#include "../types/optional.hpp"
+#include "../utils/assert.hpp"
+
+namespace beyond {
+
+template <typename T = void> class Task;
+
+namespace detail {
+
+struct TaskPromiseBase {
+  // Resumes whoever awaits the task by symmetric transfer, so that a chain of
+  // tasks that complete synchronously does not grow the stack
+  struct FinalAwaiter {
+    [[nodiscard]] auto await_ready() const noexcept -> bool
+    {
+      return false;
+    }
+
+    template <typename Promise>
+    [[nodiscard]] auto
+    await_suspend(std::coroutine_handle<Promise> handle) const noexcept
+        -> std::coroutine_handle<>
+    {
+      return handle.promise().continuation_;
+    }
+
+    auto await_resume() const noexcept -> void {}
+  };
+
+  static auto initial_suspend() noexcept -> std::suspend_always
+  {
+    return {};
+  }
+  static auto final_suspend() noexcept -> FinalAwaiter
+  {
+    return {};
+  }
+  void unhandled_exception() noexcept
+  {
+    exception_ = std::current_exception();
+  }
+
+  void rethrow_if_exception() const
+  {
+    if (exception_) { std::rethrow_exception(exception_); }
+  }
+
+  std::coroutine_handle<> continuation_ = std::noop_coroutine();
+  std::exception_ptr exception_;
+};
+
+template <typename T> struct TaskPromise : TaskPromiseBase {
+  [[nodiscard]] auto get_return_object() noexcept -> Task<T>;
+
+  template <typename U>
+    requires std::convertible_to<U&&, T>
+  void return_value(U&& value)
+  {
+    value_.emplace(std::forward<U>(value));
+  }
+
+  [[nodiscard]] auto result() & -> T&
+  {
+    rethrow_if_exception();
+    return *value_;
+  }
+
+  [[nodiscard]] auto result() && -> T
+  {
+    rethrow_if_exception();
+    return std::move(*value_);
+  }
+
+  beyond::optional<T> value_;
+};
+
+template <> struct TaskPromise<void> : TaskPromiseBase {
+  [[nodiscard]] auto get_return_object() noexcept -> Task<void>;
+
+  void return_void() noexcept {}
+
+  void result() const
+  {
+    rethrow_if_exception();
+  }
+};
+
+} // namespace detail
+
+/**
+ * @brief A lazily started coroutine that produces a value of type `T`
+ *
+ * The body of a Task does not run until the Task is `co_await`ed. When the task
+ * completes, the awaiting coroutine is resumed on the same thread. Use
+ * `sync_wait` to wait for a task from a non-coroutine.
+ *
+ * @see sync_wait, schedule_on
+ */
+template <typename T> class [[nodiscard]] Task {
+public:
+  using promise_type = detail::TaskPromise<T>;
+  using Handle = std::coroutine_handle<promise_type>;
+
+private:
+  template <bool move_result> struct Awaiter {
+    Handle handle_;
+
+    [[nodiscard]] auto await_ready() const noexcept -> bool
+    {
+      BEYOND_ASSERT(handle_);
+      return handle_.done();
+    }
+
+    [[nodiscard]] auto
+    await_suspend(std::coroutine_handle<> continuation) noexcept
+        -> std::coroutine_handle<>
+    {
+      handle_.promise().continuation_ = continuation;
+      return handle_;
+    }
+
+    auto await_resume() -> decltype(auto)
+    {
+      if constexpr (move_result) {
+        return std::move(handle_.promise()).result();
+      } else {
+        return handle_.promise().result();
+      }
+    }
+  };
+
+public:
+  Task() = default;
+  explicit Task(Handle handle) noexcept : handle_{handle} {}
+
+  ~Task()
+  {
+    if (handle_) { handle_.destroy(); }
+  }
+
+  Task(const Task&) = delete;
+  auto operator=(const Task&) -> Task& = delete;
+
+  Task(Task&& other) noexcept : handle_{std::exchange(other.handle_, {})} {}
+  auto operator=(Task&& other) & noexcept -> Task&
+  {
+    if (this != &other) {
+      if (handle_) { handle_.destroy(); }
+      handle_ = std::exchange(other.handle_, {});
+    }
+    return *this;
+  }
+
+  /// @brief Returns true if the task has completed
+  [[nodiscard]] auto is_ready() const noexcept -> bool
+  {
+    return !handle_ || handle_.done();
+  }
+
+  /**
+   * @brief Starts the task if it has not started yet, and resumes the awaiting
+   * coroutine with its result once it completes
+   * @pre The task holds a coroutine, that is, it is neither default
+   * constructed nor moved from
+   */
+  auto operator co_await() & noexcept -> Awaiter<false>
+  {
+    return Awaiter<false>{handle_};
+  }
+
+  /**
+   * @brief Same as awaiting an lvalue task, but moves the result out of it
+   * @pre The task holds a coroutine
+   */
+  auto operator co_await() && noexcept -> Awaiter<true>
+  {
+    return Awaiter<true>{handle_};
+  }
+
+private:
+  Handle handle_;
+};
+
+template <typename T>
+auto detail::TaskPromise<T>::get_return_object() noexcept -> Task<T>
+{
+  return Task<T>{std::coroutine_handle<TaskPromise>::from_promise(*this)};
+}
+
+inline auto detail::TaskPromise<void>::get_return_object() noexcept
+    -> Task<void>
+{
+  return Task<void>{std::coroutine_handle<TaskPromise>::from_promise(*this)};
+}
+
+namespace detail {
+
+// Signals the thread blocked in sync_wait. It lives on the stack of that
+// thread rather than in the coroutine frame, because the waiting thread
+// destroys the frame as soon as it wakes up
+class SyncWaitEvent {
+public:
+  // Notifies while holding the lock, so that the waiting thread cannot return
+  // and destroy the event before the notification is done
+  auto set() -> void
+  {
+    std::lock_guard lock{mutex_};
+    done_ = true;
+    ready_.notify_one();
+  }
+
+  auto wait() -> void
+  {
+    std::unique_lock lock{mutex_};
+    ready_.wait(lock, [this]() { return done_; });
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  bool done_ = false; // Protected by the mutex
+};
+
+// The coroutine that sync_wait uses to await a task and signals the waiting
+// thread once the task finishes
+class SyncWaitTask {
+public:
+  struct promise_type {
+    SyncWaitEvent* event_ = nullptr;
+    std::exception_ptr exception_;
+
+    struct FinalAwaiter {
+      [[nodiscard]] auto await_ready() const noexcept -> bool
+      {
+        return false;
+      }
+      // Setting the event must be the last action, since the frame may be
+      // destroyed right after it
+      auto await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+          -> void
+      {
+        handle.promise().event_->set();
+      }
+      auto await_resume() const noexcept -> void {}
+    };
+
+    [[nodiscard]] auto get_return_object() noexcept -> SyncWaitTask
+    {
+      return SyncWaitTask{
+          std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+    static auto initial_suspend() noexcept -> std::suspend_always
+    {
+      return {};
+    }
+    static auto final_suspend() noexcept -> FinalAwaiter
+    {
+      return {};
+    }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept
+    {
+      exception_ = std::current_exception();
+    }
+  };
+
+  explicit SyncWaitTask(std::coroutine_handle<promise_type> handle) noexcept
+      : handle_{handle}
+  {
+  }
+  ~SyncWaitTask()
+  {
+    handle_.destroy();
+  }
+  SyncWaitTask(const SyncWaitTask&) = delete;
+  auto operator=(const SyncWaitTask&) -> SyncWaitTask& = delete;
+
+  // Runs the coroutine and blocks until it completes
+  auto run() -> void
+  {
+    SyncWaitEvent event;
+    auto& promise = handle_.promise();
+    promise.event_ = &event;
+    handle_.resume();
+    event.wait();
+    if (promise.exception_) { std::rethrow_exception(promise.exception_); }
+  }
+
+private:
+  std::coroutine_handle<promise_type> handle_;
+};
+
+template <typename T>
+auto make_sync_wait_task(Task<T>& task, beyond::optional<T>& result)
+    -> SyncWaitTask
+{
+  result.emplace(co_await std::move(task));
+}
+
+inline auto make_sync_wait_task(Task<void>& task) -> SyncWaitTask
+{
+  co_await std::move(task);
+}
+
+} // namespace detail
+
+/**
+ * @brief Blocks the current thread until `task` completes, and returns its
+ * result
+ *
+ * If the task throws, the exception is rethrown from `sync_wait`.
+ */
+template <typename T> auto sync_wait(Task<T> task) -> T
+{
+  if constexpr (std::is_void_v<T>) {
+    detail::make_sync_wait_task(task).run();
+  } else {
+    beyond::optional<T> result;
+    detail::make_sync_wait_task(task, result).run();
+    return std::move(*result);
+  }
+}
+
+} // namespace beyond
+
+#endif // BEYOND_CORE_COROUTINE_TASK_HPP
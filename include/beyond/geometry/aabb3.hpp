@@ -117,6 +117,43 @@ auto operator<<(std::ostream& os, const AABB3& box) -> std::ostream&;
                 std::max(box0.max().z, box1.max().z)}};
 }
 
+/**
+ * @brief Whether two AABBs overlap. Boxes that only touch count as overlapping
+ * @related AABB3
+ */
+[[nodiscard]] constexpr auto overlaps(const AABB3& box0, const AABB3& box1)
+    -> bool
+{
+  return box0.min().x <= box1.max().x && box1.min().x <= box0.max().x &&
+         box0.min().y <= box1.max().y && box1.min().y <= box0.max().y &&
+         box0.min().z <= box1.max().z && box1.min().z <= box0.max().z;
+}
+
+/**
+ * @brief Whether the AABB `outer` encloses the AABB `inner`
+ * @related AABB3
+ */
+[[nodiscard]] constexpr auto contains(const AABB3& outer, const AABB3& inner)
+    -> bool
+{
+  return outer.min().x <= inner.min().x && outer.min().y <= inner.min().y &&
+         outer.min().z <= inner.min().z && inner.max().x <= outer.max().x &&
+         inner.max().y <= outer.max().y && inner.max().z <= outer.max().z;
+}
+
+/**
+ * @brief Half of the surface area of an AABB
+ *
+ * The surface area heuristic only compares areas, so the factor of 2 is left
+ * out.
+ * @related AABB3
+ */
+[[nodiscard]] inline auto half_surface_area(const AABB3& box) noexcept -> float
+{
+  const Vec3 e = box.max() - box.min();
+  return e.x * e.y + e.y * e.z + e.z * e.x;
+}
+
 } // namespace beyond
 
 #endif // BEYOND_CORE_GEOMETRY_AABB3_HPP
@@ -0,0 +1,284 @@
+#ifndef BEYOND_CORE_GEOMETRY_BVH_HPP
+#define BEYOND_CORE_GEOMETRY_BVH_HPP
+
+/**
+ * @file bvh.hpp
+ * @brief Provides the BVH class, a bounding volume hierarchy of AABB3
+ * @ingroup geometry
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "../types/optional.hpp"
+#include "../utils/assert.hpp"
+#include "aabb3.hpp"
+#include "ray.hpp"
+
+namespace beyond {
+
+class ThreadPool;
+
+namespace detail {
+
+/**
+ * @brief Gets the distance where a ray enters a box, or infinity if the ray
+ * misses the box in [t_min, t_max]
+ *
+ * The result is at most `t_max` when the ray hits the box.
+ *
+ * Boxes with zero thickness still count as being hit.
+ */
+[[nodiscard]] constexpr auto ray_box_entry(const AABB3& box,
+                                           const Point3& origin,
+                                           const Vec3& inv_direction,
+                                           float t_min, float t_max) noexcept
+    -> float
+{
+  const float tx0 = (box.min().x - origin.x) * inv_direction.x;
+  const float tx1 = (box.max().x - origin.x) * inv_direction.x;
+  const float ty0 = (box.min().y - origin.y) * inv_direction.y;
+  const float ty1 = (box.max().y - origin.y) * inv_direction.y;
+  const float tz0 = (box.min().z - origin.z) * inv_direction.z;
+  const float tz1 = (box.max().z - origin.z) * inv_direction.z;
+
+  const float entry = std::max({t_min, std::min(tx0, tx1), std::min(ty0, ty1),
+                                std::min(tz0, tz1)});
+  const float exit = std::min({t_max, std::max(tx0, tx1), std::max(ty0, ty1),
+                               std::max(tz0, tz1)});
+  return entry <= exit ? entry : std::numeric_limits<float>::infinity();
+}
+
+} // namespace detail
+
+/**
+ * @addtogroup core
+ * @{
+ * @addtogroup geometry
+ * @{
+ */
+
+/**
+ * @brief A bounding volume hierarchy over a set of AABB3
+ *
+ * The hierarchy is built with the surface area heuristic over binned
+ * centroids and stored as a flat array of nodes in depth-first order. The left
+ * child of an interior node is always the node right after it, so only the
+ * index of the right child is stored.
+ *
+ * The BVH only refers to primitives by their index in the span of boxes it was
+ * built from, so it can accelerate queries on any kind of primitives.
+ */
+class BVH {
+public:
+  struct Node {
+    AABB3 bounds;
+    /// The index of the right child of an interior node, or the index of the
+    /// first primitive of a leaf in `primitive_indices()`
+    std::uint32_t offset = 0;
+    /// The number of primitives of a leaf, which is 0 for interior nodes
+    std::uint32_t primitive_count = 0;
+
+    [[nodiscard]] constexpr auto is_leaf() const noexcept -> bool
+    {
+      return primitive_count != 0;
+    }
+  };
+
+  struct Hit {
+    /// The index of the primitive in the span of boxes the BVH was built from
+    std::uint32_t primitive = 0;
+    float t = 0;
+  };
+
+  /// @brief The maximum depth of a BVH, which also bounds the traversal stack
+  static constexpr std::size_t max_depth = 64;
+
+  struct linear_tag_t {
+  };
+  /// @brief Selects the constructors that build a linear BVH
+  static constexpr linear_tag_t linear_tag{};
+
+  /// @brief Creates an empty BVH
+  BVH() = default;
+
+  /**
+   * @brief Builds a BVH over the bounding boxes of primitives
+   * @param max_leaf_size The maximum number of primitives in a leaf
+   * @pre `max_leaf_size > 0` and there are fewer than 2^32 boxes
+   */
+  explicit BVH(std::span<const AABB3> boxes, std::size_t max_leaf_size = 4);
+
+  /**
+   * @brief Builds a BVH over the bounding boxes of primitives with the worker
+   * threads of `pool`
+   *
+   * The result is the same as the one of the sequential constructor, no matter
+   * how many threads the pool has. Large nodes near the root are split with
+   * data parallel passes over their primitives, and the subtrees below them
+   * are built as independent tasks.
+   *
+   * @warning Blocks until the build finishes, so it must not be called from a
+   * worker thread of `pool`
+   * @pre `max_leaf_size > 0` and there are fewer than 2^32 boxes
+   */
+  BVH(std::span<const AABB3> boxes, ThreadPool& pool,
+      std::size_t max_leaf_size = 4);
+
+  /**
+   * @brief Builds a linear BVH (LBVH) over the bounding boxes of primitives
+   *
+   * The primitives are radix sorted by the Morton codes of their centroids,
+   * and every node is split where the highest bit that differs between the
+   * codes of its primitives changes. This is about ten times faster than the
+   * SAH build but gives a tree that is somewhat slower to traverse, so it is
+   * meant for primitives that move every frame. Nodes with at most
+   * `max_leaf_size` primitives become leaves.
+   *
+   * @pre `max_leaf_size > 0` and there are fewer than 2^32 boxes
+   */
+  BVH(std::span<const AABB3> boxes, linear_tag_t,
+      std::size_t max_leaf_size = 4);
+
+  /**
+   * @brief Builds a linear BVH over the bounding boxes of primitives with the
+   * worker threads of `pool`
+   *
+   * The Morton codes are computed and sorted in parallel, and the subtrees
+   * below the top of the tree are built as independent tasks. The result is
+   * the same as the one of the sequential constructor.
+   *
+   * @warning Blocks until the build finishes, so it must not be called from a
+   * worker thread of `pool`
+   * @pre `max_leaf_size > 0` and there are fewer than 2^32 boxes
+   */
+  BVH(std::span<const AABB3> boxes, linear_tag_t, ThreadPool& pool,
+      std::size_t max_leaf_size = 4);
+
+  /// @brief Gets the nodes in depth-first order, the root is the first node
+  [[nodiscard]] auto nodes() const noexcept -> std::span<const Node>
+  {
+    return nodes_;
+  }
+
+  /// @brief Gets the primitive indices that the leaves refer to
+  [[nodiscard]] auto primitive_indices() const noexcept
+      -> std::span<const std::uint32_t>
+  {
+    return primitive_indices_;
+  }
+
+  [[nodiscard]] auto empty() const noexcept -> bool
+  {
+    return nodes_.empty();
+  }
+
+  /// @brief Gets the bounds of all primitives
+  /// @pre The BVH is not empty
+  [[nodiscard]] auto bounds() const noexcept -> const AABB3&
+  {
+    BEYOND_ASSERT(!empty());
+    return nodes_.front().bounds;
+  }
+
+  /**
+   * @brief Finds the nearest primitive that the ray hits in [t_min, t_max]
+   *
+   * `intersect_primitive(primitive, t_min, t_max)` tests the primitive with
+   * index `primitive` and returns an `optional<float>` with the hit distance
+   * if the ray hits it in [t_min, t_max]. Nodes are visited front to back and
+   * skipped once they are further than the nearest hit so far.
+   */
+  template <typename IntersectPrimitive>
+  [[nodiscard]] auto intersect(const Ray& ray, float t_min, float t_max,
+                               IntersectPrimitive&& intersect_primitive) const
+      -> optional<Hit>;
+
+  /**
+   * @brief Finds the nearest box that the ray hits in [t_min, t_max]
+   * @pre `boxes` are the boxes the BVH was built from
+   */
+  [[nodiscard]] auto intersect(const Ray& ray, std::span<const AABB3> boxes,
+                               float t_min, float t_max) const
+      -> optional<Hit>;
+
+private:
+  std::vector<Node> nodes_;
+  std::vector<std::uint32_t> primitive_indices_;
+};
+
+static_assert(sizeof(BVH::Node) == 32);
+
+template <typename IntersectPrimitive>
+auto BVH::intersect(const Ray& ray, float t_min, float t_max,
+                    IntersectPrimitive&& intersect_primitive) const
+    -> optional<Hit>
+{
+  if (empty()) { return nullopt; }
+
+  const Point3& origin = ray.origin;
+  const Vec3 inv_direction{1 / ray.direction.x, 1 / ray.direction.y,
+                           1 / ray.direction.z};
+  const auto entry_of = [&](std::uint32_t index) {
+    return detail::ray_box_entry(nodes_[index].bounds, origin, inv_direction,
+                                 t_min, t_max);
+  };
+
+  constexpr float miss = std::numeric_limits<float>::infinity();
+
+  // Nodes to visit later and the distance where the ray enters them
+  std::pair<std::uint32_t, float> stack[max_depth];
+  std::size_t stack_size = 0;
+  if (entry_of(0) == miss) { return nullopt; }
+
+  optional<Hit> result;
+  std::uint32_t index = 0;
+  while (true) {
+    const Node& node = nodes_[index];
+    if (node.is_leaf()) {
+      for (std::uint32_t i = 0; i < node.primitive_count; ++i) {
+        const std::uint32_t primitive = primitive_indices_[node.offset + i];
+        const auto t = intersect_primitive(primitive, t_min, t_max);
+        if (t) {
+          t_max = *t;
+          result = Hit{primitive, *t};
+        }
+      }
+    } else {
+      std::uint32_t near_child = index + 1;
+      std::uint32_t far_child = node.offset;
+      float near_entry = entry_of(near_child);
+      float far_entry = entry_of(far_child);
+      if (far_entry < near_entry) {
+        std::swap(near_child, far_child);
+        std::swap(near_entry, far_entry);
+      }
+      if (near_entry != miss) {
+        if (far_entry != miss) {
+          BEYOND_ASSERT(stack_size < max_depth);
+          stack[stack_size++] = {far_child, far_entry};
+        }
+        index = near_child;
+        continue;
+      }
+    }
+
+    // Pops the next node that may still contain a nearer hit
+    do {
+      if (stack_size == 0) { return result; }
+      --stack_size;
+    } while (stack[stack_size].second > t_max);
+    index = stack[stack_size].first;
+  }
+}
+
+/** @}
+ *  @} */
+
+} // namespace beyond
+
+#endif // BEYOND_CORE_GEOMETRY_BVH_HPP
@@ -0,0 +1,98 @@
+#ifndef BEYOND_CORE_GEOMETRY_DETAIL_BVH_BUILD_HPP
+#define BEYOND_CORE_GEOMETRY_DETAIL_BVH_BUILD_HPP
+
+/**
+ * @file bvh_build.hpp
+ * @brief The parts of the parallel BVH builders that do not depend on how the
+ * nodes are split
+ *
+ * A parallel builder splits the top of the tree on the calling thread until
+ * the nodes are small enough, builds the subtrees below them as independent
+ * tasks, then stitches everything together in depth-first order.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "../../concurrency/thread_pool.hpp"
+#include "../aabb3.hpp"
+#include "../bvh.hpp"
+
+namespace beyond::detail {
+
+// A node above the subtrees of a parallel builder. The top of the tree is laid
+// out left child first, the same as the final tree
+struct BVHTopNode {
+  static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+  AABB3 bounds;
+  std::size_t right = none;
+  // The index of the subtree if this node is the root of a subtree
+  std::size_t subtree = none;
+  // The index of the node in the final node array
+  std::size_t position = 0;
+};
+
+// A subtree over the primitives in [begin, end), whose child indices are
+// relative to the start of `nodes`
+struct BVHSubtree {
+  std::size_t begin = 0;
+  std::size_t end = 0;
+  std::size_t depth = 0;
+  std::vector<BVH::Node> nodes;
+  std::size_t position = 0;
+};
+
+// Assigns the positions of the top nodes and subtrees in depth-first order
+inline auto place_bvh_subtrees(std::size_t top_index,
+                               std::vector<BVHTopNode>& top_nodes,
+                               std::vector<BVHSubtree>& subtrees,
+                               std::size_t& position) -> void
+{
+  BVHTopNode& top = top_nodes[top_index];
+  top.position = position;
+  if (top.subtree != BVHTopNode::none) {
+    BVHSubtree& subtree = subtrees[top.subtree];
+    subtree.position = position;
+    position += subtree.nodes.size();
+    return;
+  }
+  ++position;
+  place_bvh_subtrees(top_index + 1, top_nodes, subtrees, position);
+  place_bvh_subtrees(top.right, top_nodes, subtrees, position);
+}
+
+// Writes the top nodes and the built subtrees to `nodes` in depth-first order.
+// The bounds of the top nodes must be set
+inline auto stitch_bvh_subtrees(ThreadPool& pool,
+                                std::vector<BVHTopNode>& top_nodes,
+                                std::vector<BVHSubtree>& subtrees,
+                                std::vector<BVH::Node>& nodes) -> void
+{
+  std::size_t node_count = 0;
+  place_bvh_subtrees(0, top_nodes, subtrees, node_count);
+  nodes.resize(node_count);
+  for (const BVHTopNode& top : top_nodes) {
+    if (top.subtree != BVHTopNode::none) { continue; }
+    nodes[top.position] = BVH::Node{
+        top.bounds, static_cast<std::uint32_t>(top_nodes[top.right].position),
+        0};
+  }
+  parallel_for(&pool, subtrees.size(), [&](std::size_t i) {
+    const BVHSubtree& subtree = subtrees[i];
+    const auto base = static_cast<std::uint32_t>(subtree.position);
+    std::ranges::transform(
+        subtree.nodes, nodes.begin() + static_cast<std::ptrdiff_t>(base),
+        [base](BVH::Node node) {
+          if (!node.is_leaf()) { node.offset += base; }
+          return node;
+        });
+  });
+}
+
+} // namespace beyond::detail
+
+#endif // BEYOND_CORE_GEOMETRY_DETAIL_BVH_BUILD_HPP
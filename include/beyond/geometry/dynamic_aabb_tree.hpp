@@ -0,0 +1,291 @@
+#ifndef BEYOND_CORE_GEOMETRY_DYNAMIC_AABB_TREE_HPP
+#define BEYOND_CORE_GEOMETRY_DYNAMIC_AABB_TREE_HPP
+
+/**
+ * @file dynamic_aabb_tree.hpp
+ * @brief Provides the DynamicAABBTree class, a bounding volume hierarchy of
+ * moving objects
+ * @ingroup geometry
+ */
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "../types/optional.hpp"
+#include "../utils/assert.hpp"
+#include "../utils/handle.hpp"
+#include "aabb3.hpp"
+#include "bvh.hpp"
+#include "ray.hpp"
+
+namespace beyond {
+
+/**
+ * @addtogroup core
+ * @{
+ * @addtogroup geometry
+ * @{
+ */
+
+/// @brief Handle to an object in a DynamicAABBTree
+struct AABBProxy : GenerationalHandle<AABBProxy, std::uint32_t, 24> {
+  using GenerationalHandle::GenerationalHandle;
+};
+
+/**
+ * @brief A bounding volume hierarchy that supports inserting, removing, and
+ * moving objects
+ *
+ * Every object is a leaf that stores a "fat" AABB, which is the bounds of the
+ * object enlarged by a margin. Moving an object only updates the tree when its
+ * new bounds escape the fat AABB. Insertion picks the sibling that increases
+ * the surface area of the tree the least, and tree rotations keep the tree
+ * balanced.
+ *
+ * This is the same design as the dynamic trees of Box2D and Bullet, and is
+ * used as a broadphase for objects that move every frame.
+ */
+class DynamicAABBTree {
+public:
+  struct Hit {
+    AABBProxy proxy;
+    float t = 0;
+  };
+
+  /// @brief The maximum height of the tree, which bounds the query stacks
+  static constexpr std::size_t max_height = 64;
+
+  /**
+   * @brief Creates an empty tree
+   * @param margin How much the fat AABBs are larger than the objects on each
+   * side
+   */
+  explicit DynamicAABBTree(float margin = 0.1f) noexcept : margin_{margin} {}
+
+  /**
+   * @brief Inserts an object with bounds `box`
+   * @return A handle to refer to the object later
+   */
+  [[nodiscard]] auto insert(const AABB3& box, std::uint64_t user_data = 0)
+      -> AABBProxy;
+
+  /**
+   * @brief Removes an object
+   * @pre `contains(proxy)`
+   */
+  auto remove(AABBProxy proxy) -> void;
+
+  /**
+   * @brief Updates the bounds of an object to `box`
+   *
+   * The fat AABB of the object is extended in the direction of
+   * `displacement`, the expected movement of the object in the next update,
+   * so that objects which keep moving in the same direction are reinserted
+   * less often.
+   *
+   * @return Whether the fat AABB changed
+   * @pre `contains(proxy)`
+   */
+  auto move(AABBProxy proxy, const AABB3& box, const Vec3& displacement = {})
+      -> bool;
+
+  /// @brief Whether `proxy` refers to an object in the tree
+  [[nodiscard]] auto contains(AABBProxy proxy) const noexcept -> bool
+  {
+    return proxy.index() < nodes_.size() &&
+           nodes_[proxy.index()].is_leaf() &&
+           nodes_[proxy.index()].generation == proxy.generation();
+  }
+
+  /// @brief Gets the fat AABB of an object
+  /// @pre `contains(proxy)`
+  [[nodiscard]] auto fat_bounds(AABBProxy proxy) const noexcept -> const AABB3&
+  {
+    BEYOND_ASSERT(contains(proxy));
+    return nodes_[proxy.index()].bounds;
+  }
+
+  /// @brief Gets the user data of an object
+  /// @pre `contains(proxy)`
+  [[nodiscard]] auto user_data(AABBProxy proxy) const noexcept -> std::uint64_t
+  {
+    BEYOND_ASSERT(contains(proxy));
+    return nodes_[proxy.index()].user_data;
+  }
+
+  /// @brief Gets the number of objects in the tree
+  [[nodiscard]] auto size() const noexcept -> std::size_t
+  {
+    return size_;
+  }
+
+  [[nodiscard]] auto empty() const noexcept -> bool
+  {
+    return size_ == 0;
+  }
+
+  /// @brief Gets the height of the tree, where a single leaf has height 0
+  [[nodiscard]] auto height() const noexcept -> std::size_t
+  {
+    return root_ == null_node
+               ? 0
+               : static_cast<std::size_t>(nodes_[root_].height);
+  }
+
+  /**
+   * @brief Checks the invariants of the tree: links between nodes, heights,
+   * enclosing bounds, and balance
+   */
+  [[nodiscard]] auto is_valid() const -> bool;
+
+  /**
+   * @brief Calls `callback(proxy)` for every object whose fat AABB overlaps
+   * `box`
+   */
+  template <typename Callback>
+  auto query(const AABB3& box, Callback&& callback) const -> void
+  {
+    visit_overlaps(box, [&](std::uint32_t index) {
+      callback(proxy_of(index));
+    });
+  }
+
+  /**
+   * @brief Calls `callback(proxy_a, proxy_b)` once for every pair of objects
+   * whose fat AABBs overlap
+   */
+  template <typename Callback>
+  auto query_pairs(Callback&& callback) const -> void
+  {
+    for (std::uint32_t i = 0; i < nodes_.size(); ++i) {
+      if (!nodes_[i].is_leaf()) { continue; }
+      // Every pair is found from both of its objects, so only reports the pair
+      // from the object with the smaller index
+      visit_overlaps(nodes_[i].bounds, [&](std::uint32_t other) {
+        if (i < other) { callback(proxy_of(i), proxy_of(other)); }
+      });
+    }
+  }
+
+  /**
+   * @brief Finds the nearest object that the ray hits in [t_min, t_max]
+   *
+   * `intersect_proxy(proxy, t_min, t_max)` tests the object and returns an
+   * `optional<float>` with the hit distance if the ray hits it in [t_min,
+   * t_max]. It is only called for objects whose fat AABB the ray hits.
+   */
+  template <typename IntersectProxy>
+  [[nodiscard]] auto intersect(const Ray& ray, float t_min, float t_max,
+                               IntersectProxy&& intersect_proxy) const
+      -> optional<Hit>;
+
+private:
+  static constexpr std::uint32_t null_node =
+      std::numeric_limits<std::uint32_t>::max();
+
+  struct Node {
+    // The fat AABB of a leaf, or the union of the children
+    AABB3 bounds;
+    std::uint64_t user_data = 0;
+    // The next node in the free list for free nodes
+    std::uint32_t parent = null_node;
+    std::uint32_t child1 = null_node;
+    std::uint32_t child2 = null_node;
+    // 0 for leaves and -1 for free nodes
+    std::int32_t height = -1;
+    AABBProxy::Generation generation = 0;
+
+    [[nodiscard]] auto is_leaf() const noexcept -> bool
+    {
+      return height == 0;
+    }
+  };
+
+  std::vector<Node> nodes_;
+  std::uint32_t root_ = null_node;
+  std::uint32_t free_list_ = null_node;
+  std::size_t size_ = 0;
+  float margin_;
+
+  [[nodiscard]] auto proxy_of(std::uint32_t index) const noexcept -> AABBProxy
+  {
+    return AABBProxy{index, nodes_[index].generation};
+  }
+
+  // Calls `f(index)` for every leaf whose bounds overlap `box`
+  template <typename F>
+  auto visit_overlaps(const AABB3& box, F&& f) const -> void
+  {
+    if (root_ == null_node) { return; }
+
+    std::uint32_t stack[max_height + 1];
+    std::size_t stack_size = 0;
+    stack[stack_size++] = root_;
+    while (stack_size != 0) {
+      const Node& node = nodes_[stack[--stack_size]];
+      if (!overlaps(node.bounds, box)) { continue; }
+      if (node.is_leaf()) {
+        f(static_cast<std::uint32_t>(&node - nodes_.data()));
+      } else {
+        BEYOND_ASSERT(stack_size + 2 <= max_height + 1);
+        stack[stack_size++] = node.child1;
+        stack[stack_size++] = node.child2;
+      }
+    }
+  }
+
+  auto allocate_node() -> std::uint32_t;
+  auto free_node(std::uint32_t index) -> void;
+  auto insert_leaf(std::uint32_t leaf) -> void;
+  auto remove_leaf(std::uint32_t leaf) -> void;
+  auto balance(std::uint32_t index) -> std::uint32_t;
+  auto validate(std::uint32_t index) const -> bool;
+};
+
+template <typename IntersectProxy>
+auto DynamicAABBTree::intersect(const Ray& ray, float t_min, float t_max,
+                                IntersectProxy&& intersect_proxy) const
+    -> optional<Hit>
+{
+  if (root_ == null_node) { return nullopt; }
+
+  constexpr float miss = std::numeric_limits<float>::infinity();
+  const Vec3 inv_direction{1 / ray.direction.x, 1 / ray.direction.y,
+                           1 / ray.direction.z};
+
+  std::uint32_t stack[max_height + 1];
+  std::size_t stack_size = 0;
+  stack[stack_size++] = root_;
+
+  optional<Hit> result;
+  while (stack_size != 0) {
+    const std::uint32_t index = stack[--stack_size];
+    const Node& node = nodes_[index];
+    if (detail::ray_box_entry(node.bounds, ray.origin, inv_direction, t_min,
+                              t_max) == miss) {
+      continue;
+    }
+    if (node.is_leaf()) {
+      const AABBProxy proxy = proxy_of(index);
+      const auto t = intersect_proxy(proxy, t_min, t_max);
+      if (t) {
+        t_max = *t;
+        result = Hit{proxy, *t};
+      }
+    } else {
+      BEYOND_ASSERT(stack_size + 2 <= max_height + 1);
+      stack[stack_size++] = node.child1;
+      stack[stack_size++] = node.child2;
+    }
+  }
+  return result;
+}
+
+/** @}
+ *  @} */
+
+} // namespace beyond
+
+#endif // BEYOND_CORE_GEOMETRY_DYNAMIC_AABB_TREE_HPP
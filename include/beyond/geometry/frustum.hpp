@@ -0,0 +1,190 @@
+#ifndef BEYOND_CORE_GEOMETRY_FRUSTUM_HPP
+#define BEYOND_CORE_GEOMETRY_FRUSTUM_HPP
+
+/**
+ * @file frustum.hpp
+ * @brief Provides the Frustum class for view frustum culling
+ * @ingroup geometry
+ */
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+#include "../math/matrix.hpp"
+#include "../utils/assert.hpp"
+#include "aabb3.hpp"
+#include "bvh.hpp"
+#include "sphere.hpp"
+
+namespace beyond {
+
+/**
+ * @addtogroup core
+ * @{
+ * @addtogroup geometry
+ * @{
+ */
+
+/// @brief The depth range of clip space after the projection
+enum class ClipDepth {
+  /// 0 <= z <= w, as produced by `perspective`
+  zero_to_one,
+  /// -w <= z <= w, as produced by `ortho`
+  negative_one_to_one,
+};
+
+/// @brief Where a shape is relative to a volume
+enum class Containment : std::uint8_t { outside, intersecting, inside };
+
+/**
+ * @brief The six planes of a view frustum, for culling objects that are not
+ * visible from a camera
+ *
+ * The tests against boxes and spheres are conservative: a shape can be
+ * reported as visible when it is outside of the frustum but near one of its
+ * edges, as it is only tested against each plane on its own. They never
+ * report a visible shape as outside.
+ */
+class Frustum {
+public:
+  /// @brief A plane whose positive side is inside of the frustum
+  struct Plane {
+    /// The unit normal of the plane, pointing inside of the frustum
+    Vec3 normal;
+    float distance = 0;
+
+    /// @brief Gets the signed distance from the plane to `p`
+    [[nodiscard]] constexpr auto signed_distance(const Point3& p) const noexcept
+        -> float
+    {
+      return normal.x * p.x + normal.y * p.y + normal.z * p.z + distance;
+    }
+  };
+
+  /**
+   * @brief Extracts the planes of the frustum from a view-projection matrix
+   *
+   * A point `p` is inside of the frustum when `view_projection * Vec4{p, 1}`
+   * is inside of the clip volume.
+   */
+  explicit Frustum(const Mat4& view_projection,
+                   ClipDepth depth = ClipDepth::zero_to_one) noexcept;
+
+  /// @brief Gets the planes in the order left, right, bottom, top, near, and
+  /// far
+  [[nodiscard]] auto planes() const noexcept -> std::span<const Plane, 6>
+  {
+    return planes_;
+  }
+
+  /// @brief Whether the point `p` is inside of the frustum
+  [[nodiscard]] auto contains(const Point3& p) const noexcept -> bool
+  {
+    for (const Plane& plane : planes_) {
+      if (plane.signed_distance(p) < 0) { return false; }
+    }
+    return true;
+  }
+
+  /// @brief Whether `box` may be visible
+  [[nodiscard]] auto intersects(const AABB3& box) const noexcept -> bool
+  {
+    return classify(box) != Containment::outside;
+  }
+
+  /// @brief Whether `sphere` may be visible
+  [[nodiscard]] auto intersects(const Sphere& sphere) const noexcept -> bool
+  {
+    for (const Plane& plane : planes_) {
+      if (plane.signed_distance(sphere.center) < -sphere.radius) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// @brief Tells whether `box` is outside, partially inside, or fully inside
+  /// of the frustum
+  [[nodiscard]] auto classify(const AABB3& box) const noexcept -> Containment;
+
+  /**
+   * @brief Tests many boxes at once with SIMD instructions
+   *
+   * Sets `visible[i]` to `intersects(boxes[i])`.
+   * @return The number of visible boxes
+   * @pre `visible.size() >= boxes.size()`
+   */
+  auto intersects(std::span<const AABB3> boxes,
+                  std::span<bool> visible) const noexcept -> std::size_t;
+
+  /**
+   * @brief Tests many spheres at once with SIMD instructions
+   *
+   * Sets `visible[i]` to `intersects(spheres[i])`.
+   * @return The number of visible spheres
+   * @pre `visible.size() >= spheres.size()`
+   */
+  auto intersects(std::span<const Sphere> spheres,
+                  std::span<bool> visible) const noexcept -> std::size_t;
+
+  /**
+   * @brief Calls `callback(primitive)` for every primitive of `bvh` whose box
+   * intersects the frustum
+   *
+   * Subtrees outside of the frustum are skipped, and the primitives of
+   * subtrees fully inside of it are reported without further tests.
+   *
+   * @pre `boxes` are the boxes `bvh` was built from
+   */
+  template <typename Callback>
+  auto cull(const BVH& bvh, std::span<const AABB3> boxes,
+            Callback&& callback) const -> void;
+
+private:
+  std::array<Plane, 6> planes_;
+};
+
+template <typename Callback>
+auto Frustum::cull(const BVH& bvh, std::span<const AABB3> boxes,
+                   Callback&& callback) const -> void
+{
+  if (bvh.empty()) { return; }
+
+  const auto nodes = bvh.nodes();
+  const auto primitive_indices = bvh.primitive_indices();
+
+  // Nodes to visit and whether their parent is fully inside
+  std::pair<std::uint32_t, bool> stack[BVH::max_depth + 1];
+  std::size_t stack_size = 0;
+  stack[stack_size++] = {0, false};
+  while (stack_size != 0) {
+    auto [index, inside] = stack[--stack_size];
+    const BVH::Node& node = nodes[index];
+    if (!inside) {
+      const Containment containment = classify(node.bounds);
+      if (containment == Containment::outside) { continue; }
+      inside = containment == Containment::inside;
+    }
+
+    if (node.is_leaf()) {
+      for (std::uint32_t i = 0; i < node.primitive_count; ++i) {
+        const std::uint32_t primitive = primitive_indices[node.offset + i];
+        BEYOND_ASSERT(primitive < boxes.size());
+        if (inside || intersects(boxes[primitive])) { callback(primitive); }
+      }
+    } else {
+      BEYOND_ASSERT(stack_size + 2 <= BVH::max_depth + 1);
+      stack[stack_size++] = {node.offset, inside};
+      stack[stack_size++] = {index + 1, inside};
+    }
+  }
+}
+
+/** @}
+ *  @} */
+
+} // namespace beyond
+
+#endif // BEYOND_CORE_GEOMETRY_FRUSTUM_HPP
@@ -0,0 +1,158 @@
+#ifndef BEYOND_CORE_GEOMETRY_MORTON_HPP
+#define BEYOND_CORE_GEOMETRY_MORTON_HPP
+
+/**
+ * @file morton.hpp
+ * @brief Provides 3D Morton codes, which order points along a Z-order curve
+ * @ingroup geometry
+ *
+ * The codes are computed with the `pdep` and `pext` instructions of BMI2 when
+ * the target supports them, and with lookup tables otherwise. Define
+ * `BEYOND_CORE_NO_SIMD` to force the tables.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include "../utils/assert.hpp"
+#include "aabb3.hpp"
+
+#if !defined(BEYOND_CORE_NO_SIMD) && defined(__BMI2__)
+#define BEYOND_MORTON_BMI2 1
+#include <immintrin.h>
+#endif
+
+namespace beyond {
+
+namespace detail {
+
+// The bits of the x coordinates in a Morton code
+inline constexpr std::uint32_t morton_x_mask = 0x0924'9249;
+
+// Spreads the 8 bits of a byte to every third bit
+inline constexpr std::array<std::uint32_t, 256> morton_spread_table = [] {
+  std::array<std::uint32_t, 256> table{};
+  for (std::uint32_t i = 0; i < 256; ++i) {
+    for (std::uint32_t bit = 0; bit < 8; ++bit) {
+      table[i] |= (i >> bit & 1u) << (3 * bit);
+    }
+  }
+  return table;
+}();
+
+// Gathers the bits 0, 3, and 6 of a 9 bits chunk of a Morton code
+inline constexpr std::array<std::uint8_t, 512> morton_compact_table = [] {
+  std::array<std::uint8_t, 512> table{};
+  for (std::uint32_t i = 0; i < 512; ++i) {
+    table[i] = static_cast<std::uint8_t>((i & 1u) | (i >> 2 & 2u) |
+                                         (i >> 4 & 4u));
+  }
+  return table;
+}();
+
+[[nodiscard]] constexpr auto morton_spread(std::uint32_t x) noexcept
+    -> std::uint32_t
+{
+  return morton_spread_table[x & 0xFFu] |
+         (morton_spread_table[x >> 8 & 0x3u] << 24);
+}
+
+[[nodiscard]] constexpr auto morton_compact(std::uint32_t code) noexcept
+    -> std::uint32_t
+{
+  std::uint32_t x = 0;
+  for (std::uint32_t chunk = 0; chunk < 4; ++chunk) {
+    x |= std::uint32_t{morton_compact_table[code >> (9 * chunk) & 0x1FFu]}
+         << (3 * chunk);
+  }
+  return x;
+}
+
+} // namespace detail
+
+/**
+ * @addtogroup core
+ * @{
+ * @addtogroup geometry
+ * @{
+ */
+
+/// @brief The number of bits of each coordinate in a Morton code
+inline constexpr std::uint32_t morton_bits_per_axis = 10;
+
+/// @brief The largest coordinate that fits in a Morton code
+inline constexpr std::uint32_t morton_max_coordinate =
+    (1u << morton_bits_per_axis) - 1;
+
+/**
+ * @brief Interleaves the bits of three coordinates into a 30 bits Morton
+ * code
+ *
+ * Bit `i` of `x`, `y`, and `z` goes to the bit `3i`, `3i + 1`, and `3i + 2`
+ * of the code.
+ *
+ * @pre The coordinates are at most `morton_max_coordinate`
+ */
+[[nodiscard]] constexpr auto morton_encode(std::uint32_t x, std::uint32_t y,
+                                           std::uint32_t z) noexcept
+    -> std::uint32_t
+{
+  BEYOND_ASSERT(x <= morton_max_coordinate && y <= morton_max_coordinate &&
+                z <= morton_max_coordinate);
+#ifdef BEYOND_MORTON_BMI2
+  if !consteval {
+    return _pdep_u32(x, detail::morton_x_mask) |
+           _pdep_u32(y, detail::morton_x_mask << 1) |
+           _pdep_u32(z, detail::morton_x_mask << 2);
+  }
+#endif
+  return detail::morton_spread(x) | (detail::morton_spread(y) << 1) |
+         (detail::morton_spread(z) << 2);
+}
+
+/// @brief Gets the coordinates `{x, y, z}` back from a Morton code
+[[nodiscard]] constexpr auto morton_decode(std::uint32_t code) noexcept
+    -> std::array<std::uint32_t, 3>
+{
+#ifdef BEYOND_MORTON_BMI2
+  if !consteval {
+    return {_pext_u32(code, detail::morton_x_mask),
+            _pext_u32(code, detail::morton_x_mask << 1),
+            _pext_u32(code, detail::morton_x_mask << 2)};
+  }
+#endif
+  return {detail::morton_compact(code), detail::morton_compact(code >> 1),
+          detail::morton_compact(code >> 2)};
+}
+
+/**
+ * @brief Gets the Morton code of a point on a 1024 x 1024 x 1024 grid over
+ * `bounds`
+ *
+ * Points outside of `bounds` are clamped to it. Axes along which `bounds` is
+ * flat map to 0.
+ */
+[[nodiscard]] constexpr auto morton_encode(const Point3& p,
+                                           const AABB3& bounds) noexcept
+    -> std::uint32_t
+{
+  constexpr auto cells = static_cast<float>(morton_max_coordinate + 1);
+  const auto quantize = [&](float value, float min, float max) {
+    const float extent = max - min;
+    if (!(extent > 0)) { return std::uint32_t{0}; }
+    const float cell = (value - min) * (cells / extent);
+    return static_cast<std::uint32_t>(
+        std::clamp(cell, 0.f, static_cast<float>(morton_max_coordinate)));
+  };
+  return morton_encode(quantize(p.x, bounds.min().x, bounds.max().x),
+                       quantize(p.y, bounds.min().y, bounds.max().y),
+                       quantize(p.z, bounds.min().z, bounds.max().z));
+}
+
+/** @}
+ *  @} */
+
+} // namespace beyond
+
+#endif // BEYOND_CORE_GEOMETRY_MORTON_HPP
@@ -0,0 +1,248 @@
+#ifndef BEYOND_CORE_GEOMETRY_RAY_PACKET_HPP
+#define BEYOND_CORE_GEOMETRY_RAY_PACKET_HPP
+
+/**
+ * @file ray_packet.hpp
+ * @brief Provides SIMD intersection tests between several rays and an AABB3,
+ * or between a ray and several AABB3
+ * @ingroup geometry
+ */
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+#include "../math/wide_float.hpp"
+#include "../utils/assert.hpp"
+#include "aabb3.hpp"
+#include "ray.hpp"
+
+namespace beyond {
+
+/**
+ * @addtogroup core
+ * @{
+ * @addtogroup geometry
+ * @{
+ */
+
+/**
+ * @brief The result of intersecting `N` ray-box pairs at once
+ *
+ * Lane i of `mask` is set if the i-th pair intersects, and lane i of `t` is the
+ * distance where the ray enters the box, or infinity if it misses.
+ */
+template <std::size_t N> struct WideRayHit {
+  WideMask<N> mask;
+  WideFloat<N> t;
+};
+
+/**
+ * @brief A ray with the reciprocal of its direction, for testing it against
+ * many boxes
+ */
+struct PrecomputedRay {
+  Point3 origin;
+  Vec3 inv_direction;
+
+  PrecomputedRay() = default;
+
+  explicit PrecomputedRay(const Ray& ray) noexcept
+      : origin{ray.origin},
+        inv_direction{1 / ray.direction.x, 1 / ray.direction.y,
+                      1 / ray.direction.z}
+  {
+  }
+};
+
+/**
+ * @brief `N` rays in structure of arrays layout, with the reciprocals of their
+ * directions
+ *
+ * A packet built from fewer than `N` rays has inactive lanes that never hit
+ * anything.
+ */
+template <std::size_t N> class RayPacket {
+public:
+  using Float = WideFloat<N>;
+
+  TPoint3<Float> origin;
+  TVec3<Float> inv_direction;
+  WideMask<N> active;
+
+  RayPacket() = default;
+
+  /**
+   * @brief Builds a packet from up to `N` rays
+   * @pre `rays.size() <= N`
+   */
+  explicit RayPacket(std::span<const Ray> rays) noexcept
+  {
+    BEYOND_ASSERT(rays.size() <= N);
+    // The inactive lanes get a valid ray to keep NaN out of the computations
+    std::array<float, N> ox{}, oy{}, oz{};
+    std::array<float, N> dx, dy, dz, lanes;
+    dx.fill(1);
+    dy.fill(1);
+    dz.fill(1);
+    for (std::size_t i = 0; i < N; ++i) {
+      lanes[i] = static_cast<float>(i);
+      if (i >= rays.size()) { continue; }
+      ox[i] = rays[i].origin.x;
+      oy[i] = rays[i].origin.y;
+      oz[i] = rays[i].origin.z;
+      dx[i] = rays[i].direction.x;
+      dy[i] = rays[i].direction.y;
+      dz[i] = rays[i].direction.z;
+    }
+    origin = {Float::load(ox.data()), Float::load(oy.data()),
+              Float::load(oz.data())};
+    inv_direction = {Float{1} / Float::load(dx.data()),
+                     Float{1} / Float::load(dy.data()),
+                     Float{1} / Float::load(dz.data())};
+    active =
+        Float::load(lanes.data()) < Float{static_cast<float>(rays.size())};
+  }
+
+  /// @brief Gets the number of lanes
+  [[nodiscard]] static constexpr auto size() noexcept -> std::size_t
+  {
+    return N;
+  }
+};
+
+using RayPacket4 = RayPacket<4>;
+using RayPacket8 = RayPacket<8>;
+
+/**
+ * @brief `N` AABB3 in structure of arrays layout, for example the children of a
+ * wide BVH node
+ *
+ * Unused lanes hold an inverted box that no ray hits.
+ */
+template <std::size_t N> struct WideAABB3 {
+  using Float = WideFloat<N>;
+
+  TPoint3<Float> min;
+  TPoint3<Float> max;
+
+  WideAABB3() = default;
+
+  /**
+   * @brief Gathers up to `N` boxes
+   * @pre `boxes.size() <= N`
+   */
+  explicit WideAABB3(std::span<const AABB3> boxes) noexcept
+  {
+    BEYOND_ASSERT(boxes.size() <= N);
+    constexpr float inf = std::numeric_limits<float>::infinity();
+    std::array<float, N> x0, y0, z0, x1, y1, z1;
+    x0.fill(inf);
+    y0.fill(inf);
+    z0.fill(inf);
+    x1.fill(-inf);
+    y1.fill(-inf);
+    z1.fill(-inf);
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+      x0[i] = boxes[i].min().x;
+      y0[i] = boxes[i].min().y;
+      z0[i] = boxes[i].min().z;
+      x1[i] = boxes[i].max().x;
+      y1[i] = boxes[i].max().y;
+      z1[i] = boxes[i].max().z;
+    }
+    min = {Float::load(x0.data()), Float::load(y0.data()),
+           Float::load(z0.data())};
+    max = {Float::load(x1.data()), Float::load(y1.data()),
+           Float::load(z1.data())};
+  }
+};
+
+/**
+ * @brief Intersects every ray of `packet` with `box` in [t_min, t_max]
+ *
+ * The per-lane semantics match testing each ray on its own: a ray that only
+ * touches the box still hits it.
+ *
+ * @related RayPacket
+ */
+template <std::size_t N>
+[[nodiscard]] auto intersect(const RayPacket<N>& packet, const AABB3& box,
+                             std::type_identity_t<WideFloat<N>> t_min,
+                             std::type_identity_t<WideFloat<N>> t_max) noexcept
+    -> WideRayHit<N>
+{
+  using Float = WideFloat<N>;
+  const auto slab = [](float lo, float hi, Float o, Float inv, Float& entry,
+                       Float& exit) {
+    const Float t0 = (Float{lo} - o) * inv;
+    const Float t1 = (Float{hi} - o) * inv;
+    entry = max(entry, min(t0, t1));
+    exit = min(exit, max(t0, t1));
+  };
+
+  Float entry = t_min;
+  Float exit = t_max;
+  slab(box.min().x, box.max().x, packet.origin.x, packet.inv_direction.x,
+       entry, exit);
+  slab(box.min().y, box.max().y, packet.origin.y, packet.inv_direction.y,
+       entry, exit);
+  slab(box.min().z, box.max().z, packet.origin.z, packet.inv_direction.z,
+       entry, exit);
+
+  // Builds the result in place, since GCC copies a WideMask<8> through
+  // general purpose registers
+  constexpr float miss = std::numeric_limits<float>::infinity();
+  WideRayHit<N> hit{(entry <= exit) & packet.active, {}};
+  hit.t = select(hit.mask, entry, Float{miss});
+  return hit;
+}
+
+/**
+ * @brief Intersects `ray` with every box of `boxes` in [t_min, t_max]
+ *
+ * Since all lanes share the ray, the near and far planes of each slab are
+ * picked once from the signs of the direction instead of sorting the two
+ * distances in every lane.
+ *
+ * @related WideAABB3
+ */
+template <std::size_t N>
+[[nodiscard]] auto intersect(const PrecomputedRay& ray,
+                             const WideAABB3<N>& boxes, float t_min,
+                             float t_max) noexcept -> WideRayHit<N>
+{
+  using Float = WideFloat<N>;
+  const auto slab = [](const Float& lo, const Float& hi, float o, float inv,
+                       Float& entry, Float& exit) {
+    const bool negative = std::signbit(inv);
+    const Float o_wide{o};
+    const Float inv_wide{inv};
+    entry = max(entry, ((negative ? hi : lo) - o_wide) * inv_wide);
+    exit = min(exit, ((negative ? lo : hi) - o_wide) * inv_wide);
+  };
+
+  Float entry{t_min};
+  Float exit{t_max};
+  slab(boxes.min.x, boxes.max.x, ray.origin.x, ray.inv_direction.x, entry,
+       exit);
+  slab(boxes.min.y, boxes.max.y, ray.origin.y, ray.inv_direction.y, entry,
+       exit);
+  slab(boxes.min.z, boxes.max.z, ray.origin.z, ray.inv_direction.z, entry,
+       exit);
+
+  constexpr float miss = std::numeric_limits<float>::infinity();
+  WideRayHit<N> hit{entry <= exit, {}};
+  hit.t = select(hit.mask, entry, Float{miss});
+  return hit;
+}
+
+/** @}
+ *  @} */
+
+} // namespace beyond
+
+#endif // BEYOND_CORE_GEOMETRY_RAY_PACKET_HPP
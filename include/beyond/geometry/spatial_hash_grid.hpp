@@ -0,0 +1,225 @@
+#ifndef BEYOND_CORE_GEOMETRY_SPATIAL_HASH_GRID_HPP
+#define BEYOND_CORE_GEOMETRY_SPATIAL_HASH_GRID_HPP
+
+/**
+ * @file spatial_hash_grid.hpp
+ * @brief Provides the SpatialHashGrid class for neighbor queries over points
+ * @ingroup geometry
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "../math/point.hpp"
+#include "../utils/assert.hpp"
+
+namespace beyond {
+
+class ThreadPool;
+
+/**
+ * @addtogroup core
+ * @{
+ * @addtogroup geometry
+ * @{
+ */
+
+/**
+ * @brief A uniform grid over points whose cells are stored in a hash table,
+ * for radius queries over large sets of moving points
+ *
+ * The grid is meant to be rebuilt from scratch whenever the points move. A
+ * rebuild is a counting sort of the points by hash bucket, so the points of a
+ * cell end up next to each other in memory and a query reads a few contiguous
+ * ranges. The arrays are kept between rebuilds to avoid allocations.
+ *
+ * Different cells can share a bucket. Queries check the cell of every point
+ * they find, so collisions only cost time.
+ *
+ * Radius queries are the fastest when the cells are about twice as large as
+ * the query radius, so that a query visits 2 x 2 x 2 cells.
+ */
+class SpatialHashGrid {
+public:
+  /**
+   * @brief Creates an empty grid
+   * @pre `cell_size > 0`
+   */
+  explicit SpatialHashGrid(float cell_size) noexcept
+      : cell_size_{cell_size}, inv_cell_size_{1 / cell_size}
+  {
+    BEYOND_ASSERT(cell_size > 0);
+  }
+
+  /**
+   * @brief Replaces the points of the grid
+   * @pre There are fewer than 2^31 points
+   */
+  auto rebuild(std::span<const Point3> points) -> void;
+
+  /**
+   * @brief Replaces the points of the grid with the worker threads of `pool`
+   *
+   * The points are sorted by bucket with the parallel `radix_sort_by_key`,
+   * whose per-thread histograms have a fixed size. The sort is stable, so the
+   * result is the same as the one of the sequential rebuild.
+   *
+   * @warning Blocks until the rebuild finishes, so it must not be called from
+   * a worker thread of `pool`
+   * @pre There are fewer than 2^31 points
+   */
+  auto rebuild(std::span<const Point3> points, ThreadPool& pool) -> void;
+
+  [[nodiscard]] auto cell_size() const noexcept -> float
+  {
+    return cell_size_;
+  }
+
+  /// @brief Gets the number of points in the grid
+  [[nodiscard]] auto size() const noexcept -> std::size_t
+  {
+    return sorted_points_.size();
+  }
+
+  [[nodiscard]] auto empty() const noexcept -> bool
+  {
+    return sorted_points_.empty();
+  }
+
+  /// @brief Gets the points ordered by hash bucket
+  [[nodiscard]] auto sorted_points() const noexcept -> std::span<const Point3>
+  {
+    return sorted_points_;
+  }
+
+  /// @brief Gets the index of each point of `sorted_points()` in the span the
+  /// grid was built from
+  [[nodiscard]] auto sorted_indices() const noexcept
+      -> std::span<const std::uint32_t>
+  {
+    return sorted_indices_;
+  }
+
+  /**
+   * @brief Calls `callback(index)` for every point within `radius` of
+   * `center`, where `index` is the index of the point in the span the grid
+   * was built from
+   *
+   * If the radius covers more cells than there are points, the points are
+   * scanned directly instead.
+   */
+  template <typename Callback>
+  auto query_radius(const Point3& center, float radius,
+                    Callback&& callback) const -> void
+  {
+    if (empty() || !(radius >= 0)) { return; }
+
+    const float radius_squared = radius * radius;
+    const auto within_radius = [&](const Point3& p) {
+      const float dx = p.x - center.x;
+      const float dy = p.y - center.y;
+      const float dz = p.z - center.z;
+      return dx * dx + dy * dy + dz * dz <= radius_squared;
+    };
+
+    const Cell min = cell_of(Point3{center.x - radius, center.y - radius,
+                                    center.z - radius});
+    const Cell max = cell_of(Point3{center.x + radius, center.y + radius,
+                                    center.z + radius});
+    const auto extent = [](std::int32_t low, std::int32_t high) {
+      return static_cast<double>(high) - static_cast<double>(low) + 1;
+    };
+    if (extent(min.x, max.x) * extent(min.y, max.y) * extent(min.z, max.z) >
+        static_cast<double>(size())) {
+      for (std::size_t i = 0; i < sorted_points_.size(); ++i) {
+        if (within_radius(sorted_points_[i])) { callback(sorted_indices_[i]); }
+      }
+      return;
+    }
+
+    for (std::int32_t z = min.z; z <= max.z; ++z) {
+      for (std::int32_t y = min.y; y <= max.y; ++y) {
+        for (std::int32_t x = min.x; x <= max.x; ++x) {
+          const Cell cell{x, y, z};
+          const std::uint32_t bucket = bucket_of(cell);
+          const std::uint32_t end = bucket_start_[bucket + 1];
+          for (std::uint32_t i = bucket_start_[bucket]; i < end; ++i) {
+            const Point3& p = sorted_points_[i];
+            // Points from other cells of the same bucket are reported when
+            // visiting their own cell
+            if (within_radius(p) && cell_of(p) == cell) {
+              callback(sorted_indices_[i]);
+            }
+          }
+        }
+      }
+    }
+  }
+
+private:
+  struct Cell {
+    std::int32_t x;
+    std::int32_t y;
+    std::int32_t z;
+
+    [[nodiscard]] friend auto operator==(const Cell&, const Cell&)
+        -> bool = default;
+  };
+
+  float cell_size_;
+  float inv_cell_size_;
+  // The number of buckets minus one, the number of buckets is a power of two
+  std::uint32_t bucket_mask_ = 0;
+  // The points of bucket b are in [bucket_start_[b], bucket_start_[b + 1])
+  std::vector<std::uint32_t> bucket_start_;
+  std::vector<Point3> sorted_points_;
+  std::vector<std::uint32_t> sorted_indices_;
+
+  // Scratch buffers of the rebuilds
+  std::vector<std::uint32_t> point_buckets_;
+  std::vector<std::uint32_t> bucket_offsets_;
+  std::vector<std::uint32_t> bucket_scratch_;
+  std::vector<std::uint32_t> index_scratch_;
+
+  // Cell coordinates are clamped to [-max_cell, max_cell], so that they can be
+  // converted to and iterated over as 32-bit integers. Points farther away
+  // share the cells at the boundary
+  static constexpr float max_cell = 1 << 30;
+
+  [[nodiscard]] auto cell_coordinate(float x) const noexcept -> std::int32_t
+  {
+    // NaNs end up in the lowest cell
+    return static_cast<std::int32_t>(std::fmin(
+        std::fmax(std::floor(x * inv_cell_size_), -max_cell), max_cell));
+  }
+
+  [[nodiscard]] auto cell_of(const Point3& p) const noexcept -> Cell
+  {
+    return {cell_coordinate(p.x), cell_coordinate(p.y), cell_coordinate(p.z)};
+  }
+
+  // Teschner et al., "Optimized Spatial Hashing for Collision Detection of
+  // Deformable Objects"
+  [[nodiscard]] auto bucket_of(const Cell& cell) const noexcept
+      -> std::uint32_t
+  {
+    const auto x = static_cast<std::uint32_t>(cell.x);
+    const auto y = static_cast<std::uint32_t>(cell.y);
+    const auto z = static_cast<std::uint32_t>(cell.z);
+    const std::uint32_t hash =
+        (x * 73856093u) ^ (y * 19349663u) ^ (z * 83492791u);
+    return hash & bucket_mask_;
+  }
+
+  // Sizes the arrays for `point_count` points and returns the number of buckets
+  auto resize(std::size_t point_count) -> std::size_t;
+};
+
+/** @}
+ *  @} */
+
+} // namespace beyond
+
+#endif // BEYOND_CORE_GEOMETRY_SPATIAL_HASH_GRID_HPP
@@ -0,0 +1,26 @@
+#ifndef BEYOND_CORE_GEOMETRY_SPHERE_HPP
+#define BEYOND_CORE_GEOMETRY_SPHERE_HPP
+
+#include "../math/point.hpp"
+
+namespace beyond {
+
+/**
+ * @addtogroup core
+ * @{
+ * @addtogroup geometry
+ * @{
+ */
+
+/// @brief A sphere, for example the bounding sphere of an object
+struct Sphere {
+  Point3 center = {0, 0, 0};
+  float radius = 0;
+};
+
+/** @}
+ *  @} */
+
+} // namespace beyond
+
+#endif // BEYOND_CORE_GEOMETRY_SPHERE_HPP
@@ -0,0 +1,184 @@
+#ifndef BEYOND_CORE_GEOMETRY_WIDE_BVH_HPP
+#define BEYOND_CORE_GEOMETRY_WIDE_BVH_HPP
+
+/**
+ * @file wide_bvh.hpp
+ * @brief Provides the WideBVH class, a bounding volume hierarchy with 4 or 8
+ * children per node for SIMD traversal
+ * @ingroup geometry
+ */
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "../types/optional.hpp"
+#include "../utils/assert.hpp"
+#include "aabb3.hpp"
+#include "bvh.hpp"
+#include "ray.hpp"
+#include "ray_packet.hpp"
+
+namespace beyond {
+
+/**
+ * @addtogroup core
+ * @{
+ * @addtogroup geometry
+ * @{
+ */
+
+/**
+ * @brief A bounding volume hierarchy whose nodes have up to `N` children
+ *
+ * A WideBVH is collapsed from a binary BVH by pulling the grandchildren of
+ * each node up into it until it has `N` children, expanding the child with the
+ * largest surface area first. The bounds of the children of a node are stored
+ * in structure of arrays layout, so a ray is tested against all of them with
+ * a single SIMD slab test.
+ *
+ * A WideBVH refers to primitives by their index in the span of boxes the
+ * binary BVH was built from, in the same way as BVH.
+ */
+template <std::size_t N> class WideBVH {
+public:
+  using Hit = BVH::Hit;
+
+  struct Node {
+    /// The bounds of the children. Unused lanes hold an inverted box that no
+    /// ray hits
+    WideAABB3<N> bounds;
+    /// The index of each interior child, or the index of the first primitive
+    /// of each leaf child in `primitive_indices()`
+    std::array<std::uint32_t, N> offset{};
+    /// The number of primitives of each leaf child, which is 0 for interior
+    /// children and unused lanes
+    std::array<std::uint32_t, N> primitive_count{};
+  };
+
+  /// @brief Creates an empty WideBVH
+  WideBVH() = default;
+
+  /// @brief Collapses a binary BVH
+  explicit WideBVH(const BVH& bvh);
+
+  /// @brief Gets the nodes, the root is the first node
+  [[nodiscard]] auto nodes() const noexcept -> std::span<const Node>
+  {
+    return nodes_;
+  }
+
+  /// @brief Gets the primitive indices that the leaves refer to
+  [[nodiscard]] auto primitive_indices() const noexcept
+      -> std::span<const std::uint32_t>
+  {
+    return primitive_indices_;
+  }
+
+  [[nodiscard]] auto empty() const noexcept -> bool
+  {
+    return nodes_.empty();
+  }
+
+  /**
+   * @brief Finds the nearest primitive that the ray hits in [t_min, t_max]
+   *
+   * `intersect_primitive` works the same way as in BVH::intersect.
+   */
+  template <typename IntersectPrimitive>
+  [[nodiscard]] auto intersect(const Ray& ray, float t_min, float t_max,
+                               IntersectPrimitive&& intersect_primitive) const
+      -> optional<Hit>;
+
+  /**
+   * @brief Finds the nearest box that the ray hits in [t_min, t_max]
+   * @pre `boxes` are the boxes the BVH was built from
+   */
+  [[nodiscard]] auto intersect(const Ray& ray, std::span<const AABB3> boxes,
+                               float t_min, float t_max) const
+      -> optional<Hit>;
+
+private:
+  // Every level of the tree pushes at most N - 1 children
+  static constexpr std::size_t stack_capacity = BVH::max_depth * (N - 1) + 1;
+
+  std::vector<Node> nodes_;
+  std::vector<std::uint32_t> primitive_indices_;
+
+  auto collapse(std::span<const BVH::Node> binary_nodes,
+                std::uint32_t binary_index, std::uint32_t index) -> void;
+};
+
+using BVH4 = WideBVH<4>;
+using BVH8 = WideBVH<8>;
+
+extern template class WideBVH<4>;
+extern template class WideBVH<8>;
+
+template <std::size_t N>
+template <typename IntersectPrimitive>
+auto WideBVH<N>::intersect(const Ray& ray, float t_min, float t_max,
+                           IntersectPrimitive&& intersect_primitive) const
+    -> optional<Hit>
+{
+  if (empty()) { return nullopt; }
+
+  const PrecomputedRay precomputed{ray};
+
+  // Nodes to visit later and the distance where the ray enters them
+  std::pair<std::uint32_t, float> stack[stack_capacity];
+  std::size_t stack_size = 0;
+
+  optional<Hit> result;
+  std::uint32_t index = 0;
+  while (true) {
+    const Node& node = nodes_[index];
+    const WideRayHit<N> hit =
+        beyond::intersect(precomputed, node.bounds, t_min, t_max);
+    float entries[N];
+    hit.t.store(entries);
+
+    const std::size_t stack_begin = stack_size;
+    for (unsigned mask = hit.mask.bits(); mask != 0; mask &= mask - 1) {
+      const auto lane = static_cast<std::size_t>(std::countr_zero(mask));
+      const std::uint32_t offset = node.offset[lane];
+      const std::uint32_t primitive_count = node.primitive_count[lane];
+      if (primitive_count == 0) {
+        // Keeps the new entries sorted so that the nearest child is on top
+        BEYOND_ASSERT(stack_size < stack_capacity);
+        std::size_t i = stack_size++;
+        for (; i > stack_begin && stack[i - 1].second < entries[lane]; --i) {
+          stack[i] = stack[i - 1];
+        }
+        stack[i] = {offset, entries[lane]};
+      } else if (entries[lane] <= t_max) {
+        for (std::uint32_t i = 0; i < primitive_count; ++i) {
+          const std::uint32_t primitive = primitive_indices_[offset + i];
+          const auto t = intersect_primitive(primitive, t_min, t_max);
+          if (t) {
+            t_max = *t;
+            result = Hit{primitive, *t};
+          }
+        }
+      }
+    }
+
+    // Pops the next node that may still contain a nearer hit
+    do {
+      if (stack_size == 0) { return result; }
+      --stack_size;
+    } while (stack[stack_size].second > t_max);
+    index = stack[stack_size].first;
+  }
+}
+
+/** @}
+ *  @} */
+
+} // namespace beyond
+
+#endif // BEYOND_CORE_GEOMETRY_WIDE_BVH_HPP
@@ -0,0 +1,96 @@
+#pragma once
+
+#ifndef BEYOND_CORE_MATH_BATCH_TRANSFORM_HPP
+#define BEYOND_CORE_MATH_BATCH_TRANSFORM_HPP
+
+/**
+ * @file batch_transform.hpp
+ * @brief Transforms arrays of points and vectors by a single matrix
+ * @ingroup math
+ */
+
+#include <cstddef>
+#include <span>
+
+#include "matrix.hpp"
+#include "point.hpp"
+#include "vector.hpp"
+
+namespace beyond {
+
+/**
+ * @addtogroup core
+ * @{
+ * @addtogroup math
+ * @{
+ */
+
+/**
+ * @brief A view of 3d points or vectors stored as structure of arrays
+ *
+ * Component `x` of the i-th element is `x[i]`, and so on.
+ * @pre All three spans shall have the same size
+ */
+template <typename T> struct SoASpan3 {
+  std::span<T> x;
+  std::span<T> y;
+  std::span<T> z;
+
+  [[nodiscard]] constexpr auto size() const noexcept -> std::size_t
+  {
+    return x.size();
+  }
+
+  // Allows to pass a mutable view where a read-only view is expected
+  constexpr operator SoASpan3<const T>() const noexcept
+  {
+    return {x, y, z};
+  }
+};
+
+/**
+ * @brief Transforms `points` by `m`, and writes the results to `out`
+ *
+ * Equivalent to `out[i] = (m * Vec4{points[i], 1}).xyz` for every point. The
+ * bottom row of `m` is ignored, so the result is only correct for affine
+ * transformations. Processes four points at a time with SIMD instructions when
+ * available.
+ *
+ * @pre `out.size() >= points.size()`. `out` may be the same range as `points`,
+ * but shall not partially overlap it
+ */
+auto transform_points(const Mat4& m, std::span<const Point3> points,
+                      std::span<Point3> out) noexcept -> void;
+
+/**
+ * @brief Transforms `vectors` by `m`, and writes the results to `out`
+ *
+ * Equivalent to `out[i] = (m * Vec4{vectors[i], 0}).xyz` for every vector,
+ * which means the translation of `m` does not apply.
+ * @see transform_points
+ */
+auto transform_vectors(const Mat4& m, std::span<const Vec3> vectors,
+                       std::span<Vec3> out) noexcept -> void;
+
+/**
+ * @brief Transforms points stored as structure of arrays
+ *
+ * Processes eight points at a time with AVX, or four with SSE.
+ * @overload
+ */
+auto transform_points(const Mat4& m, SoASpan3<const float> points,
+                      SoASpan3<float> out) noexcept -> void;
+
+/**
+ * @brief Transforms vectors stored as structure of arrays
+ * @overload
+ */
+auto transform_vectors(const Mat4& m, SoASpan3<const float> vectors,
+                       SoASpan3<float> out) noexcept -> void;
+
+/** @}
+ *  @} */
+
+} // namespace beyond
+
+#endif // BEYOND_CORE_MATH_BATCH_TRANSFORM_HPP
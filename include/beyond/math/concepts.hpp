@@ -2,12 +2,25 @@
 #define BEYOND_CORE_MATH_CONCEPTS_HPP
 
 #include <concepts>
+#include <type_traits>
 
 namespace beyond {
 
 template <class T>
 concept Arithmetic = std::integral<T> || std::floating_point<T>;
 
+/**
+ * @brief Whether T behaves like a floating point number in arithmetic
+ *
+ * Besides the built-in floating point types, this is specialized for SIMD
+ * scalar types such as WideFloat.
+ */
+template <class T> struct IsFloatingPointLike : std::is_floating_point<T> {
+};
+
+template <class T>
+concept FloatingPointLike = IsFloatingPointLike<T>::value;
+
 } // namespace beyond
 
 #endif // BEYOND_CORE_MATH_CONCEPTS_HPP
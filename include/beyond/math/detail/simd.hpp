@@ -0,0 +1,303 @@
+#ifndef BEYOND_CORE_MATH_DETAIL_SIMD_HPP
+#define BEYOND_CORE_MATH_DETAIL_SIMD_HPP
+
+/**
+ * @file simd.hpp
+ * @brief SIMD kernels that back the float specializations of the math library
+ *
+ * `BEYOND_SIMD_SSE` is defined when SSE2 is available, and `BEYOND_SIMD_AVX`
+ * when the target also supports AVX. Define `BEYOND_CORE_NO_SIMD` to force the
+ * scalar fallbacks.
+ *
+ * All the kernels work on unaligned, column-major float arrays.
+ */
+
+#if !defined(BEYOND_CORE_NO_SIMD) &&                                           \
+    (defined(__SSE2__) || defined(_M_X64) ||                                   \
+     (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define BEYOND_SIMD_SSE 1
+#if defined(__AVX__)
+#define BEYOND_SIMD_AVX 1
+#endif
+#if defined(__FMA__)
+#define BEYOND_SIMD_FMA 1
+#endif
+#endif
+
+#ifdef BEYOND_SIMD_SSE
+#ifdef BEYOND_SIMD_AVX
+#include <immintrin.h>
+#else
+#include <emmintrin.h>
+#endif
+#endif
+
+namespace beyond::detail::simd {
+
+#ifdef BEYOND_SIMD_SSE
+
+#define BEYOND_SIMD_SHUFFLE(a, b, x, y, z, w)                                  \
+  _mm_shuffle_ps((a), (b), _MM_SHUFFLE((w), (z), (y), (x)))
+#define BEYOND_SIMD_SWIZZLE(v, x, y, z, w) BEYOND_SIMD_SHUFFLE(v, v, x, y, z, w)
+
+// a * b + c
+[[nodiscard]] inline auto madd(__m128 a, __m128 b, __m128 c) noexcept -> __m128
+{
+#ifdef BEYOND_SIMD_FMA
+  return _mm_fmadd_ps(a, b, c);
+#else
+  return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+
+// Sums all four lanes of v into every lane
+[[nodiscard]] inline auto horizontal_sum(__m128 v) noexcept -> __m128
+{
+  v = _mm_add_ps(v, BEYOND_SIMD_SWIZZLE(v, 2, 3, 0, 1));
+  return _mm_add_ps(v, BEYOND_SIMD_SWIZZLE(v, 1, 0, 3, 2));
+}
+
+inline auto add4(float* lhs, const float* rhs) noexcept -> void
+{
+  _mm_storeu_ps(lhs, _mm_add_ps(_mm_loadu_ps(lhs), _mm_loadu_ps(rhs)));
+}
+
+inline auto sub4(float* lhs, const float* rhs) noexcept -> void
+{
+  _mm_storeu_ps(lhs, _mm_sub_ps(_mm_loadu_ps(lhs), _mm_loadu_ps(rhs)));
+}
+
+inline auto scale4(float* v, float s) noexcept -> void
+{
+  _mm_storeu_ps(v, _mm_mul_ps(_mm_loadu_ps(v), _mm_set1_ps(s)));
+}
+
+[[nodiscard]] inline auto dot4(const float* lhs, const float* rhs) noexcept
+    -> float
+{
+  return _mm_cvtss_f32(
+      horizontal_sum(_mm_mul_ps(_mm_loadu_ps(lhs), _mm_loadu_ps(rhs))));
+}
+
+// result = m * v
+inline auto mat4_mul_vec4(const float* m, const float* v,
+                          float* result) noexcept -> void
+{
+  const __m128 vv = _mm_loadu_ps(v);
+  __m128 r = _mm_mul_ps(_mm_loadu_ps(m), BEYOND_SIMD_SWIZZLE(vv, 0, 0, 0, 0));
+  r = madd(_mm_loadu_ps(m + 4), BEYOND_SIMD_SWIZZLE(vv, 1, 1, 1, 1), r);
+  r = madd(_mm_loadu_ps(m + 8), BEYOND_SIMD_SWIZZLE(vv, 2, 2, 2, 2), r);
+  r = madd(_mm_loadu_ps(m + 12), BEYOND_SIMD_SWIZZLE(vv, 3, 3, 3, 3), r);
+  _mm_storeu_ps(result, r);
+}
+
+// result = lhs * rhs
+// result may not alias lhs or rhs
+inline auto mat4_mul(const float* lhs, const float* rhs, float* result) noexcept
+    -> void
+{
+#ifdef BEYOND_SIMD_AVX
+  // Computes two columns of the result at once. Each 128-bit half of an AVX
+  // register holds one column
+  const __m256 c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs));
+  const __m256 c1 =
+      _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs + 4));
+  const __m256 c2 =
+      _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs + 8));
+  const __m256 c3 =
+      _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs + 12));
+  for (int j = 0; j < 16; j += 8) {
+    const __m256 b = _mm256_loadu_ps(rhs + j);
+    __m256 r = _mm256_mul_ps(c0, _mm256_permute_ps(b, 0x00));
+#ifdef BEYOND_SIMD_FMA
+    r = _mm256_fmadd_ps(c1, _mm256_permute_ps(b, 0x55), r);
+    r = _mm256_fmadd_ps(c2, _mm256_permute_ps(b, 0xAA), r);
+    r = _mm256_fmadd_ps(c3, _mm256_permute_ps(b, 0xFF), r);
+#else
+    r = _mm256_add_ps(_mm256_mul_ps(c1, _mm256_permute_ps(b, 0x55)), r);
+    r = _mm256_add_ps(_mm256_mul_ps(c2, _mm256_permute_ps(b, 0xAA)), r);
+    r = _mm256_add_ps(_mm256_mul_ps(c3, _mm256_permute_ps(b, 0xFF)), r);
+#endif
+    _mm256_storeu_ps(result + j, r);
+  }
+#else
+  for (int j = 0; j < 16; j += 4) {
+    mat4_mul_vec4(lhs, rhs + j, result + j);
+  }
+#endif
+}
+
+inline auto mat4_transpose(const float* m, float* result) noexcept -> void
+{
+  __m128 c0 = _mm_loadu_ps(m);
+  __m128 c1 = _mm_loadu_ps(m + 4);
+  __m128 c2 = _mm_loadu_ps(m + 8);
+  __m128 c3 = _mm_loadu_ps(m + 12);
+  _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+  _mm_storeu_ps(result, c0);
+  _mm_storeu_ps(result + 4, c1);
+  _mm_storeu_ps(result + 8, c2);
+  _mm_storeu_ps(result + 12, c3);
+}
+
+// The inverse below works on 2x2 sub-matrices packed into one register as
+// (m00, m01, m10, m11)
+
+// a * b
+[[nodiscard]] inline auto mat2_mul(__m128 a, __m128 b) noexcept -> __m128
+{
+  return _mm_add_ps(_mm_mul_ps(a, BEYOND_SIMD_SWIZZLE(b, 0, 3, 0, 3)),
+                    _mm_mul_ps(BEYOND_SIMD_SWIZZLE(a, 1, 0, 3, 2),
+                               BEYOND_SIMD_SWIZZLE(b, 2, 1, 2, 1)));
+}
+
+// adjugate(a) * b
+[[nodiscard]] inline auto mat2_adj_mul(__m128 a, __m128 b) noexcept -> __m128
+{
+  return _mm_sub_ps(_mm_mul_ps(BEYOND_SIMD_SWIZZLE(a, 3, 3, 0, 0), b),
+                    _mm_mul_ps(BEYOND_SIMD_SWIZZLE(a, 1, 1, 2, 2),
+                               BEYOND_SIMD_SWIZZLE(b, 2, 3, 0, 1)));
+}
+
+// a * adjugate(b)
+[[nodiscard]] inline auto mat2_mul_adj(__m128 a, __m128 b) noexcept -> __m128
+{
+  return _mm_sub_ps(_mm_mul_ps(a, BEYOND_SIMD_SWIZZLE(b, 3, 0, 3, 0)),
+                    _mm_mul_ps(BEYOND_SIMD_SWIZZLE(a, 1, 0, 3, 2),
+                               BEYOND_SIMD_SWIZZLE(b, 2, 1, 2, 1)));
+}
+
+// General 4x4 inverse by block-wise inversion of the 2x2 sub-matrices
+//
+// The kernel is written for row-major matrices. Since
+// inverse(transpose(M)) = transpose(inverse(M)), feeding it columns instead of
+// rows gives the inverse in column-major order.
+inline auto mat4_inverse(const float* m, float* result) noexcept -> void
+{
+  const __m128 r0 = _mm_loadu_ps(m);
+  const __m128 r1 = _mm_loadu_ps(m + 4);
+  const __m128 r2 = _mm_loadu_ps(m + 8);
+  const __m128 r3 = _mm_loadu_ps(m + 12);
+
+  // M = | A B |
+  //     | C D |
+  const __m128 a = _mm_movelh_ps(r0, r1);
+  const __m128 b = _mm_movehl_ps(r1, r0);
+  const __m128 c = _mm_movelh_ps(r2, r3);
+  const __m128 d = _mm_movehl_ps(r3, r2);
+
+  // (|A|, |B|, |C|, |D|)
+  const __m128 det_sub =
+      _mm_sub_ps(_mm_mul_ps(BEYOND_SIMD_SHUFFLE(r0, r2, 0, 2, 0, 2),
+                            BEYOND_SIMD_SHUFFLE(r1, r3, 1, 3, 1, 3)),
+                 _mm_mul_ps(BEYOND_SIMD_SHUFFLE(r0, r2, 1, 3, 1, 3),
+                            BEYOND_SIMD_SHUFFLE(r1, r3, 0, 2, 0, 2)));
+  const __m128 det_a = BEYOND_SIMD_SWIZZLE(det_sub, 0, 0, 0, 0);
+  const __m128 det_b = BEYOND_SIMD_SWIZZLE(det_sub, 1, 1, 1, 1);
+  const __m128 det_c = BEYOND_SIMD_SWIZZLE(det_sub, 2, 2, 2, 2);
+  const __m128 det_d = BEYOND_SIMD_SWIZZLE(det_sub, 3, 3, 3, 3);
+
+  const __m128 d_c = mat2_adj_mul(d, c);
+  const __m128 a_b = mat2_adj_mul(a, b);
+
+  // inverse(M) = 1/|M| * | X Y |
+  //                      | Z W |
+  // where the following are the adjugates of X, Y, Z, W
+  __m128 x = _mm_sub_ps(_mm_mul_ps(det_d, a), mat2_mul(b, d_c));
+  __m128 w = _mm_sub_ps(_mm_mul_ps(det_a, d), mat2_mul(c, a_b));
+  __m128 y = _mm_sub_ps(_mm_mul_ps(det_b, c), mat2_mul_adj(d, a_b));
+  __m128 z = _mm_sub_ps(_mm_mul_ps(det_c, b), mat2_mul_adj(a, d_c));
+
+  // |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+  const __m128 trace = horizontal_sum(
+      _mm_mul_ps(a_b, BEYOND_SIMD_SWIZZLE(d_c, 0, 2, 1, 3)));
+  const __m128 det_m = _mm_sub_ps(
+      _mm_add_ps(_mm_mul_ps(det_a, det_d), _mm_mul_ps(det_b, det_c)), trace);
+
+  const __m128 rcp_det =
+      _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), det_m);
+  x = _mm_mul_ps(x, rcp_det);
+  y = _mm_mul_ps(y, rcp_det);
+  z = _mm_mul_ps(z, rcp_det);
+  w = _mm_mul_ps(w, rcp_det);
+
+  // Undo the adjugates and scatter the blocks back into rows
+  _mm_storeu_ps(result, BEYOND_SIMD_SHUFFLE(x, y, 3, 1, 3, 1));
+  _mm_storeu_ps(result + 4, BEYOND_SIMD_SHUFFLE(x, y, 2, 0, 2, 0));
+  _mm_storeu_ps(result + 8, BEYOND_SIMD_SHUFFLE(z, w, 3, 1, 3, 1));
+  _mm_storeu_ps(result + 12, BEYOND_SIMD_SHUFFLE(z, w, 2, 0, 2, 0));
+}
+
+// Cross product of the xyz components. The w component of the result is 0
+[[nodiscard]] inline auto cross3(__m128 a, __m128 b) noexcept -> __m128
+{
+  const __m128 a_yzx = BEYOND_SIMD_SWIZZLE(a, 1, 2, 0, 3);
+  const __m128 b_yzx = BEYOND_SIMD_SWIZZLE(b, 1, 2, 0, 3);
+  const __m128 c = _mm_sub_ps(_mm_mul_ps(a, b_yzx), _mm_mul_ps(a_yzx, b));
+  return BEYOND_SIMD_SWIZZLE(c, 1, 2, 0, 3);
+}
+
+// Loads the upper 3x4 part of an affine matrix as columns whose w is 0
+inline auto load_affine_columns(const float* m, __m128& c0, __m128& c1,
+                                __m128& c2, __m128& t) noexcept -> void
+{
+  const __m128 xyz_mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+  c0 = _mm_and_ps(_mm_loadu_ps(m), xyz_mask);
+  c1 = _mm_and_ps(_mm_loadu_ps(m + 4), xyz_mask);
+  c2 = _mm_and_ps(_mm_loadu_ps(m + 8), xyz_mask);
+  t = _mm_and_ps(_mm_loadu_ps(m + 12), xyz_mask);
+}
+
+// Given the rows r of the inverse of the upper 3x3 part A of an affine matrix,
+// whose w are 0, and its translation t, stores
+// | inverse(A)  -inverse(A) * t |
+// |     0              1        |
+inline auto store_affine_inverse(__m128 r0, __m128 r1, __m128 r2, __m128 t,
+                                 float* result) noexcept -> void
+{
+  __m128 r3 = _mm_setzero_ps();
+  _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+  __m128 inv_t = _mm_mul_ps(r0, BEYOND_SIMD_SWIZZLE(t, 0, 0, 0, 0));
+  inv_t = madd(r1, BEYOND_SIMD_SWIZZLE(t, 1, 1, 1, 1), inv_t);
+  inv_t = madd(r2, BEYOND_SIMD_SWIZZLE(t, 2, 2, 2, 2), inv_t);
+  inv_t = _mm_sub_ps(_mm_setr_ps(0.f, 0.f, 0.f, 1.f), inv_t);
+
+  _mm_storeu_ps(result, r0);
+  _mm_storeu_ps(result + 4, r1);
+  _mm_storeu_ps(result + 8, r2);
+  _mm_storeu_ps(result + 12, inv_t);
+}
+
+// Inverse of a matrix whose upper 3x3 part is a rotation, so its inverse is
+// its transpose
+inline auto mat4_inverse_rigid(const float* m, float* result) noexcept -> void
+{
+  __m128 c0, c1, c2, t;
+  load_affine_columns(m, c0, c1, c2, t);
+  // The rows of the transpose are the columns
+  store_affine_inverse(c0, c1, c2, t, result);
+}
+
+// Inverse of an affine matrix. The rows of the inverse of the upper 3x3 part
+// are the cross products of its columns divided by the determinant
+inline auto mat4_inverse_affine(const float* m, float* result) noexcept -> void
+{
+  __m128 c0, c1, c2, t;
+  load_affine_columns(m, c0, c1, c2, t);
+
+  const __m128 r0 = cross3(c1, c2);
+  const __m128 r1 = cross3(c2, c0);
+  const __m128 r2 = cross3(c0, c1);
+  const __m128 det = horizontal_sum(_mm_mul_ps(c0, r0));
+  const __m128 rcp_det = _mm_div_ps(_mm_set1_ps(1.f), det);
+
+  store_affine_inverse(_mm_mul_ps(r0, rcp_det), _mm_mul_ps(r1, rcp_det),
+                       _mm_mul_ps(r2, rcp_det), t, result);
+}
+
+#endif // BEYOND_SIMD_SSE
+
+} // namespace beyond::detail::simd
+
+#endif // BEYOND_CORE_MATH_DETAIL_SIMD_HPP
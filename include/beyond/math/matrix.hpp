@@ -10,8 +10,10 @@
  */
 
 #include <cstdlib>
+#include <type_traits>
 
 #include "../utils/assert.hpp"
+#include "detail/simd.hpp"
 #include "math_fwd.hpp"
 #include "vector.hpp"
 
@@ -259,6 +261,25 @@ template <typename Derived>
   return r;
 }
 
+/**
+ * @brief Transposes a 4x4 matrix
+ * @overload
+ */
+template <typename T>
+[[nodiscard]] constexpr auto transpose(const TMat4<T>& m) noexcept -> TMat4<T>
+{
+#ifdef BEYOND_SIMD_SSE
+  if constexpr (std::is_same_v<T, float>) {
+    if (!std::is_constant_evaluated()) {
+      TMat4<T> r(uninitialized_tag);
+      detail::simd::mat4_transpose(m.data, r.data);
+      return r;
+    }
+  }
+#endif
+  return transpose(static_cast<const MatrixBase<TMat4<T>>&>(m));
+}
+
 template <typename T> struct TMat2 : MatrixBase<TMat2<T>> {
   using BaseType = MatrixBase<TMat2>;
   using ValueType = T;
@@ -269,7 +290,7 @@ template <typename T> struct TMat2 : MatrixBase<TMat2<T>> {
   constexpr TMat2() noexcept : data{} {}
 
   /// @brief Create a TMat2 with all its elements uninitialized
-  explicit TMat2(UninitializedTag) noexcept {}
+  constexpr explicit TMat2(UninitializedTag) noexcept {}
 
   constexpr TMat2(const ValueType v00, const ValueType v01, const ValueType v10,
                   const ValueType v11) noexcept
@@ -312,7 +333,7 @@ template <typename T> struct TMat3 : MatrixBase<TMat3<T>> {
   constexpr TMat3() noexcept : data{} {}
 
   /// @brief Create a TMat3 with all its elements uninitialized
-  explicit TMat3(UninitializedTag) noexcept {}
+  constexpr explicit TMat3(UninitializedTag) noexcept {}
 
   constexpr TMat3(const ValueType v00, const ValueType v01, const ValueType v02,
                   const ValueType v10, const ValueType v11, const ValueType v12,
@@ -370,7 +391,7 @@ template <typename T> struct TMat4 : MatrixBase<TMat4<T>> {
   constexpr TMat4() noexcept : data{} {}
 
   /// @brief Create a TMat4 with all its elements uninitialized
-  explicit TMat4(UninitializedTag) noexcept {}
+  constexpr explicit TMat4(UninitializedTag) noexcept {}
 
   constexpr TMat4(const ValueType v00, const ValueType v01, const ValueType v02,
                   const ValueType v03, const ValueType v10, const ValueType v11,
@@ -383,10 +404,40 @@ template <typename T> struct TMat4 : MatrixBase<TMat4<T>> {
   {
   }
 
+  /**
+   * @brief Multiplies two 4x4 matrices
+   * @note Uses SIMD instructions for float matrices when it is available
+   */
+  [[nodiscard]] friend constexpr auto operator*(const TMat4& lhs,
+                                                const TMat4& rhs) noexcept
+      -> TMat4
+  {
+#ifdef BEYOND_SIMD_SSE
+    if constexpr (std::is_same_v<T, float>) {
+      if (!std::is_constant_evaluated()) {
+        TMat4 result(uninitialized_tag);
+        detail::simd::mat4_mul(lhs.data, rhs.data, result.data);
+        return result;
+      }
+    }
+#endif
+    return static_cast<const BaseType&>(lhs) *
+           static_cast<const BaseType&>(rhs);
+  }
+
   [[nodiscard]] friend constexpr auto operator*(const TMat4& m,
                                                 const TVec4<ValueType> v)
       -> TVec4<ValueType>
   {
+#ifdef BEYOND_SIMD_SSE
+    if constexpr (std::is_same_v<T, float>) {
+      if (!std::is_constant_evaluated()) {
+        TVec4<ValueType> result;
+        detail::simd::mat4_mul_vec4(m.data, v.elem, result.elem);
+        return result;
+      }
+    }
+#endif
     return TVec4<ValueType>(
         m.data[0] * v.x + m.data[4] * v.y + m.data[8] * v.z + m.data[12] * v.w,
         m.data[1] * v.x + m.data[5] * v.y + m.data[9] * v.z + m.data[13] * v.w,
@@ -429,8 +480,22 @@ template <typename T> struct TMat4 : MatrixBase<TMat4<T>> {
            m(3, 0) * m(2, 1) * m(0, 2) * m(1, 3);
   }
 
+  /**
+   * @brief Computes the inverse of a 4x4 matrix
+   * @note Uses SIMD instructions for float matrices when it is available
+   */
   [[nodiscard]] friend constexpr auto inverse(const TMat4& m) noexcept -> TMat4
   {
+#ifdef BEYOND_SIMD_SSE
+    if constexpr (std::is_same_v<T, float>) {
+      if (!std::is_constant_evaluated()) {
+        TMat4 result(uninitialized_tag);
+        detail::simd::mat4_inverse(m.data, result.data);
+        return result;
+      }
+    }
+#endif
+
     TMat4 out;
 
     out(0, 0) = m(2, 1) * m(3, 2) * m(1, 3) - m(3, 1) * m(2, 2) * m(1, 3) +
@@ -499,6 +564,82 @@ template <typename T> struct TMat4 : MatrixBase<TMat4<T>> {
 
     return out / determinant(m);
   }
+
+  /**
+   * @brief Computes the inverse of an affine transformation matrix
+   *
+   * An affine matrix has the form
+   * | A t |
+   * | 0 1 |
+   * where A is a 3x3 matrix (for example, a rotation and scale) and t is a
+   * translation. Its inverse only needs the inverse of A, which is much cheaper
+   * than the general inverse.
+   *
+   * @pre The bottom row of `m` is (0, 0, 0, 1), which is ignored
+   * @see inverse_rigid
+   */
+  [[nodiscard]] friend constexpr auto inverse_affine(const TMat4& m) noexcept
+      -> TMat4
+  {
+#ifdef BEYOND_SIMD_SSE
+    if constexpr (std::is_same_v<T, float>) {
+      if (!std::is_constant_evaluated()) {
+        TMat4 result(uninitialized_tag);
+        detail::simd::mat4_inverse_affine(m.data, result.data);
+        return result;
+      }
+    }
+#endif
+    const TMat3<T> a = inverse(TMat3<T>(m(0, 0), m(0, 1), m(0, 2),
+                                        m(1, 0), m(1, 1), m(1, 2),
+                                        m(2, 0), m(2, 1), m(2, 2)));
+    return from_affine_inverse(a, m(0, 3), m(1, 3), m(2, 3));
+  }
+
+  /**
+   * @brief Computes the inverse of a rigid transformation matrix
+   *
+   * A rigid matrix is an affine matrix whose upper 3x3 part is a rotation, in
+   * which case the inverse of the rotation is its transpose.
+   *
+   * @pre The upper 3x3 part of `m` is orthonormal, and the bottom row of `m` is
+   * (0, 0, 0, 1), which is ignored
+   * @see inverse_affine
+   */
+  [[nodiscard]] friend constexpr auto inverse_rigid(const TMat4& m) noexcept
+      -> TMat4
+  {
+#ifdef BEYOND_SIMD_SSE
+    if constexpr (std::is_same_v<T, float>) {
+      if (!std::is_constant_evaluated()) {
+        TMat4 result(uninitialized_tag);
+        detail::simd::mat4_inverse_rigid(m.data, result.data);
+        return result;
+      }
+    }
+#endif
+    const TMat3<T> a(m(0, 0), m(1, 0), m(2, 0),
+                     m(0, 1), m(1, 1), m(2, 1),
+                     m(0, 2), m(1, 2), m(2, 2));
+    return from_affine_inverse(a, m(0, 3), m(1, 3), m(2, 3));
+  }
+
+private:
+  // Builds | a  -a * t |
+  //        | 0    1    |
+  [[nodiscard]] static constexpr auto from_affine_inverse(const TMat3<T>& a,
+                                                          T tx, T ty,
+                                                          T tz) noexcept
+      -> TMat4
+  {
+    const auto row = [&](std::size_t i) {
+      return -(a(i, 0) * tx + a(i, 1) * ty + a(i, 2) * tz);
+    };
+    return TMat4(a(0, 0), a(0, 1), a(0, 2), row(0),
+                 a(1, 0), a(1, 1), a(1, 2), row(1),
+                 a(2, 0), a(2, 1), a(2, 2), row(2),
+                 0, 0, 0, 1);
+  }
 };
 
 #ifdef _MSC_VER
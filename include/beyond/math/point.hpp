@@ -120,7 +120,7 @@ template <typename T, std::size_t size>
 [[nodiscard]] auto distance(const TPoint<T, size>& p1,
                             const TPoint<T, size>& p2) noexcept -> T
 {
-  return std::sqrt(distance_squared(p1, p2));
+  return sqrt(distance_squared(p1, p2));
 }
 
 template <typename T, std::size_t size>
@@ -138,7 +138,7 @@ template <typename T, std::size_t size>
 {
   return [&]<std::size_t... I>(std::index_sequence<I...>) {
     TPoint<T, size> v;
-    ((v[I] = beyond::lerp(p1[I], p2[I], t)), ...);
+    ((v[I] = lerp(p1[I], p2[I], t)), ...);
     return v;
   }(std::make_index_sequence<size>());
 }
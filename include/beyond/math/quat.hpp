@@ -1,6 +1,19 @@
 #ifndef BEYOND_CORE_MATH_QUAT_HPP
 #define BEYOND_CORE_MATH_QUAT_HPP
 
+/**
+ * @file quat.hpp
+ * @brief Provides the TQuat class and quaternion operations
+ * @ingroup math
+ */
+
+#include <cmath>
+#include <concepts>
+#include <span>
+
+#include "angle.hpp"
+#include "concepts.hpp"
+#include "matrix.hpp"
 #include "vector.hpp"
 
 namespace beyond {
@@ -14,6 +27,11 @@ namespace beyond {
 
 /**
  * @brief A quaternion type
+ *
+ * Unit quaternions represent rotations. Composition follows the same order as
+ * matrices: `q1 * q2` first rotates by `q2` then by `q1`.
+ *
+ * The components are laid out as x, y, z, w in memory.
  */
 template <typename T> struct TQuat {
   T x, y, z, w;
@@ -33,16 +51,163 @@ template <typename T> struct TQuat {
   {
   }
 
-  /// @brief Quaternion multiplication
+  /// @brief Gets the identity quaternion, which represents no rotation
+  [[nodiscard]] static constexpr auto identity() noexcept -> TQuat
+  {
+    return TQuat(1, 0, 0, 0);
+  }
+
+  /**
+   * @brief Creates a quaternion that rotates around `axis` by `angle`
+   * @pre `axis` is normalized
+   */
+  template <std::floating_point U = T>
+  [[nodiscard]] static auto from_axis_angle(TRadian<U> angle,
+                                            const TVec3<U>& axis) noexcept
+      -> TQuat
+  {
+    const U half = angle.value() / 2;
+    return TQuat(std::cos(half), axis * std::sin(half));
+  }
+
+  /**
+   * @brief Creates a quaternion from a rotation matrix
+   * @pre `m` is orthonormal
+   */
+  template <std::floating_point U = T>
+  [[nodiscard]] static auto from_matrix(const TMat3<U>& m) noexcept -> TQuat
+  {
+    // Divides by the largest of the four possible denominators for numerical
+    // stability
+    const U trace = m(0, 0) + m(1, 1) + m(2, 2);
+    if (trace > 0) {
+      const U s = std::sqrt(trace + 1) * 2;
+      return TQuat(s / 4, (m(2, 1) - m(1, 2)) / s, (m(0, 2) - m(2, 0)) / s,
+                   (m(1, 0) - m(0, 1)) / s);
+    }
+    if (m(0, 0) > m(1, 1) && m(0, 0) > m(2, 2)) {
+      const U s = std::sqrt(1 + m(0, 0) - m(1, 1) - m(2, 2)) * 2;
+      return TQuat((m(2, 1) - m(1, 2)) / s, s / 4, (m(0, 1) + m(1, 0)) / s,
+                   (m(0, 2) + m(2, 0)) / s);
+    }
+    if (m(1, 1) > m(2, 2)) {
+      const U s = std::sqrt(1 + m(1, 1) - m(0, 0) - m(2, 2)) * 2;
+      return TQuat((m(0, 2) - m(2, 0)) / s, (m(0, 1) + m(1, 0)) / s, s / 4,
+                   (m(1, 2) + m(2, 1)) / s);
+    }
+    const U s = std::sqrt(1 + m(2, 2) - m(0, 0) - m(1, 1)) * 2;
+    return TQuat((m(1, 0) - m(0, 1)) / s, (m(0, 2) + m(2, 0)) / s,
+                 (m(1, 2) + m(2, 1)) / s, s / 4);
+  }
+
+  /**
+   * @brief Creates a quaternion from the rotation part of a 4x4 matrix
+   * @pre The upper 3x3 part of `m` is orthonormal
+   * @overload
+   */
+  template <std::floating_point U = T>
+  [[nodiscard]] static auto from_matrix(const TMat4<U>& m) noexcept -> TQuat
+  {
+    return from_matrix(TMat3<U>(m(0, 0), m(0, 1), m(0, 2), m(1, 0), m(1, 1),
+                                m(1, 2), m(2, 0), m(2, 1), m(2, 2)));
+  }
+
+  /// @brief Gets the imaginary part of the quaternion
+  [[nodiscard]] constexpr auto vec() const noexcept -> TVec3<T>
+  {
+    return TVec3<T>{x, y, z};
+  }
+
+  /// @brief Gets the squared length of the quaternion
+  [[nodiscard]] constexpr auto length_squared() const noexcept -> T
+  {
+    return x * x + y * y + z * z + w * w;
+  }
+
+  /// @brief Gets the length of the quaternion
+  [[nodiscard]] auto length() const noexcept -> T
+  {
+    static_assert(FloatingPointLike<T>);
+    return sqrt(length_squared());
+  }
+
+  constexpr auto operator+=(const TQuat& rhs) noexcept -> TQuat&
+  {
+    x += rhs.x;
+    y += rhs.y;
+    z += rhs.z;
+    w += rhs.w;
+    return *this;
+  }
+
+  constexpr auto operator-=(const TQuat& rhs) noexcept -> TQuat&
+  {
+    x -= rhs.x;
+    y -= rhs.y;
+    z -= rhs.z;
+    w -= rhs.w;
+    return *this;
+  }
+
+  constexpr auto operator*=(T s) noexcept -> TQuat&
+  {
+    x *= s;
+    y *= s;
+    z *= s;
+    w *= s;
+    return *this;
+  }
+
+  constexpr auto operator/=(T s) noexcept -> TQuat&
+  {
+    static_assert(FloatingPointLike<T>);
+    return *this *= T(1) / s;
+  }
+
+  [[nodiscard]] constexpr auto operator-() const noexcept -> TQuat
+  {
+    return TQuat(-w, -x, -y, -z);
+  }
+
+  [[nodiscard]] friend constexpr auto operator+(TQuat lhs,
+                                                const TQuat& rhs) noexcept
+      -> TQuat
+  {
+    return lhs += rhs;
+  }
+
+  [[nodiscard]] friend constexpr auto operator-(TQuat lhs,
+                                                const TQuat& rhs) noexcept
+      -> TQuat
+  {
+    return lhs -= rhs;
+  }
+
+  [[nodiscard]] friend constexpr auto operator*(TQuat q, T s) noexcept -> TQuat
+  {
+    return q *= s;
+  }
+
+  [[nodiscard]] friend constexpr auto operator*(T s, TQuat q) noexcept -> TQuat
+  {
+    return q *= s;
+  }
+
+  [[nodiscard]] friend constexpr auto operator/(TQuat q, T s) noexcept -> TQuat
+  {
+    return q /= s;
+  }
+
+  /// @brief Quaternion multiplication (Hamilton product)
   [[nodiscard]] friend constexpr auto operator*(const TQuat<T>& lhs,
                                                 const TQuat<T>& rhs) noexcept
       -> TQuat<T>
   {
     return TQuat<T>(
-        lhs.w * rhs.x - lhs.x * rhs.w + lhs.y * rhs.z - lhs.z * rhs.y,
+        lhs.w * rhs.w - lhs.x * rhs.x - lhs.y * rhs.y - lhs.z * rhs.z,
+        lhs.w * rhs.x + lhs.x * rhs.w + lhs.y * rhs.z - lhs.z * rhs.y,
         lhs.w * rhs.y - lhs.x * rhs.z + lhs.y * rhs.w + lhs.z * rhs.x,
-        lhs.w * rhs.z + lhs.x * rhs.y - lhs.y * rhs.x + lhs.z * rhs.w,
-        lhs.w * rhs.w - lhs.x * rhs.x - lhs.y * rhs.y - lhs.z * rhs.z);
+        lhs.w * rhs.z + lhs.x * rhs.y - lhs.y * rhs.x + lhs.z * rhs.w);
   }
 
   [[nodiscard]] friend constexpr auto operator==(const TQuat<T>& lhs,
@@ -53,6 +218,176 @@ template <typename T> struct TQuat {
 using Quat = TQuat<float>;
 using DQuat = TQuat<double>;
 
+/**
+ * @brief Gets the dot product of two quaternions
+ * @related TQuat
+ */
+template <typename T>
+[[nodiscard]] constexpr auto dot(const TQuat<T>& q1,
+                                 const TQuat<T>& q2) noexcept -> T
+{
+  return q1.x * q2.x + q1.y * q2.y + q1.z * q2.z + q1.w * q2.w;
+}
+
+/**
+ * @brief Normalizes a quaternion into a unit quaternion
+ * @related TQuat
+ */
+template <typename T>
+[[nodiscard]] auto normalize(const TQuat<T>& q) noexcept -> TQuat<T>
+  requires(FloatingPointLike<T>)
+{
+  return q / q.length();
+}
+
+/**
+ * @brief Gets the conjugate of a quaternion, which is the inverse rotation of
+ * a unit quaternion
+ * @related TQuat
+ */
+template <typename T>
+[[nodiscard]] constexpr auto conjugate(const TQuat<T>& q) noexcept -> TQuat<T>
+{
+  return TQuat<T>(q.w, -q.x, -q.y, -q.z);
+}
+
+/**
+ * @brief Gets the inverse of a quaternion
+ * @note For unit quaternions, conjugate is cheaper and gives the same result
+ * @related TQuat
+ */
+template <typename T>
+[[nodiscard]] constexpr auto inverse(const TQuat<T>& q) noexcept -> TQuat<T>
+  requires(FloatingPointLike<T>)
+{
+  return conjugate(q) / q.length_squared();
+}
+
+/**
+ * @brief Rotates a vector by a unit quaternion
+ * @related TQuat
+ */
+template <typename T>
+[[nodiscard]] constexpr auto rotate(const TQuat<T>& q,
+                                    const TVec3<T>& v) noexcept -> TVec3<T>
+{
+  // v + 2w(u x v) + 2u x (u x v), where u is the imaginary part of q
+  const TVec3<T> u = q.vec();
+  const TVec3<T> t = cross(u, v) * T(2);
+  return v + t * q.w + cross(u, t);
+}
+
+/**
+ * @brief Converts a unit quaternion to a 3x3 rotation matrix
+ * @related TQuat
+ */
+template <typename T>
+[[nodiscard]] constexpr auto to_mat3(const TQuat<T>& q) noexcept -> TMat3<T>
+{
+  const T xx = q.x * q.x;
+  const T yy = q.y * q.y;
+  const T zz = q.z * q.z;
+  const T xy = q.x * q.y;
+  const T xz = q.x * q.z;
+  const T yz = q.y * q.z;
+  const T wx = q.w * q.x;
+  const T wy = q.w * q.y;
+  const T wz = q.w * q.z;
+  return TMat3<T>(1 - 2 * (yy + zz), 2 * (xy - wz), 2 * (xz + wy),
+                  2 * (xy + wz), 1 - 2 * (xx + zz), 2 * (yz - wx),
+                  2 * (xz - wy), 2 * (yz + wx), 1 - 2 * (xx + yy));
+}
+
+/**
+ * @brief Converts a unit quaternion to a 4x4 rotation matrix
+ * @related TQuat
+ */
+template <typename T>
+[[nodiscard]] constexpr auto to_mat4(const TQuat<T>& q) noexcept -> TMat4<T>
+{
+  const TMat3<T> m = to_mat3(q);
+  return TMat4<T>(m(0, 0), m(0, 1), m(0, 2), 0, m(1, 0), m(1, 1), m(1, 2), 0,
+                  m(2, 0), m(2, 1), m(2, 2), 0, 0, 0, 0, 1);
+}
+
+/**
+ * @brief Normalized linear interpolation of two unit quaternions
+ *
+ * Cheaper than slerp, but the angular velocity is not constant. Takes the
+ * shortest path between the two rotations.
+ * @related TQuat
+ */
+template <std::floating_point T>
+[[nodiscard]] auto nlerp(const TQuat<T>& q1, const TQuat<T>& q2, T t) noexcept
+    -> TQuat<T>
+{
+  const T t2 = dot(q1, q2) < 0 ? -t : t;
+  return normalize(q1 * (1 - t) + q2 * t2);
+}
+
+/**
+ * @brief Spherical linear interpolation of two unit quaternions
+ *
+ * Interpolates with a constant angular velocity along the shortest path
+ * between the two rotations.
+ * @related TQuat
+ */
+template <std::floating_point T>
+[[nodiscard]] auto slerp(const TQuat<T>& q1, TQuat<T> q2, T t) noexcept
+    -> TQuat<T>
+{
+  T cos_theta = dot(q1, q2);
+  if (cos_theta < 0) {
+    q2 = -q2;
+    cos_theta = -cos_theta;
+  }
+
+  // sin(theta) is too close to 0 for the division
+  if (cos_theta > T(0.9995)) { return nlerp(q1, q2, t); }
+
+  const T theta = std::acos(cos_theta);
+  const T sin_theta = std::sqrt(1 - cos_theta * cos_theta);
+  return (q1 * std::sin((1 - t) * theta) + q2 * std::sin(t * theta)) /
+         sin_theta;
+}
+
+/**
+ * @brief Interpolates `from[i]` and `to[i]` by `t[i]` with slerp, and writes
+ * the results to `out[i]`
+ *
+ * Processes several quaternions at once with SIMD instructions. Instead of
+ * trigonometric functions, the weights are computed by a polynomial
+ * approximation, whose absolute error is below 1e-4.
+ *
+ * @pre All spans have the same size. `out` may alias `from` or `to`
+ * @related TQuat
+ */
+auto slerp(std::span<const Quat> from, std::span<const Quat> to,
+           std::span<const float> t, std::span<Quat> out) noexcept -> void;
+
+/**
+ * @brief Interpolates all `from[i]` and `to[i]` by the same `t`
+ * @overload
+ */
+auto slerp(std::span<const Quat> from, std::span<const Quat> to, float t,
+           std::span<Quat> out) noexcept -> void;
+
+/**
+ * @brief Interpolates `from[i]` and `to[i]` by `t[i]` with nlerp, and writes
+ * the results to `out[i]`
+ * @pre All spans have the same size. `out` may alias `from` or `to`
+ * @related TQuat
+ */
+auto nlerp(std::span<const Quat> from, std::span<const Quat> to,
+           std::span<const float> t, std::span<Quat> out) noexcept -> void;
+
+/**
+ * @brief Interpolates all `from[i]` and `to[i]` by the same `t`
+ * @overload
+ */
+auto nlerp(std::span<const Quat> from, std::span<const Quat> to, float t,
+           std::span<Quat> out) noexcept -> void;
+
 /** @}
  *  @} */
 
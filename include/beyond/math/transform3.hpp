@@ -0,0 +1,188 @@
+#pragma once
+
+#ifndef BEYOND_CORE_MATH_TRANSFORM3_HPP
+#define BEYOND_CORE_MATH_TRANSFORM3_HPP
+
+/**
+ * @file transform3.hpp
+ * @brief Provides the TTransform3 class, a compact representation of 3d
+ * transformations
+ * @ingroup math
+ */
+
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#include "matrix.hpp"
+#include "point.hpp"
+#include "quat.hpp"
+#include "vector.hpp"
+
+namespace beyond {
+
+namespace detail {
+
+template <typename T>
+[[nodiscard]] constexpr auto component_mul(const TVec3<T>& lhs,
+                                           const TVec3<T>& rhs) noexcept
+    -> TVec3<T>
+{
+  return {lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z};
+}
+
+} // namespace detail
+
+/**
+ * @addtogroup core
+ * @{
+ * @addtogroup math
+ * @{
+ */
+
+/**
+ * @brief A 3d transformation stored as translation, rotation, and scale
+ *
+ * Applying a TTransform3 to a point first scales it, then rotates it, and
+ * finally translates it, which is the same as the matrix
+ * `translate(translation) * to_mat4(rotation) * scale(scale)`. It takes 40
+ * bytes instead of the 64 of a 4x4 matrix, has a cheap exact inverse and can be
+ * interpolated, and the matrix is only built on demand with `to_mat4`.
+ *
+ * @warning A rotation followed by a non-uniform scale introduces shearing,
+ * which a TTransform3 cannot represent. Composition and inversion are exact
+ * when the scale of the parent is uniform or the child has no rotation, and
+ * approximations otherwise.
+ */
+template <typename T> struct TTransform3 {
+  TVec3<T> translation;
+  TQuat<T> rotation = TQuat<T>::identity();
+  TVec3<T> scale{1, 1, 1};
+
+  /// @brief Gets the transformation that does nothing
+  [[nodiscard]] static constexpr auto identity() noexcept -> TTransform3
+  {
+    return {};
+  }
+
+  /**
+   * @brief Composes two transformations
+   *
+   * The result transforms by `child` first, then by `parent`. For example, the
+   * world transformation of a scene node is `parent_world * local`.
+   */
+  [[nodiscard]] friend constexpr auto
+  operator*(const TTransform3& parent, const TTransform3& child) noexcept
+      -> TTransform3
+  {
+    return {parent.translation +
+                rotate(parent.rotation, detail::component_mul(
+                                            parent.scale, child.translation)),
+            parent.rotation * child.rotation,
+            detail::component_mul(parent.scale, child.scale)};
+  }
+};
+
+using Transform3 = TTransform3<float>;
+
+/**
+ * @brief Applies `transform` to a point
+ * @related TTransform3
+ */
+template <typename T>
+[[nodiscard]] constexpr auto transform_point(const TTransform3<T>& transform,
+                                             const TPoint3<T>& p) noexcept
+    -> TPoint3<T>
+{
+  const TVec3<T> v = transform.translation +
+                     rotate(transform.rotation,
+                            detail::component_mul(transform.scale,
+                                                  TVec3<T>{p.x, p.y, p.z}));
+  return {v.x, v.y, v.z};
+}
+
+/**
+ * @brief Applies `transform` to a vector, which ignores the translation
+ * @related TTransform3
+ */
+template <typename T>
+[[nodiscard]] constexpr auto transform_vector(const TTransform3<T>& transform,
+                                              const TVec3<T>& v) noexcept
+    -> TVec3<T>
+{
+  return rotate(transform.rotation, detail::component_mul(transform.scale, v));
+}
+
+/**
+ * @brief Gets the inverse of a transformation
+ * @pre No component of the scale is zero
+ * @related TTransform3
+ */
+template <typename T>
+[[nodiscard]] constexpr auto inverse(const TTransform3<T>& transform) noexcept
+    -> TTransform3<T>
+{
+  const TVec3<T> inv_scale{1 / transform.scale.x, 1 / transform.scale.y,
+                           1 / transform.scale.z};
+  const TQuat<T> inv_rotation = conjugate(transform.rotation);
+  return {detail::component_mul(inv_scale,
+                                rotate(inv_rotation, -transform.translation)),
+          inv_rotation, inv_scale};
+}
+
+/**
+ * @brief Converts a transformation to a 4x4 matrix
+ * @related TTransform3
+ */
+template <typename T>
+[[nodiscard]] constexpr auto to_mat4(const TTransform3<T>& transform) noexcept
+    -> TMat4<T>
+{
+  const TMat3<T> r = to_mat3(transform.rotation);
+  const TVec3<T>& s = transform.scale;
+  const TVec3<T>& t = transform.translation;
+  return TMat4<T>(r(0, 0) * s.x, r(0, 1) * s.y, r(0, 2) * s.z, t.x,
+                  r(1, 0) * s.x, r(1, 1) * s.y, r(1, 2) * s.z, t.y,
+                  r(2, 0) * s.x, r(2, 1) * s.y, r(2, 2) * s.z, t.z, 0, 0, 0,
+                  1);
+}
+
+/// @brief The parent index of root nodes in propagate_transforms
+inline constexpr std::uint32_t no_parent =
+    std::numeric_limits<std::uint32_t>::max();
+
+/**
+ * @brief Computes the world transformations of a hierarchy from the local
+ * ones
+ *
+ * Node `i` has the local transformation `local[i]` relative to the node
+ * `parents[i]`, or to the world if `parents[i]` is `no_parent`. Then
+ * `world[i] = world[parents[i]] * local[i]`.
+ *
+ * @pre All spans have the same size. Parents come before their children, that
+ * is, `parents[i] < i` for every node that is not a root. `world` may alias
+ * `local`
+ */
+auto propagate_transforms(std::span<const Transform3> local,
+                          std::span<const std::uint32_t> parents,
+                          std::span<Transform3> world) noexcept -> void;
+
+/**
+ * @brief Computes the world transformation matrices of a hierarchy from the
+ * local transformations
+ *
+ * Same as `propagate_transforms(local, parents, world)`, but also converts
+ * each world transformation to a matrix in the same pass.
+ * @overload
+ */
+auto propagate_transforms(std::span<const Transform3> local,
+                          std::span<const std::uint32_t> parents,
+                          std::span<Transform3> world,
+                          std::span<Mat4> world_matrices) noexcept -> void;
+
+/** @}
+ *  @} */
+
+} // namespace beyond
+
+#endif // BEYOND_CORE_MATH_TRANSFORM3_HPP
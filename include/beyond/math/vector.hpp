@@ -12,6 +12,7 @@
 #include <utility>
 
 #include "../utils/assert.hpp"
+#include "detail/simd.hpp"
 #include "detail/swizzle.hpp"
 #include "math.hpp"
 #include "math_fwd.hpp"
@@ -177,6 +178,19 @@ template <typename Derived> struct VectorStorage<Derived, 4> {
 #pragma warning(pop)
 #endif
 
+namespace detail {
+
+// Whether TVec<T, N> operations go through the SIMD kernels at runtime
+template <typename T, std::size_t N>
+inline constexpr bool use_simd_vec4 =
+#ifdef BEYOND_SIMD_SSE
+    std::is_same_v<T, float> && N == 4;
+#else
+    false;
+#endif
+
+} // namespace detail
+
 /**
  * @brief This class serve as base class for TVec.
  *
@@ -247,8 +261,8 @@ struct TVec : VectorStorage<TVec<T, N>, N> {
   template <typename U = ValueType>
   [[nodiscard]] auto length() const noexcept -> U
   {
-    static_assert(std::is_floating_point_v<U>);
-    return std::sqrt(length_squared());
+    static_assert(FloatingPointLike<U>);
+    return sqrt(length_squared());
   }
 
   /**
@@ -300,6 +314,14 @@ struct TVec : VectorStorage<TVec<T, N>, N> {
    */
   constexpr auto operator+=(const TVec& rhs) noexcept -> TVec&
   {
+#ifdef BEYOND_SIMD_SSE
+    if constexpr (detail::use_simd_vec4<T, N>) {
+      if (!std::is_constant_evaluated()) {
+        detail::simd::add4(Storage::elem, rhs.elem);
+        return *this;
+      }
+    }
+#endif
     [&]<std::size_t... I>(std::index_sequence<I...>) {
       ((Storage::elem[I] += rhs[I]), ...);
     }(std::make_index_sequence<N>());
@@ -311,6 +333,14 @@ struct TVec : VectorStorage<TVec<T, N>, N> {
    */
   constexpr auto operator-=(const TVec& rhs) noexcept -> TVec&
   {
+#ifdef BEYOND_SIMD_SSE
+    if constexpr (detail::use_simd_vec4<T, N>) {
+      if (!std::is_constant_evaluated()) {
+        detail::simd::sub4(Storage::elem, rhs.elem);
+        return *this;
+      }
+    }
+#endif
     [&]<std::size_t... I>(std::index_sequence<I...>) {
       ((Storage::elem[I] -= rhs[I]), ...);
     }(std::make_index_sequence<N>());
@@ -322,6 +352,14 @@ struct TVec : VectorStorage<TVec<T, N>, N> {
    */
   constexpr auto operator*=(ValueType rhs) noexcept -> TVec&
   {
+#ifdef BEYOND_SIMD_SSE
+    if constexpr (detail::use_simd_vec4<T, N>) {
+      if (!std::is_constant_evaluated()) {
+        detail::simd::scale4(Storage::elem, rhs);
+        return *this;
+      }
+    }
+#endif
     [&]<std::size_t... I>(std::index_sequence<I...>) {
       ((Storage::elem[I] *= rhs), ...);
     }(std::make_index_sequence<N>());
@@ -334,8 +372,10 @@ struct TVec : VectorStorage<TVec<T, N>, N> {
   template <typename U = ValueType>
   constexpr auto operator/=(U rhs) noexcept -> TVec&
   {
-    static_assert(std::is_floating_point_v<U>);
-    BEYOND_ASSERT_MSG(rhs != 0, "Devide by zero");
+    static_assert(FloatingPointLike<U>);
+    if constexpr (std::is_floating_point_v<U>) {
+      BEYOND_ASSERT_MSG(rhs != 0, "Devide by zero");
+    }
     const auto inv = static_cast<ValueType>(1) / rhs;
     [&]<std::size_t... I>(std::index_sequence<I...>) {
       ((Storage::elem[I] *= inv), ...);
@@ -401,7 +441,7 @@ struct TVec : VectorStorage<TVec<T, N>, N> {
   [[nodiscard]] friend constexpr auto operator/(TVec lhs, T scalar) noexcept
       -> TVec
   {
-    static_assert(std::is_floating_point_v<T>);
+    static_assert(FloatingPointLike<T>);
     lhs /= scalar;
     return lhs;
   }
@@ -412,7 +452,7 @@ struct TVec : VectorStorage<TVec<T, N>, N> {
 template <typename T, std::size_t N>
 [[nodiscard]] constexpr auto normalize(const TVec<T, N>& v) noexcept
     -> TVec<T, N>
-  requires(std::floating_point<T>)
+  requires(FloatingPointLike<T>)
 {
   return v / v.length();
 }
@@ -452,6 +492,13 @@ template <typename T, std::size_t N>
 [[nodiscard]] constexpr auto dot(const TVec<T, N>& v1,
                                  const TVec<T, N>& v2) noexcept -> T
 {
+#ifdef BEYOND_SIMD_SSE
+  if constexpr (detail::use_simd_vec4<T, N>) {
+    if (!std::is_constant_evaluated()) {
+      return detail::simd::dot4(v1.elem, v2.elem);
+    }
+  }
+#endif
   return [&]<std::size_t... I>(std::index_sequence<I...>) {
     return ((v1.elem[I] * v2.elem[I]) + ...);
   }(std::make_index_sequence<N>());
@@ -476,7 +523,7 @@ template <typename T, std::size_t size>
 {
   return [&]<std::size_t... I>(std::index_sequence<I...>) {
     TVec<T, size> v;
-    ((v.elem[I] = beyond::lerp(v1.elem[I], v2.elem[I], t)), ...);
+    ((v.elem[I] = lerp(v1.elem[I], v2.elem[I], t)), ...);
     return v;
   }(std::make_index_sequence<size>());
 }
@@ -0,0 +1,797 @@
+#pragma once
+
+#ifndef BEYOND_CORE_MATH_WIDE_FLOAT_HPP
+#define BEYOND_CORE_MATH_WIDE_FLOAT_HPP
+
+/**
+ * @file wide_float.hpp
+ * @brief Provides SIMD scalar types, and vectors and points built on them
+ * @ingroup math
+ */
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+#include "concepts.hpp"
+#include "detail/simd.hpp"
+#include "point.hpp"
+#include "vector.hpp"
+
+namespace beyond {
+
+namespace detail {
+
+// The lanes of a WideFloat or a WideMask in memory. They are aligned like the
+// SSE or AVX register of the same size, so that the layout of the wide types
+// is the same whichever instruction set a translation unit is compiled for
+template <typename T, std::size_t N>
+struct alignas(std::bit_ceil(N * sizeof(T))) WideLanes : std::array<T, N> {
+};
+
+// Lane-wise operations on the native representation of a WideFloat. The
+// primary template is the portable fallback, and the specializations below
+// map the operations to intrinsics. `Storage` and `MaskStorage` are what
+// WideFloat and WideMask hold, and `Native` and `Mask` are what the
+// operations work on. Mask lanes have all of their bits either set or clear.
+template <std::size_t N> struct WideOps {
+  using Native = WideLanes<float, N>;
+  using Mask = WideLanes<std::uint32_t, N>;
+  using Storage = Native;
+  using MaskStorage = Mask;
+
+  static auto to_native(const Storage& storage) noexcept -> Native
+  {
+    return storage;
+  }
+  static auto to_storage(const Native& native) noexcept -> Storage
+  {
+    return native;
+  }
+  static auto mask_to_native(const MaskStorage& storage) noexcept -> Mask
+  {
+    return storage;
+  }
+  static auto mask_to_storage(const Mask& mask) noexcept -> MaskStorage
+  {
+    return mask;
+  }
+
+  static constexpr auto mask_lane(bool set) noexcept -> std::uint32_t
+  {
+    return set ? ~std::uint32_t{0} : std::uint32_t{0};
+  }
+
+  template <typename Result, typename F>
+  static auto map(F f) noexcept -> Result
+  {
+    Result result;
+    for (std::size_t i = 0; i < N; ++i) { result[i] = f(i); }
+    return result;
+  }
+
+  static auto broadcast(float f) noexcept -> Native
+  {
+    return map<Native>([=](std::size_t) { return f; });
+  }
+  static auto load(const float* data) noexcept -> Native
+  {
+    return map<Native>([=](std::size_t i) { return data[i]; });
+  }
+  static auto store(const Native& a, float* data) noexcept -> void
+  {
+    for (std::size_t i = 0; i < N; ++i) { data[i] = a[i]; }
+  }
+
+  static auto add(const Native& a, const Native& b) noexcept -> Native
+  {
+    return map<Native>([&](std::size_t i) { return a[i] + b[i]; });
+  }
+  static auto sub(const Native& a, const Native& b) noexcept -> Native
+  {
+    return map<Native>([&](std::size_t i) { return a[i] - b[i]; });
+  }
+  static auto mul(const Native& a, const Native& b) noexcept -> Native
+  {
+    return map<Native>([&](std::size_t i) { return a[i] * b[i]; });
+  }
+  static auto div(const Native& a, const Native& b) noexcept -> Native
+  {
+    return map<Native>([&](std::size_t i) { return a[i] / b[i]; });
+  }
+  static auto neg(const Native& a) noexcept -> Native
+  {
+    return map<Native>([&](std::size_t i) { return -a[i]; });
+  }
+  static auto min(const Native& a, const Native& b) noexcept -> Native
+  {
+    return map<Native>(
+        [&](std::size_t i) { return a[i] < b[i] ? a[i] : b[i]; });
+  }
+  static auto max(const Native& a, const Native& b) noexcept -> Native
+  {
+    return map<Native>(
+        [&](std::size_t i) { return a[i] > b[i] ? a[i] : b[i]; });
+  }
+  static auto sqrt(const Native& a) noexcept -> Native
+  {
+    return map<Native>([&](std::size_t i) { return std::sqrt(a[i]); });
+  }
+  static auto abs(const Native& a) noexcept -> Native
+  {
+    return map<Native>([&](std::size_t i) { return std::fabs(a[i]); });
+  }
+
+  static auto less(const Native& a, const Native& b) noexcept -> Mask
+  {
+    return map<Mask>([&](std::size_t i) { return mask_lane(a[i] < b[i]); });
+  }
+  static auto less_equal(const Native& a, const Native& b) noexcept -> Mask
+  {
+    return map<Mask>(
+        [&](std::size_t i) { return mask_lane(a[i] <= b[i]); });
+  }
+  static auto equal(const Native& a, const Native& b) noexcept -> Mask
+  {
+    return map<Mask>(
+        [&](std::size_t i) { return mask_lane(a[i] == b[i]); });
+  }
+  static auto not_equal(const Native& a, const Native& b) noexcept -> Mask
+  {
+    return map<Mask>(
+        [&](std::size_t i) { return mask_lane(a[i] != b[i]); });
+  }
+
+  static auto mask_and(const Mask& a, const Mask& b) noexcept -> Mask
+  {
+    return map<Mask>([&](std::size_t i) { return a[i] & b[i]; });
+  }
+  static auto mask_or(const Mask& a, const Mask& b) noexcept -> Mask
+  {
+    return map<Mask>([&](std::size_t i) { return a[i] | b[i]; });
+  }
+  static auto mask_not(const Mask& a) noexcept -> Mask
+  {
+    return map<Mask>([&](std::size_t i) { return ~a[i]; });
+  }
+  static auto bits(const Mask& a) noexcept -> unsigned
+  {
+    unsigned result = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+      if (a[i] != 0) { result |= 1u << i; }
+    }
+    return result;
+  }
+  static auto select(const Mask& mask, const Native& a,
+                     const Native& b) noexcept -> Native
+  {
+    return map<Native>(
+        [&](std::size_t i) { return mask[i] != 0 ? a[i] : b[i]; });
+  }
+};
+
+#ifdef BEYOND_SIMD_SSE
+
+template <> struct WideOps<4> {
+  using Native = __m128;
+  using Mask = __m128;
+  // Same size and alignment as WideLanes<float, 4>
+  using Storage = __m128;
+  using MaskStorage = __m128;
+
+  static auto to_native(Storage storage) noexcept -> Native
+  {
+    return storage;
+  }
+  static auto to_storage(Native native) noexcept -> Storage
+  {
+    return native;
+  }
+  static auto mask_to_native(MaskStorage storage) noexcept -> Mask
+  {
+    return storage;
+  }
+  static auto mask_to_storage(Mask mask) noexcept -> MaskStorage
+  {
+    return mask;
+  }
+
+  static auto broadcast(float f) noexcept -> Native
+  {
+    return _mm_set1_ps(f);
+  }
+  static auto load(const float* data) noexcept -> Native
+  {
+    return _mm_loadu_ps(data);
+  }
+  static auto store(Native a, float* data) noexcept -> void
+  {
+    _mm_storeu_ps(data, a);
+  }
+
+  static auto add(Native a, Native b) noexcept -> Native
+  {
+    return _mm_add_ps(a, b);
+  }
+  static auto sub(Native a, Native b) noexcept -> Native
+  {
+    return _mm_sub_ps(a, b);
+  }
+  static auto mul(Native a, Native b) noexcept -> Native
+  {
+    return _mm_mul_ps(a, b);
+  }
+  static auto div(Native a, Native b) noexcept -> Native
+  {
+    return _mm_div_ps(a, b);
+  }
+  static auto neg(Native a) noexcept -> Native
+  {
+    return _mm_xor_ps(a, _mm_set1_ps(-0.f));
+  }
+  static auto min(Native a, Native b) noexcept -> Native
+  {
+    return _mm_min_ps(a, b);
+  }
+  static auto max(Native a, Native b) noexcept -> Native
+  {
+    return _mm_max_ps(a, b);
+  }
+  static auto sqrt(Native a) noexcept -> Native
+  {
+    return _mm_sqrt_ps(a);
+  }
+  static auto abs(Native a) noexcept -> Native
+  {
+    return _mm_andnot_ps(_mm_set1_ps(-0.f), a);
+  }
+
+  static auto less(Native a, Native b) noexcept -> Mask
+  {
+    return _mm_cmplt_ps(a, b);
+  }
+  static auto less_equal(Native a, Native b) noexcept -> Mask
+  {
+    return _mm_cmple_ps(a, b);
+  }
+  static auto equal(Native a, Native b) noexcept -> Mask
+  {
+    return _mm_cmpeq_ps(a, b);
+  }
+  static auto not_equal(Native a, Native b) noexcept -> Mask
+  {
+    return _mm_cmpneq_ps(a, b);
+  }
+
+  static auto mask_and(Mask a, Mask b) noexcept -> Mask
+  {
+    return _mm_and_ps(a, b);
+  }
+  static auto mask_or(Mask a, Mask b) noexcept -> Mask
+  {
+    return _mm_or_ps(a, b);
+  }
+  static auto mask_not(Mask a) noexcept -> Mask
+  {
+    return _mm_xor_ps(a, _mm_castsi128_ps(_mm_set1_epi32(-1)));
+  }
+  static auto bits(Mask a) noexcept -> unsigned
+  {
+    return static_cast<unsigned>(_mm_movemask_ps(a));
+  }
+  static auto select(Mask mask, Native a, Native b) noexcept -> Native
+  {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+  }
+};
+
+#endif
+
+#ifdef BEYOND_SIMD_AVX
+
+// The lanes are stored as WideLanes rather than as __m256, since core itself
+// may be built without AVX while its users are built with it
+template <> struct WideOps<8> {
+  using Native = __m256;
+  using Mask = __m256;
+  using Storage = WideLanes<float, 8>;
+  using MaskStorage = WideLanes<std::uint32_t, 8>;
+
+  static auto to_native(const Storage& storage) noexcept -> Native
+  {
+    return _mm256_loadu_ps(storage.data());
+  }
+  static auto to_storage(Native native) noexcept -> Storage
+  {
+    Storage storage;
+    _mm256_storeu_ps(storage.data(), native);
+    return storage;
+  }
+  static auto mask_to_native(const MaskStorage& storage) noexcept -> Mask
+  {
+    return _mm256_castsi256_ps(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(storage.data())));
+  }
+  static auto mask_to_storage(Mask mask) noexcept -> MaskStorage
+  {
+    MaskStorage storage;
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(storage.data()),
+                        _mm256_castps_si256(mask));
+    return storage;
+  }
+
+  static auto broadcast(float f) noexcept -> Native
+  {
+    return _mm256_set1_ps(f);
+  }
+  static auto load(const float* data) noexcept -> Native
+  {
+    return _mm256_loadu_ps(data);
+  }
+  static auto store(Native a, float* data) noexcept -> void
+  {
+    _mm256_storeu_ps(data, a);
+  }
+
+  static auto add(Native a, Native b) noexcept -> Native
+  {
+    return _mm256_add_ps(a, b);
+  }
+  static auto sub(Native a, Native b) noexcept -> Native
+  {
+    return _mm256_sub_ps(a, b);
+  }
+  static auto mul(Native a, Native b) noexcept -> Native
+  {
+    return _mm256_mul_ps(a, b);
+  }
+  static auto div(Native a, Native b) noexcept -> Native
+  {
+    return _mm256_div_ps(a, b);
+  }
+  static auto neg(Native a) noexcept -> Native
+  {
+    return _mm256_xor_ps(a, _mm256_set1_ps(-0.f));
+  }
+  static auto min(Native a, Native b) noexcept -> Native
+  {
+    return _mm256_min_ps(a, b);
+  }
+  static auto max(Native a, Native b) noexcept -> Native
+  {
+    return _mm256_max_ps(a, b);
+  }
+  static auto sqrt(Native a) noexcept -> Native
+  {
+    return _mm256_sqrt_ps(a);
+  }
+  static auto abs(Native a) noexcept -> Native
+  {
+    return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a);
+  }
+
+  static auto less(Native a, Native b) noexcept -> Mask
+  {
+    return _mm256_cmp_ps(a, b, _CMP_LT_OQ);
+  }
+  static auto less_equal(Native a, Native b) noexcept -> Mask
+  {
+    return _mm256_cmp_ps(a, b, _CMP_LE_OQ);
+  }
+  static auto equal(Native a, Native b) noexcept -> Mask
+  {
+    return _mm256_cmp_ps(a, b, _CMP_EQ_OQ);
+  }
+  static auto not_equal(Native a, Native b) noexcept -> Mask
+  {
+    return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ);
+  }
+
+  static auto mask_and(Mask a, Mask b) noexcept -> Mask
+  {
+    return _mm256_and_ps(a, b);
+  }
+  static auto mask_or(Mask a, Mask b) noexcept -> Mask
+  {
+    return _mm256_or_ps(a, b);
+  }
+  static auto mask_not(Mask a) noexcept -> Mask
+  {
+    return _mm256_xor_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(-1)));
+  }
+  static auto bits(Mask a) noexcept -> unsigned
+  {
+    return static_cast<unsigned>(_mm256_movemask_ps(a));
+  }
+  static auto select(Mask mask, Native a, Native b) noexcept -> Native
+  {
+    return _mm256_blendv_ps(b, a, mask);
+  }
+};
+
+#endif
+
+} // namespace detail
+
+/**
+ * @addtogroup core
+ * @{
+ * @addtogroup math
+ * @{
+ */
+
+template <std::size_t N> class WideFloat;
+
+/**
+ * @brief The result of a lane-wise comparison of two WideFloat
+ * @see WideFloat
+ */
+template <std::size_t N> class WideMask {
+  using Ops = detail::WideOps<N>;
+
+public:
+  using Native = typename Ops::Mask;
+
+  WideMask() = default;
+  explicit WideMask(Native native) noexcept
+      : storage_{Ops::mask_to_storage(native)}
+  {
+  }
+
+  /// @brief Gets the underlying SIMD register or array
+  [[nodiscard]] auto native() const noexcept -> Native
+  {
+    return Ops::mask_to_native(storage_);
+  }
+
+  /**
+   * @brief Gets the mask as an integer whose i-th bit is set if lane i is set
+   */
+  [[nodiscard]] auto bits() const noexcept -> unsigned
+  {
+    return Ops::bits(native());
+  }
+
+  [[nodiscard]] friend auto operator&(WideMask lhs, WideMask rhs) noexcept
+      -> WideMask
+  {
+    return WideMask{Ops::mask_and(lhs.native(), rhs.native())};
+  }
+
+  [[nodiscard]] friend auto operator|(WideMask lhs, WideMask rhs) noexcept
+      -> WideMask
+  {
+    return WideMask{Ops::mask_or(lhs.native(), rhs.native())};
+  }
+
+  [[nodiscard]] friend auto operator!(WideMask mask) noexcept -> WideMask
+  {
+    return WideMask{Ops::mask_not(mask.native())};
+  }
+
+private:
+  typename Ops::MaskStorage storage_;
+};
+
+/// @brief Whether any lane of `mask` is set
+/// @related WideMask
+template <std::size_t N>
+[[nodiscard]] auto any(WideMask<N> mask) noexcept -> bool
+{
+  return mask.bits() != 0;
+}
+
+/// @brief Whether all lanes of `mask` are set
+/// @related WideMask
+template <std::size_t N>
+[[nodiscard]] auto all(WideMask<N> mask) noexcept -> bool
+{
+  return mask.bits() == (1u << N) - 1;
+}
+
+/// @brief Whether no lane of `mask` is set
+/// @related WideMask
+template <std::size_t N>
+[[nodiscard]] auto none(WideMask<N> mask) noexcept -> bool
+{
+  return mask.bits() == 0;
+}
+
+/**
+ * @brief A SIMD scalar that holds `N` floats, and whose arithmetic operations
+ * apply to each lane independently
+ *
+ * WideFloat can be used as the component type of TVec and TPoint, which lets
+ * structure of arrays code reuse the vector algebra. For example, `Vec3x8`
+ * holds eight 3d vectors, and `dot(a, b)` of two `Vec3x8` computes the eight
+ * dot products at once:
+ *
+ * ```cpp
+ * const Vec3x8 d = load_vec3x8(xs, ys, zs);
+ * const Float8 t = dot(d, normal) / dot(d, d);
+ * ```
+ *
+ * A WideFloat of 4 lanes maps to a SSE register, and one of 8 lanes maps to an
+ * AVX register. Otherwise, the operations fall back to scalar loops.
+ * Comparisons produce a WideMask instead of a bool. The size and alignment of
+ * both types are `4 * N` bytes whether or not SIMD is enabled, so code built
+ * with and without AVX can share them.
+ */
+template <std::size_t N> class WideFloat {
+  using Ops = detail::WideOps<N>;
+
+public:
+  using Native = typename Ops::Native;
+  using Mask = WideMask<N>;
+
+  /// @brief Gets the number of lanes
+  [[nodiscard]] static constexpr auto size() noexcept -> std::size_t
+  {
+    return N;
+  }
+
+  /// @brief Default construct an uninitialized WideFloat
+  WideFloat() = default;
+
+  /// @brief Sets all lanes to `value`
+  WideFloat(float value) noexcept
+      : storage_{Ops::to_storage(Ops::broadcast(value))}
+  {
+  }
+
+  /// @brief Sets each lane to the corresponding argument
+  template <std::same_as<float>... Lanes>
+    requires(sizeof...(Lanes) == N && N > 1)
+  explicit WideFloat(Lanes... lanes) noexcept
+  {
+    const float values[N] = {lanes...};
+    storage_ = Ops::to_storage(Ops::load(values));
+  }
+
+  explicit WideFloat(Native native) noexcept : storage_{Ops::to_storage(native)}
+  {
+  }
+
+  /**
+   * @brief Loads `N` consecutive floats
+   * @note `data` does not need to be aligned
+   */
+  [[nodiscard]] static auto load(const float* data) noexcept -> WideFloat
+  {
+    return WideFloat{Ops::load(data)};
+  }
+
+  /**
+   * @brief Stores the lanes to `N` consecutive floats
+   * @note `data` does not need to be aligned
+   */
+  auto store(float* data) const noexcept -> void
+  {
+    Ops::store(native(), data);
+  }
+
+  /// @brief Gets the underlying SIMD register or array
+  [[nodiscard]] auto native() const noexcept -> Native
+  {
+    return Ops::to_native(storage_);
+  }
+
+  /**
+   * @brief Gets the value of the i-th lane
+   * @note This is slow, and is mostly meant for debugging and tests
+   */
+  [[nodiscard]] auto operator[](std::size_t i) const noexcept -> float
+  {
+    BEYOND_ASSERT_MSG(i < N, "Invalid lane");
+    std::array<float, N> lanes;
+    store(lanes.data());
+    return lanes[i];
+  }
+
+  auto operator+=(WideFloat rhs) noexcept -> WideFloat&
+  {
+    storage_ = Ops::to_storage(Ops::add(native(), rhs.native()));
+    return *this;
+  }
+
+  auto operator-=(WideFloat rhs) noexcept -> WideFloat&
+  {
+    storage_ = Ops::to_storage(Ops::sub(native(), rhs.native()));
+    return *this;
+  }
+
+  auto operator*=(WideFloat rhs) noexcept -> WideFloat&
+  {
+    storage_ = Ops::to_storage(Ops::mul(native(), rhs.native()));
+    return *this;
+  }
+
+  auto operator/=(WideFloat rhs) noexcept -> WideFloat&
+  {
+    storage_ = Ops::to_storage(Ops::div(native(), rhs.native()));
+    return *this;
+  }
+
+  [[nodiscard]] auto operator-() const noexcept -> WideFloat
+  {
+    return WideFloat{Ops::neg(native())};
+  }
+
+  [[nodiscard]] friend auto operator+(WideFloat lhs, WideFloat rhs) noexcept
+      -> WideFloat
+  {
+    return lhs += rhs;
+  }
+
+  [[nodiscard]] friend auto operator-(WideFloat lhs, WideFloat rhs) noexcept
+      -> WideFloat
+  {
+    return lhs -= rhs;
+  }
+
+  [[nodiscard]] friend auto operator*(WideFloat lhs, WideFloat rhs) noexcept
+      -> WideFloat
+  {
+    return lhs *= rhs;
+  }
+
+  [[nodiscard]] friend auto operator/(WideFloat lhs, WideFloat rhs) noexcept
+      -> WideFloat
+  {
+    return lhs /= rhs;
+  }
+
+  [[nodiscard]] friend auto operator<(WideFloat lhs, WideFloat rhs) noexcept
+      -> Mask
+  {
+    return Mask{Ops::less(lhs.native(), rhs.native())};
+  }
+
+  [[nodiscard]] friend auto operator<=(WideFloat lhs, WideFloat rhs) noexcept
+      -> Mask
+  {
+    return Mask{Ops::less_equal(lhs.native(), rhs.native())};
+  }
+
+  [[nodiscard]] friend auto operator>(WideFloat lhs, WideFloat rhs) noexcept
+      -> Mask
+  {
+    return rhs < lhs;
+  }
+
+  [[nodiscard]] friend auto operator>=(WideFloat lhs, WideFloat rhs) noexcept
+      -> Mask
+  {
+    return rhs <= lhs;
+  }
+
+  [[nodiscard]] friend auto operator==(WideFloat lhs, WideFloat rhs) noexcept
+      -> Mask
+  {
+    return Mask{Ops::equal(lhs.native(), rhs.native())};
+  }
+
+  [[nodiscard]] friend auto operator!=(WideFloat lhs, WideFloat rhs) noexcept
+      -> Mask
+  {
+    return Mask{Ops::not_equal(lhs.native(), rhs.native())};
+  }
+
+  /// @brief Lane-wise minimum
+  [[nodiscard]] friend auto min(WideFloat lhs, WideFloat rhs) noexcept
+      -> WideFloat
+  {
+    return WideFloat{Ops::min(lhs.native(), rhs.native())};
+  }
+
+  /// @brief Lane-wise maximum
+  [[nodiscard]] friend auto max(WideFloat lhs, WideFloat rhs) noexcept
+      -> WideFloat
+  {
+    return WideFloat{Ops::max(lhs.native(), rhs.native())};
+  }
+
+  /// @brief Lane-wise square root
+  [[nodiscard]] friend auto sqrt(WideFloat x) noexcept -> WideFloat
+  {
+    return WideFloat{Ops::sqrt(x.native())};
+  }
+
+  /// @brief Lane-wise absolute value
+  [[nodiscard]] friend auto abs(WideFloat x) noexcept -> WideFloat
+  {
+    return WideFloat{Ops::abs(x.native())};
+  }
+
+  /// @brief Lane-wise linear interpolation
+  [[nodiscard]] friend auto lerp(WideFloat a, WideFloat b, WideFloat t) noexcept
+      -> WideFloat
+  {
+    return a * (WideFloat{1.f} - t) + b * t;
+  }
+
+  /**
+   * @brief Picks the lanes of `a` where `mask` is set, and the lanes of `b`
+   * elsewhere
+   */
+  [[nodiscard]] friend auto select(Mask mask, WideFloat a, WideFloat b) noexcept
+      -> WideFloat
+  {
+    return WideFloat{Ops::select(mask.native(), a.native(), b.native())};
+  }
+
+private:
+  typename Ops::Storage storage_;
+};
+
+template <std::size_t N>
+struct IsFloatingPointLike<WideFloat<N>> : std::true_type {
+};
+
+using Float4 = WideFloat<4>;
+using Float8 = WideFloat<8>;
+using Mask4 = WideMask<4>;
+using Mask8 = WideMask<8>;
+
+/**
+ * @brief Vectors and points whose components are WideFloat, each of them holds
+ * 4 or 8 vectors in structure of arrays layout
+ */
+using Vec2x4 = TVec2<Float4>;
+using Vec3x4 = TVec3<Float4>;
+using Vec4x4 = TVec4<Float4>;
+using Vec2x8 = TVec2<Float8>;
+using Vec3x8 = TVec3<Float8>;
+using Vec4x8 = TVec4<Float8>;
+using Point3x4 = TPoint3<Float4>;
+using Point3x8 = TPoint3<Float8>;
+
+/**
+ * @brief Loads `N` 3d vectors whose components are stored in three arrays
+ * @note The pointers do not need to be aligned
+ */
+template <std::size_t N>
+[[nodiscard]] auto load_vec3(const float* x, const float* y,
+                             const float* z) noexcept -> TVec3<WideFloat<N>>
+{
+  return {WideFloat<N>::load(x), WideFloat<N>::load(y), WideFloat<N>::load(z)};
+}
+
+/**
+ * @brief Stores the components of `v` into three arrays
+ * @note The pointers do not need to be aligned
+ */
+template <std::size_t N>
+auto store_vec3(const TVec3<WideFloat<N>>& v, float* x, float* y,
+                float* z) noexcept -> void
+{
+  v.x.store(x);
+  v.y.store(y);
+  v.z.store(z);
+}
+
+/// @brief Sets all lanes of a wide vector to `v`
+template <std::size_t N>
+[[nodiscard]] auto broadcast(const Vec3& v) noexcept -> TVec3<WideFloat<N>>
+{
+  return {WideFloat<N>{v.x}, WideFloat<N>{v.y}, WideFloat<N>{v.z}};
+}
+
+/// @brief Gets the vector of lane `i` of a wide vector
+/// @note This is slow, and is mostly meant for debugging and tests
+template <std::size_t N>
+[[nodiscard]] auto extract(const TVec3<WideFloat<N>>& v, std::size_t i) noexcept
+    -> Vec3
+{
+  return {v.x[i], v.y[i], v.z[i]};
+}
+
+/** @}
+ *  @} */
+
+} // namespace beyond
+
+#endif // BEYOND_CORE_MATH_WIDE_FLOAT_HPP
@@ -94,7 +94,7 @@ public:
 
   [[nodiscard]] auto generation() const -> Generation
   {
-    return data_ >> shift;
+    return static_cast<Generation>(data_ >> shift);
   }
 
   [[nodiscard]] friend constexpr auto operator==(Derived lhs, Derived rhs)
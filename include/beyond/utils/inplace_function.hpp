@@ -0,0 +1,112 @@
+#pragma once
+
+#ifndef BEYOND_CORE_UTILS_INPLACE_FUNCTION_HPP
+#define BEYOND_CORE_UTILS_INPLACE_FUNCTION_HPP
+
+#include "unique_function.hpp"
+
+namespace beyond {
+
+/**
+ * @brief A move-only type-erased function wrapper that never allocates
+ *
+ * Unlike `unique_function`, which spills large callables to the heap,
+ * `inplace_function` is not constructible from callables that do not fit into
+ * `capacity` bytes, are overaligned, or may throw on move. This makes it usable
+ * on threads where allocation is not allowed, like the audio thread.
+ */
+template <typename Signature,
+          std::size_t capacity = unique_function_default_inline_size>
+class inplace_function;
+
+template <std::size_t capacity, typename R, typename... Args>
+class inplace_function<R(Args...), capacity>
+    : public detail::unique_function_base<capacity, R, Args...> {
+  using base_type = detail::unique_function_base<capacity, R, Args...>;
+
+public:
+  inplace_function() = default;
+
+  template <typename Func, class DFunc = std::decay_t<Func>,
+            class = std::enable_if_t<
+                !std::is_same_v<DFunc, inplace_function> &&
+                std::is_move_constructible_v<DFunc> &&
+                base_type::template stores_inline<DFunc>>>
+  explicit inplace_function(Func&& func) : base_type{std::forward<Func>(func)}
+  {
+  }
+
+  inplace_function(inplace_function<R(Args...) const, capacity>&& other)
+      : base_type{static_cast<base_type&&>(other)}
+  {
+  }
+
+  auto operator()(Args... args) -> R
+  {
+    return this->invoke(std::forward<Args>(args)...);
+  }
+};
+
+template <std::size_t capacity, typename R, typename... Args>
+class inplace_function<R(Args...) const, capacity>
+    : public detail::unique_function_base<capacity, R, Args...> {
+  using base_type = detail::unique_function_base<capacity, R, Args...>;
+
+public:
+  inplace_function() = default;
+
+  template <typename Func, class DFunc = std::decay_t<Func>,
+            class = std::enable_if_t<
+                !std::is_same_v<DFunc, inplace_function> &&
+                std::is_move_constructible_v<DFunc> &&
+                base_type::template stores_inline<DFunc>>,
+            class = std::void_t<
+                decltype(std::declval<const Func&>()(std::declval<Args>()...))>>
+  explicit inplace_function(Func&& func) : base_type{std::forward<Func>(func)}
+  {
+  }
+
+  auto operator()(Args... args) const -> R
+  {
+    return this->invoke(std::forward<Args>(args)...);
+  }
+};
+
+template <class Func, std::size_t capacity>
+auto swap(inplace_function<Func, capacity>& lhs,
+          inplace_function<Func, capacity>& rhs) noexcept -> void
+{
+  lhs.swap(rhs);
+}
+
+template <class Func, std::size_t capacity>
+auto operator==(const inplace_function<Func, capacity>& lhs,
+                std::nullptr_t) noexcept -> bool
+{
+  return !lhs;
+}
+
+template <class Func, std::size_t capacity>
+auto operator==(std::nullptr_t,
+                const inplace_function<Func, capacity>& lhs) noexcept -> bool
+{
+  return !lhs;
+}
+
+template <class Func, std::size_t capacity>
+auto operator!=(const inplace_function<Func, capacity>& lhs,
+                std::nullptr_t) noexcept -> bool
+{
+  return lhs;
+}
+
+template <class Func, std::size_t capacity>
+auto operator!=(std::nullptr_t,
+                const inplace_function<Func, capacity>& lhs) noexcept -> bool
+{
+  return lhs;
+}
+
+} // namespace beyond
+
+#endif // BEYOND_CORE_UTILS_INPLACE_FUNCTION_HPP
@@ -3,82 +3,152 @@
 #ifndef BEYOND_UNIQUE_FUNCTION_HPP
 #define BEYOND_UNIQUE_FUNCTION_HPP
 
+#include <cstddef>
 #include <functional>
+#include <memory>
 #include <type_traits>
+#include <utility>
 
+#include "../allocators/global_resource.hpp"
 
 namespace beyond {
 
-template <typename R, typename... Args> class unique_function;
+/// @brief The default number of bytes a `unique_function` can store inline
+inline constexpr std::size_t unique_function_default_inline_size = 32;
+
+/**
+ * @brief A move-only type-erased function wrapper
+ *
+ * Callables that are smaller than `inline_size` bytes and nothrow move
+ * constructible are stored inline. Larger callables are allocated from a
+ * `MemoryResource`, which is the default resource unless specified otherwise.
+ */
+template <typename Signature,
+          std::size_t inline_size = unique_function_default_inline_size>
+class unique_function;
 
 namespace detail {
 
-template <typename R, typename... Args> struct unique_function_base;
+template <std::size_t inline_size, typename R, typename... Args>
+struct unique_function_base;
 
 enum class unique_function_behaviors { move_to, destory };
 
-union unique_function_storage {
-  alignas(void*) std::byte small_[32];
-  void* large_;
+// Heap allocated callable along with the resource that allocates it
+struct unique_function_large_storage {
+  void* ptr;
+  MemoryResource* resource;
+};
+
+template <std::size_t inline_size> union unique_function_storage {
+  alignas(void*) std::byte small_[inline_size];
+  unique_function_large_storage large_;
 
   template <class T>
   static constexpr bool fit_small = sizeof(T) <= sizeof(small_) &&
-                                    alignof(T) <= alignof(decltype(small_)) &&
+                                    alignof(T) <= alignof(void*) &&
                                     std::is_nothrow_move_constructible_v<T>;
 
+  // Inline callables that can be relocated with a memcpy and need no
+  // destruction
+  template <class T>
+  static constexpr bool trivially_relocatable =
+      fit_small<T> && std::is_trivially_copyable_v<T> &&
+      std::is_trivially_destructible_v<T>;
+
   unique_function_storage() noexcept = default;
 
   template <typename Func, typename... Data>
-  auto emplace(Data&&... args) -> void
+  auto emplace(MemoryResource* resource, Data&&... args) -> void
   {
     if constexpr (fit_small<Func>) {
       ::new (static_cast<void*>(&small_)) Func(std::forward<Data>(args)...);
     } else {
-      large_ = new Func(std::forward<Data>(args)...);
+      // Gives the memory back if the constructor of Func throws
+      struct Guard {
+        MemoryResource* resource;
+        void* memory;
+        ~Guard()
+        {
+          if (memory) {
+            resource->deallocate(memory, sizeof(Func), alignof(Func));
+          }
+        }
+      } guard{resource, resource->allocate(sizeof(Func), alignof(Func))};
+
+      ::new (guard.memory) Func(std::forward<Data>(args)...);
+      large_ = {std::exchange(guard.memory, nullptr), resource};
     }
   }
 
   template <typename R, typename... Args> struct behaviors {
+    using Base = unique_function_base<inline_size, R, Args...>;
+
     template <typename Func>
-    static R invoke(const unique_function_base<R, Args...>& who, Args&&... args)
+    static R invoke(const Base& who, Args&&... args)
     {
       constexpr static bool fit_sm = fit_small<Func>;
       void* data = const_cast<void*>(fit_sm ? &who.storage_.small_
-                                            : who.storage_.large_);
+                                            : who.storage_.large_.ptr);
       return (*static_cast<Func*>(data))(std::forward<Args>(args)...);
     }
 
+    // Dispatch of trivially relocatable callables. unique_function_base
+    // compares against its address to memcpy or forget those callables without
+    // an indirect call
+    static auto trivial_dispatch(unique_function_behaviors behavior, Base& who,
+                                 void* ret) noexcept -> void
+    {
+      if (behavior == unique_function_behaviors::move_to) {
+        static_cast<Base*>(ret)->relocate_trivially_from(who);
+      }
+    }
+
     template <typename Func>
-    static auto dispatch(unique_function_behaviors behavior,
-                         unique_function_base<R, Args...>& who, void* ret)
-        -> void
+    static auto dispatch(unique_function_behaviors behavior, Base& who,
+                         void* ret) -> void
     {
       constexpr static bool fit_sm = fit_small<Func>;
-      void* data = fit_sm ? &who.storage_.small_ : who.storage_.large_;
 
       switch (behavior) {
       case detail::unique_function_behaviors::destory:
         if constexpr (fit_sm) {
-          static_cast<Func*>(data)->~Func();
+          std::launder(reinterpret_cast<Func*>(&who.storage_.small_))->~Func();
         } else {
-          delete static_cast<Func*>(who.storage_.large_);
+          auto [ptr, resource] = who.storage_.large_;
+          static_cast<Func*>(ptr)->~Func();
+          resource->deallocate(ptr, sizeof(Func), alignof(Func));
         }
         break;
       case detail::unique_function_behaviors::move_to: {
-        auto* func_ptr = static_cast<unique_function_base<R, Args...>*>(ret);
+        auto* func_ptr = static_cast<Base*>(ret);
         func_ptr->reset();
-        func_ptr->storage_.template emplace<Func>(
-            std::move(*static_cast<Func*>(data)));
-        func_ptr->behaviors_ = behaviors<R, Args...>::template dispatch<Func>;
-        func_ptr->function_ptr_ = behaviors<R, Args...>::template invoke<Func>;
-        who.reset();
+        if constexpr (fit_sm) {
+          auto* data =
+              std::launder(reinterpret_cast<Func*>(&who.storage_.small_));
+          ::new (static_cast<void*>(&func_ptr->storage_.small_))
+              Func(std::move(*data));
+          data->~Func();
+        } else {
+          // Heap allocated callables are moved by stealing the pointer
+          func_ptr->storage_.large_ = who.storage_.large_;
+        }
+        func_ptr->behaviors_ = who.behaviors_;
+        func_ptr->function_ptr_ = who.function_ptr_;
+        who.behaviors_ = nullptr;
+        who.function_ptr_ = nullptr;
       } break;
       }
     }
   };
 };
 
-template <typename R, typename... Args> struct unique_function_base {
+template <std::size_t inline_size, typename R, typename... Args>
+struct unique_function_base {
+  using Storage = detail::unique_function_storage<inline_size>;
+  using Behaviors = typename Storage::template behaviors<R, Args...>;
+  friend Storage;
+
 public:
   using result_type = R;
 
@@ -94,13 +164,20 @@ public:
                                std::is_move_constructible_v<DFunc>>>
   explicit unique_function_base(Func&& func)
   {
-    static_assert(std::is_invocable_r_v<R, DFunc, Args...>);
+    // Only callables that spill to the heap need a memory resource
+    MemoryResource* resource = nullptr;
+    if constexpr (!Storage::template fit_small<DFunc>) {
+      resource = &get_default_resource();
+    }
+    this->template construct<DFunc>(resource, std::forward<Func>(func));
+  }
 
-    storage_.emplace<DFunc>(std::forward<DFunc>(func));
-    behaviors_ = detail::unique_function_storage::behaviors<
-        R, Args...>::template dispatch<DFunc>;
-    function_ptr_ = detail::unique_function_storage::behaviors<
-        R, Args...>::template invoke<DFunc>;
+  template <typename Func, class DFunc = std::decay_t<Func>,
+            class = std::enable_if_t<std::is_move_constructible_v<DFunc>>>
+  unique_function_base(std::allocator_arg_t, MemoryResource& resource,
+                       Func&& func)
+  {
+    this->template construct<DFunc>(&resource, std::forward<Func>(func));
   }
 
   unique_function_base(const unique_function_base&) = delete;
@@ -109,7 +186,9 @@ public:
 
   unique_function_base(unique_function_base&& other) noexcept
   {
-    if (other) {
+    if (other.behaviors_ == Behaviors::trivial_dispatch) {
+      this->relocate_trivially_from(other);
+    } else if (other) {
       other.behaviors_(detail::unique_function_behaviors::move_to, other, this);
     }
   }
@@ -117,7 +196,11 @@ public:
   auto operator=(unique_function_base&& other) & noexcept
                                                  -> unique_function_base&
   {
-    if (other) {
+    if (this == &other) { return *this; }
+    if (other.behaviors_ == Behaviors::trivial_dispatch) {
+      this->reset();
+      this->relocate_trivially_from(other);
+    } else if (other) {
       other.behaviors_(detail::unique_function_behaviors::move_to, other, this);
     } else {
       this->reset();
@@ -137,6 +220,15 @@ public:
     *this = std::move(temp);
   }
 
+  /// @brief Returns true if a callable of type `Func` can be stored inline
+  template <typename Func>
+  static constexpr bool stores_inline = Storage::template fit_small<Func>;
+
+  /// @brief Returns true if moving a callable of type `Func` is a memcpy
+  template <typename Func>
+  static constexpr bool relocates_trivially =
+      Storage::template trivially_relocatable<Func>;
+
 protected:
   auto invoke(Args... args) const -> R
   {
@@ -152,29 +244,50 @@ protected:
   }
 
 private:
-  friend union detail::unique_function_storage;
-
   void (*behaviors_)(detail::unique_function_behaviors, unique_function_base&,
                      void*) = nullptr;
   R (*function_ptr_)(const unique_function_base&, Args&&...) = nullptr;
-  detail::unique_function_storage storage_;
+  Storage storage_;
 
   void reset()
   {
-    if (behaviors_) {
+    if (behaviors_ && behaviors_ != Behaviors::trivial_dispatch) {
       behaviors_(detail::unique_function_behaviors::destory, *this, nullptr);
     }
     function_ptr_ = nullptr;
     behaviors_ = nullptr;
   }
+
+  template <typename DFunc, typename Func>
+  void construct(MemoryResource* resource, Func&& func)
+  {
+    static_assert(std::is_invocable_r_v<R, DFunc, Args...>);
+
+    storage_.template emplace<DFunc>(resource, std::forward<Func>(func));
+    if constexpr (Storage::template trivially_relocatable<DFunc>) {
+      behaviors_ = Behaviors::trivial_dispatch;
+    } else {
+      behaviors_ = Behaviors::template dispatch<DFunc>;
+    }
+    function_ptr_ = Behaviors::template invoke<DFunc>;
+  }
+
+  // Takes over a trivially relocatable callable from other
+  // @pre this is empty
+  void relocate_trivially_from(unique_function_base& other) noexcept
+  {
+    storage_ = other.storage_;
+    behaviors_ = std::exchange(other.behaviors_, nullptr);
+    function_ptr_ = std::exchange(other.function_ptr_, nullptr);
+  }
 };
 
 } // namespace detail
 
-template <typename R, typename... Args>
-class unique_function<R(Args...)>
-    : public detail::unique_function_base<R, Args...> {
-  using base_type = detail::unique_function_base<R, Args...>;
+template <std::size_t inline_size, typename R, typename... Args>
+class unique_function<R(Args...), inline_size>
+    : public detail::unique_function_base<inline_size, R, Args...> {
+  using base_type = detail::unique_function_base<inline_size, R, Args...>;
 
 public:
   unique_function() = default;
@@ -186,7 +299,18 @@ public:
   {
   }
 
-  unique_function(unique_function<R(Args...) const>&& other)
+  /// @brief Constructs from `func` and allocate from `resource` if `func`
+  /// cannot be stored inline
+  template <typename Func, class DFunc = std::decay_t<Func>,
+            class = std::enable_if_t<!std::is_same_v<DFunc, unique_function> &&
+                                     std::is_move_constructible_v<DFunc>>>
+  unique_function(std::allocator_arg_t tag, MemoryResource& resource,
+                  Func&& func)
+      : base_type{tag, resource, std::forward<Func>(func)}
+  {
+  }
+
+  unique_function(unique_function<R(Args...) const, inline_size>&& other)
       : base_type{static_cast<base_type&&>(other)}
   {
   }
@@ -197,9 +321,11 @@ public:
   }
 };
 
-template <typename R, typename... Args>
-class unique_function<R(Args...) const>
-    : public detail::unique_function_base<R, Args...> {
+template <std::size_t inline_size, typename R, typename... Args>
+class unique_function<R(Args...) const, inline_size>
+    : public detail::unique_function_base<inline_size, R, Args...> {
+  using base_type = detail::unique_function_base<inline_size, R, Args...>;
+
 public:
   unique_function() = default;
 
@@ -208,8 +334,20 @@ public:
                                      std::is_move_constructible_v<DFunc>>,
             class = std::void_t<
                 decltype(std::declval<const Func&>()(std::declval<Args>()...))>>
-  explicit unique_function(Func&& func)
-      : detail::unique_function_base<R, Args...>{std::forward<Func>(func)}
+  explicit unique_function(Func&& func) : base_type{std::forward<Func>(func)}
+  {
+  }
+
+  /// @brief Constructs from `func` and allocate from `resource` if `func`
+  /// cannot be stored inline
+  template <typename Func, class DFunc = std::decay_t<Func>,
+            class = std::enable_if_t<!std::is_same_v<DFunc, unique_function> &&
+                                     std::is_move_constructible_v<DFunc>>,
+            class = std::void_t<
+                decltype(std::declval<const Func&>()(std::declval<Args>()...))>>
+  unique_function(std::allocator_arg_t tag, MemoryResource& resource,
+                  Func&& func)
+      : base_type{tag, resource, std::forward<Func>(func)}
   {
   }
 
@@ -219,37 +357,37 @@ public:
   }
 };
 
-template <class Func>
-auto swap(unique_function<Func>& lhs, unique_function<Func>& rhs) noexcept
-    -> void
+template <class Func, std::size_t inline_size>
+auto swap(unique_function<Func, inline_size>& lhs,
+          unique_function<Func, inline_size>& rhs) noexcept -> void
 {
   lhs.swap(rhs);
 }
 
-template <class Func>
-auto operator==(const unique_function<Func>& lhs, std::nullptr_t) noexcept
-    -> bool
+template <class Func, std::size_t inline_size>
+auto operator==(const unique_function<Func, inline_size>& lhs,
+                std::nullptr_t) noexcept -> bool
 {
   return !lhs;
 }
 
-template <class Func>
-auto operator==(std::nullptr_t, const unique_function<Func>& lhs) noexcept
-    -> bool
+template <class Func, std::size_t inline_size>
+auto operator==(std::nullptr_t,
+                const unique_function<Func, inline_size>& lhs) noexcept -> bool
 {
   return !lhs;
 }
 
-template <class Func>
-auto operator!=(const unique_function<Func>& lhs, std::nullptr_t) noexcept
-    -> bool
+template <class Func, std::size_t inline_size>
+auto operator!=(const unique_function<Func, inline_size>& lhs,
+                std::nullptr_t) noexcept -> bool
 {
   return lhs;
 }
 
-template <class Func>
-auto operator!=(std::nullptr_t, const unique_function<Func>& lhs) noexcept
-    -> bool
+template <class Func, std::size_t inline_size>
+auto operator!=(std::nullptr_t,
+                const unique_function<Func, inline_size>& lhs) noexcept -> bool
 {
   return lhs;
 }
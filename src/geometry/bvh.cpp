@@ -0,0 +1,549 @@
+#include "beyond/geometry/bvh.hpp"
+
+#include "beyond/concurrency/thread_pool.hpp"
+#include "beyond/geometry/detail/bvh_build.hpp"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+namespace beyond {
+
+namespace {
+
+// The maximum number of bins per axis when evaluating the surface area
+// heuristic. Nodes with fewer primitives use one bin per primitive
+constexpr std::size_t max_bin_count = 16;
+
+// Past this depth the builder splits at the median, so that the depth of the
+// tree stays below BVH::max_depth for any input
+constexpr std::size_t median_split_depth = 32;
+
+// The cost of visiting an interior node relative to testing a primitive
+constexpr float traversal_cost = 1.f;
+
+// The parallel builder builds nodes with at most this many primitives as
+// independent subtree tasks, and splits the nodes above it with data parallel
+// passes over chunks of at most this many primitives
+constexpr std::size_t parallel_grain_size = 16384;
+
+// A box that starts empty, unlike AABB3 which starts at the origin
+struct Bounds {
+  static constexpr float highest = std::numeric_limits<float>::max();
+  static constexpr float lowest = std::numeric_limits<float>::lowest();
+
+  std::array<float, 3> min{highest, highest, highest};
+  std::array<float, 3> max{lowest, lowest, lowest};
+
+  auto grow(const std::array<float, 3>& p) noexcept -> void
+  {
+    grow(Bounds{p, p});
+  }
+
+  auto grow(const Bounds& b) noexcept -> void
+  {
+    for (std::size_t i = 0; i < 3; ++i) {
+      min[i] = std::min(min[i], b.min[i]);
+      max[i] = std::max(max[i], b.max[i]);
+    }
+  }
+
+  [[nodiscard]] auto extent(std::size_t axis) const noexcept -> float
+  {
+    return max[axis] - min[axis];
+  }
+
+  [[nodiscard]] auto half_area() const noexcept -> float
+  {
+    const float x = extent(0);
+    const float y = extent(1);
+    const float z = extent(2);
+    return x * y + y * z + z * x;
+  }
+
+  [[nodiscard]] auto to_aabb() const noexcept -> AABB3
+  {
+    return AABB3{Point3{min[0], min[1], min[2]}, Point3{max[0], max[1], max[2]},
+                 AABB3::unchecked_tag};
+  }
+};
+
+auto to_bounds(const AABB3& box) noexcept -> Bounds
+{
+  return {{box.min().x, box.min().y, box.min().z},
+          {box.max().x, box.max().y, box.max().z}};
+}
+
+struct Bin {
+  Bounds bounds;
+  std::size_t count = 0;
+};
+
+using Bins = std::array<std::array<Bin, max_bin_count>, 3>;
+
+auto merge_into(Bins& bins, const Bins& other) noexcept -> void
+{
+  for (std::size_t axis = 0; axis < 3; ++axis) {
+    for (std::size_t i = 0; i < max_bin_count; ++i) {
+      bins[axis][i].bounds.grow(other[axis][i].bounds);
+      bins[axis][i].count += other[axis][i].count;
+    }
+  }
+}
+
+// The bounds of the primitives of a node and the bounds of their centroids
+struct NodeBounds {
+  Bounds bounds;
+  Bounds centroid_bounds;
+
+  auto grow(const NodeBounds& other) noexcept -> void
+  {
+    bounds.grow(other.bounds);
+    centroid_bounds.grow(other.centroid_bounds);
+  }
+};
+
+// Maps the centroids along an axis to bins of equal size
+class Binning {
+public:
+  Binning(const Bounds& centroid_bounds, std::size_t axis,
+          std::size_t bin_count) noexcept
+      : axis_min_{centroid_bounds.min[axis]}, bin_count_{bin_count}
+  {
+    // Slightly below bin_count / extent so that the maximum lands in the last
+    // bin
+    const float extent = centroid_bounds.extent(axis);
+    scale_ = extent > 0
+                 ? static_cast<float>(bin_count) * (1 - 1e-5f) / extent
+                 : 0;
+  }
+
+  [[nodiscard]] auto operator()(float centroid) const noexcept -> std::size_t
+  {
+    return std::min(bin_count_ - 1,
+                    static_cast<std::size_t>((centroid - axis_min_) * scale_));
+  }
+
+private:
+  float axis_min_;
+  float scale_;
+  std::size_t bin_count_;
+};
+
+using Binnings = std::array<Binning, 3>;
+
+struct Split {
+  std::size_t axis = 0;
+  std::size_t bin = 0;
+  float cost = std::numeric_limits<float>::max();
+};
+
+// The number of chunks the data parallel passes split [begin, end) into
+[[nodiscard]] auto chunk_count(std::size_t begin, std::size_t end) noexcept
+    -> std::size_t
+{
+  return (end - begin + parallel_grain_size - 1) / parallel_grain_size;
+}
+
+/*
+ * The builder partitions primitive indices in place. Partitions are stable, so
+ * the parallel builder, which splits large nodes with data parallel passes,
+ * produces the same tree as the sequential one for any number of threads.
+ */
+class Builder {
+public:
+  Builder(std::span<const AABB3> boxes, std::size_t max_leaf_size,
+          std::vector<std::uint32_t>& indices)
+      : max_leaf_size_{max_leaf_size}, indices_{indices}
+  {
+    bounds_.reserve(boxes.size());
+    centroids_.reserve(boxes.size());
+    for (const AABB3& box : boxes) {
+      const Point3 c = box.min() + (box.max() - box.min()) * 0.5f;
+      bounds_.push_back(to_bounds(box));
+      centroids_.push_back({c.x, c.y, c.z});
+    }
+
+    indices_.resize(boxes.size());
+    std::iota(indices_.begin(), indices_.end(), std::uint32_t{0});
+    scratch_.resize(boxes.size());
+  }
+
+  // Builds the subtree over the primitives in [begin, end) and appends its
+  // nodes to `nodes`. Child indices are relative to the start of `nodes`
+  auto build(std::size_t begin, std::size_t end, std::size_t depth,
+             std::vector<BVH::Node>& nodes) -> void
+  {
+    const std::size_t node_index = nodes.size();
+    nodes.emplace_back();
+
+    const NodeBounds node = node_bounds(begin, end);
+    nodes[node_index].bounds = node.bounds.to_aabb();
+
+    const std::size_t mid = split(
+        begin, end, depth, node,
+        [&](const Binnings& binnings) {
+          Bins bins;
+          bin(begin, end, binnings, bins);
+          return best_split(bins, node.centroid_bounds, end - begin);
+        },
+        [&](const auto& goes_left) {
+          return stable_partition(begin, end, goes_left);
+        });
+    if (mid == begin) {
+      nodes[node_index].offset = static_cast<std::uint32_t>(begin);
+      nodes[node_index].primitive_count =
+          static_cast<std::uint32_t>(end - begin);
+      return;
+    }
+
+    build(begin, mid, depth + 1, nodes);
+    nodes[node_index].offset = static_cast<std::uint32_t>(nodes.size());
+    build(mid, end, depth + 1, nodes);
+  }
+
+  // Splits the nodes with more than parallel_grain_size primitives with data
+  // parallel passes on the calling thread, then builds the subtrees below them
+  // as independent tasks and stitches everything together in depth-first
+  // order
+  auto build_parallel(ThreadPool& pool, std::vector<BVH::Node>& nodes) -> void
+  {
+    std::vector<detail::BVHTopNode> top_nodes;
+    std::vector<detail::BVHSubtree> subtrees;
+    build_top(pool, 0, indices_.size(), 0, top_nodes, subtrees);
+
+    // Starts the largest subtrees first to balance the load
+    std::vector<std::size_t> order(subtrees.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::ranges::sort(order, [&](std::size_t lhs, std::size_t rhs) {
+      return subtrees[lhs].end - subtrees[lhs].begin >
+             subtrees[rhs].end - subtrees[rhs].begin;
+    });
+    parallel_for(&pool, order.size(), [&](std::size_t i) {
+      detail::BVHSubtree& subtree = subtrees[order[i]];
+      subtree.nodes.reserve(2 * (subtree.end - subtree.begin));
+      build(subtree.begin, subtree.end, subtree.depth, subtree.nodes);
+    });
+
+    detail::stitch_bvh_subtrees(pool, top_nodes, subtrees, nodes);
+  }
+
+private:
+  std::size_t max_leaf_size_;
+  std::vector<std::uint32_t>& indices_;
+  std::vector<Bounds> bounds_;
+  std::vector<std::array<float, 3>> centroids_;
+  std::vector<std::uint32_t> scratch_;
+
+  // Builds the top of the tree and returns the index of the created node in
+  // `top_nodes`. The top of the tree is laid out left child first, the same
+  // as the final tree
+  auto build_top(ThreadPool& pool, std::size_t begin, std::size_t end,
+                 std::size_t depth,
+                 std::vector<detail::BVHTopNode>& top_nodes,
+                 std::vector<detail::BVHSubtree>& subtrees) -> std::size_t
+  {
+    const std::size_t top_index = top_nodes.size();
+    top_nodes.emplace_back();
+    if (end - begin <= std::max(parallel_grain_size, max_leaf_size_)) {
+      top_nodes[top_index].subtree = subtrees.size();
+      subtrees.push_back(detail::BVHSubtree{begin, end, depth, {}, 0});
+      return top_index;
+    }
+
+    const NodeBounds node = parallel_node_bounds(pool, begin, end);
+    top_nodes[top_index].bounds = node.bounds.to_aabb();
+    const std::size_t mid = split(
+        begin, end, depth, node,
+        [&](const Binnings& binnings) {
+          return best_split(parallel_bin(pool, begin, end, binnings),
+                            node.centroid_bounds, end - begin);
+        },
+        [&](const auto& goes_left) {
+          return parallel_stable_partition(pool, begin, end, goes_left);
+        });
+    // Nodes above max_leaf_size_ primitives are never leaves
+    BEYOND_ASSERT(mid != begin);
+
+    build_top(pool, begin, mid, depth + 1, top_nodes, subtrees);
+    const std::size_t right =
+        build_top(pool, mid, end, depth + 1, top_nodes, subtrees);
+    top_nodes[top_index].right = right;
+    return top_index;
+  }
+
+  [[nodiscard]] auto node_bounds(std::size_t begin, std::size_t end) const
+      -> NodeBounds
+  {
+    NodeBounds node;
+    for (std::size_t i = begin; i < end; ++i) {
+      node.bounds.grow(bounds_[indices_[i]]);
+      node.centroid_bounds.grow(centroids_[indices_[i]]);
+    }
+    return node;
+  }
+
+  [[nodiscard]] auto parallel_node_bounds(ThreadPool& pool, std::size_t begin,
+                                          std::size_t end) const -> NodeBounds
+  {
+    std::vector<NodeBounds> chunks(chunk_count(begin, end));
+    parallel_for_chunks(
+        &pool, chunks.size(), begin, end,
+        [&](std::size_t chunk, std::size_t first, std::size_t last) {
+          chunks[chunk] = node_bounds(first, last);
+        });
+    NodeBounds node;
+    for (const NodeBounds& chunk : chunks) { node.grow(chunk); }
+    return node;
+  }
+
+  // Bins the primitives along all axes in a single pass
+  auto bin(std::size_t begin, std::size_t end, const Binnings& binnings,
+           Bins& bins) const -> void
+  {
+    for (std::size_t i = begin; i < end; ++i) {
+      const std::uint32_t index = indices_[i];
+      for (std::size_t axis = 0; axis < 3; ++axis) {
+        Bin& b = bins[axis][binnings[axis](centroids_[index][axis])];
+        b.bounds.grow(bounds_[index]);
+        ++b.count;
+      }
+    }
+  }
+
+  [[nodiscard]] auto parallel_bin(ThreadPool& pool, std::size_t begin,
+                                  std::size_t end,
+                                  const Binnings& binnings) const -> Bins
+  {
+    std::vector<Bins> chunks(chunk_count(begin, end));
+    parallel_for_chunks(
+        &pool, chunks.size(), begin, end,
+        [&](std::size_t chunk, std::size_t first, std::size_t last) {
+          bin(first, last, binnings, chunks[chunk]);
+        });
+    Bins bins;
+    for (const Bins& chunk : chunks) { merge_into(bins, chunk); }
+    return bins;
+  }
+
+  // Moves the primitives for which `goes_left` is true to the front while
+  // keeping their order, and returns the first primitive of the right side
+  template <typename Pred>
+  auto stable_partition(std::size_t begin, std::size_t end,
+                        const Pred& goes_left) -> std::size_t
+  {
+    std::size_t left = begin;
+    std::size_t right = begin;
+    for (std::size_t i = begin; i < end; ++i) {
+      const std::uint32_t index = indices_[i];
+      if (goes_left(index)) {
+        indices_[left++] = index;
+      } else {
+        scratch_[right++] = index;
+      }
+    }
+    std::copy(scratch_.begin() + static_cast<std::ptrdiff_t>(begin),
+              scratch_.begin() + static_cast<std::ptrdiff_t>(right),
+              indices_.begin() + static_cast<std::ptrdiff_t>(left));
+    return left;
+  }
+
+  // Same as stable_partition. Every chunk counts its left primitives, then
+  // scatters its primitives to the scratch buffer at the offsets given by the
+  // counts of the chunks before it
+  template <typename Pred>
+  auto parallel_stable_partition(ThreadPool& pool, std::size_t begin,
+                                 std::size_t end, const Pred& goes_left)
+      -> std::size_t
+  {
+    std::vector<std::size_t> left_counts(chunk_count(begin, end));
+    parallel_for_chunks(
+        &pool, left_counts.size(), begin, end,
+        [&](std::size_t chunk, std::size_t first, std::size_t last) {
+          left_counts[chunk] = static_cast<std::size_t>(std::count_if(
+              indices_.begin() + static_cast<std::ptrdiff_t>(first),
+              indices_.begin() + static_cast<std::ptrdiff_t>(last),
+              goes_left));
+        });
+
+    const std::size_t mid =
+        begin + std::accumulate(left_counts.begin(), left_counts.end(),
+                                std::size_t{0});
+    std::vector<std::size_t> left_offsets(left_counts.size());
+    std::exclusive_scan(left_counts.begin(), left_counts.end(),
+                        left_offsets.begin(), begin);
+
+    parallel_for_chunks(
+        &pool, left_counts.size(), begin, end,
+        [&](std::size_t chunk, std::size_t first, std::size_t last) {
+          std::size_t left = left_offsets[chunk];
+          // The right primitives of the chunks before this one
+          std::size_t right = mid + (first - begin) - (left - begin);
+          for (std::size_t i = first; i < last; ++i) {
+            const std::uint32_t index = indices_[i];
+            scratch_[goes_left(index) ? left++ : right++] = index;
+          }
+        });
+    parallel_for_chunks(
+        &pool, left_counts.size(), begin, end,
+        [&](std::size_t, std::size_t first, std::size_t last) {
+          std::copy(scratch_.begin() + static_cast<std::ptrdiff_t>(first),
+                    scratch_.begin() + static_cast<std::ptrdiff_t>(last),
+                    indices_.begin() + static_cast<std::ptrdiff_t>(first));
+        });
+    return mid;
+  }
+
+  [[nodiscard]] static auto bin_count_for(std::size_t count) noexcept
+      -> std::size_t
+  {
+    return std::min(count, max_bin_count);
+  }
+
+  // Finds the split between bins with the lowest surface area heuristic cost.
+  // The split is after bin `Split::bin`
+  [[nodiscard]] static auto best_split(const Bins& bins,
+                                       const Bounds& centroid_bounds,
+                                       std::size_t count) -> Split
+  {
+    const std::size_t bin_count = bin_count_for(count);
+    Split best;
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+      if (centroid_bounds.extent(axis) <= 0) { continue; }
+
+      // Sweeps from the right to get the cost of the right sides, then from
+      // the left to add the cost of the left sides
+      std::array<float, max_bin_count - 1> costs{};
+      Bounds right_bounds;
+      std::size_t right_count = 0;
+      for (std::size_t i = bin_count - 1; i > 0; --i) {
+        right_bounds.grow(bins[axis][i].bounds);
+        right_count += bins[axis][i].count;
+        costs[i - 1] = right_count == 0 ? 0
+                                        : right_bounds.half_area() *
+                                              static_cast<float>(right_count);
+      }
+      Bounds left_bounds;
+      std::size_t left_count = 0;
+      for (std::size_t i = 0; i < bin_count - 1; ++i) {
+        left_bounds.grow(bins[axis][i].bounds);
+        left_count += bins[axis][i].count;
+        if (left_count == 0 || left_count == count) { continue; }
+        const float cost =
+            costs[i] + left_bounds.half_area() * static_cast<float>(left_count);
+        if (cost < best.cost) { best = Split{axis, i, cost}; }
+      }
+    }
+    return best;
+  }
+
+  // Decides how to split a node and partitions its primitives. Returns the
+  // start of the right child, or `begin` if the node should be a leaf.
+  // `find_split(binnings)` finds the best SAH split and `partition(goes_left)`
+  // partitions the primitives of the node
+  template <typename FindSplit, typename Partition>
+  auto split(std::size_t begin, std::size_t end, std::size_t depth,
+             const NodeBounds& node, const FindSplit& find_split,
+             const Partition& partition) -> std::size_t
+  {
+    const std::size_t count = end - begin;
+    if (count == 1) { return begin; }
+
+    const Bounds& centroid_bounds = node.centroid_bounds;
+    std::size_t largest_axis = 0;
+    for (std::size_t axis = 1; axis < 3; ++axis) {
+      if (centroid_bounds.extent(axis) > centroid_bounds.extent(largest_axis)) {
+        largest_axis = axis;
+      }
+    }
+    if (centroid_bounds.extent(largest_axis) <= 0) {
+      // All centroids coincide, so any split is as good as another
+      return count <= max_leaf_size_ ? begin : begin + count / 2;
+    }
+
+    if (depth >= median_split_depth) {
+      return median_split(begin, end, largest_axis);
+    }
+
+    const std::size_t bin_count = bin_count_for(count);
+    const Binnings binnings{Binning{centroid_bounds, 0, bin_count},
+                            Binning{centroid_bounds, 1, bin_count},
+                            Binning{centroid_bounds, 2, bin_count}};
+    const Split best = find_split(binnings);
+    const float leaf_cost = static_cast<float>(count);
+    const float split_cost =
+        traversal_cost +
+        best.cost / std::max(node.bounds.half_area(),
+                             std::numeric_limits<float>::min());
+    if (count <= max_leaf_size_ && leaf_cost <= split_cost) { return begin; }
+
+    const Binning& binning = binnings[best.axis];
+    const std::size_t mid = partition([&](std::uint32_t index) {
+      return binning(centroids_[index][best.axis]) <= best.bin;
+    });
+    if (mid == begin || mid == end) {
+      return median_split(begin, end, largest_axis);
+    }
+    return mid;
+  }
+
+  auto median_split(std::size_t begin, std::size_t end, std::size_t axis)
+      -> std::size_t
+  {
+    const std::size_t mid = begin + (end - begin) / 2;
+    std::nth_element(indices_.begin() + static_cast<std::ptrdiff_t>(begin),
+                     indices_.begin() + static_cast<std::ptrdiff_t>(mid),
+                     indices_.begin() + static_cast<std::ptrdiff_t>(end),
+                     [&](std::uint32_t lhs, std::uint32_t rhs) {
+                       return centroids_[lhs][axis] < centroids_[rhs][axis];
+                     });
+    return mid;
+  }
+};
+
+} // anonymous namespace
+
+BVH::BVH(std::span<const AABB3> boxes, std::size_t max_leaf_size)
+{
+  BEYOND_ASSERT(max_leaf_size > 0);
+  BEYOND_ASSERT(boxes.size() < std::numeric_limits<std::uint32_t>::max());
+  if (boxes.empty()) { return; }
+
+  Builder builder{boxes, max_leaf_size, primitive_indices_};
+  // A binary tree with at most one primitive per leaf
+  nodes_.reserve(2 * boxes.size());
+  builder.build(0, boxes.size(), 0, nodes_);
+  nodes_.shrink_to_fit();
+}
+
+BVH::BVH(std::span<const AABB3> boxes, ThreadPool& pool,
+         std::size_t max_leaf_size)
+{
+  BEYOND_ASSERT(max_leaf_size > 0);
+  BEYOND_ASSERT(boxes.size() < std::numeric_limits<std::uint32_t>::max());
+  if (boxes.empty()) { return; }
+
+  Builder builder{boxes, max_leaf_size, primitive_indices_};
+  builder.build_parallel(pool, nodes_);
+}
+
+auto BVH::intersect(const Ray& ray, std::span<const AABB3> boxes, float t_min,
+                    float t_max) const -> optional<Hit>
+{
+  const Point3& origin = ray.origin;
+  const Vec3 inv_direction{1 / ray.direction.x, 1 / ray.direction.y,
+                           1 / ray.direction.z};
+  return intersect(ray, t_min, t_max,
+                   [&](std::uint32_t primitive, float t_near,
+                       float t_far) -> optional<float> {
+                     BEYOND_ASSERT(primitive < boxes.size());
+                     const float t = detail::ray_box_entry(
+                         boxes[primitive], origin, inv_direction, t_near, t_far);
+                     if (t == std::numeric_limits<float>::infinity()) {
+                       return nullopt;
+                     }
+                     return t;
+                   });
+}
+
+} // namespace beyond
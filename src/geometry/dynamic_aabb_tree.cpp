@@ -0,0 +1,301 @@
+#include "beyond/geometry/dynamic_aabb_tree.hpp"
+
+#include <algorithm>
+
+namespace beyond {
+
+namespace {
+
+// How far ahead of the displacement of a moving object its fat AABB extends
+constexpr float displacement_multiplier = 2.f;
+
+// A fat AABB is reinserted when it becomes larger than a fresh one enlarged by
+// this many margins, for example after a fast object stops
+constexpr float huge_margin_multiplier = 4.f;
+
+[[nodiscard]] auto enlarge(const AABB3& box, float margin) noexcept -> AABB3
+{
+  const Vec3 r{margin, margin, margin};
+  return AABB3{box.min() - r, box.max() + r, AABB3::unchecked_tag};
+}
+
+} // anonymous namespace
+
+auto DynamicAABBTree::insert(const AABB3& box, std::uint64_t user_data)
+    -> AABBProxy
+{
+  const std::uint32_t leaf = allocate_node();
+  nodes_[leaf].bounds = enlarge(box, margin_);
+  nodes_[leaf].user_data = user_data;
+  nodes_[leaf].height = 0;
+  insert_leaf(leaf);
+  ++size_;
+  return proxy_of(leaf);
+}
+
+auto DynamicAABBTree::remove(AABBProxy proxy) -> void
+{
+  BEYOND_ASSERT(contains(proxy));
+  const std::uint32_t leaf = proxy.index();
+  remove_leaf(leaf);
+  free_node(leaf);
+  --size_;
+}
+
+auto DynamicAABBTree::move(AABBProxy proxy, const AABB3& box,
+                           const Vec3& displacement) -> bool
+{
+  BEYOND_ASSERT(contains(proxy));
+  const std::uint32_t leaf = proxy.index();
+
+  const AABB3 fat = enlarge(box, margin_);
+  Point3 min = fat.min();
+  Point3 max = fat.max();
+  const Vec3 d = displacement * displacement_multiplier;
+  (d.x < 0 ? min.x : max.x) += d.x;
+  (d.y < 0 ? min.y : max.y) += d.y;
+  (d.z < 0 ? min.z : max.z) += d.z;
+  const AABB3 predicted{min, max, AABB3::unchecked_tag};
+
+  const AABB3& tree_box = nodes_[leaf].bounds;
+  if (beyond::contains(tree_box, box)) {
+    const AABB3 huge = enlarge(predicted, huge_margin_multiplier * margin_);
+    if (beyond::contains(huge, tree_box)) { return false; }
+  }
+
+  remove_leaf(leaf);
+  nodes_[leaf].bounds = predicted;
+  insert_leaf(leaf);
+  return true;
+}
+
+auto DynamicAABBTree::is_valid() const -> bool
+{
+  std::size_t free_count = 0;
+  for (std::uint32_t i = free_list_; i != null_node; i = nodes_[i].parent) {
+    if (i >= nodes_.size() || nodes_[i].height != -1) { return false; }
+    ++free_count;
+  }
+  const auto leaf_count = static_cast<std::size_t>(std::ranges::count_if(
+      nodes_, [](const Node& node) { return node.is_leaf(); }));
+  if (leaf_count != size_) { return false; }
+
+  if (root_ == null_node) { return size_ == 0; }
+  // A tree with n leaves has n - 1 interior nodes
+  if (free_count + 2 * size_ - 1 != nodes_.size()) { return false; }
+  return nodes_[root_].parent == null_node && validate(root_);
+}
+
+auto DynamicAABBTree::validate(std::uint32_t index) const -> bool
+{
+  const Node& node = nodes_[index];
+  if (node.is_leaf()) {
+    return node.child1 == null_node && node.child2 == null_node;
+  }
+  if (node.height < 1) { return false; }
+
+  const Node& child1 = nodes_[node.child1];
+  const Node& child2 = nodes_[node.child2];
+  return child1.parent == index && child2.parent == index &&
+         node.height == 1 + std::max(child1.height, child2.height) &&
+         node.bounds == merge(child1.bounds, child2.bounds) &&
+         validate(node.child1) && validate(node.child2);
+}
+
+auto DynamicAABBTree::allocate_node() -> std::uint32_t
+{
+  std::uint32_t index = free_list_;
+  if (index != null_node) {
+    free_list_ = nodes_[index].parent;
+  } else {
+    index = static_cast<std::uint32_t>(nodes_.size());
+    BEYOND_ENSURE(!AABBProxy::is_overflow(index));
+    nodes_.emplace_back();
+  }
+
+  Node& node = nodes_[index];
+  node.user_data = 0;
+  node.parent = null_node;
+  node.child1 = null_node;
+  node.child2 = null_node;
+  node.height = 0;
+  return index;
+}
+
+auto DynamicAABBTree::free_node(std::uint32_t index) -> void
+{
+  Node& node = nodes_[index];
+  // Invalidates the proxies that refer to this node
+  ++node.generation;
+  node.height = -1;
+  node.child1 = null_node;
+  node.child2 = null_node;
+  node.parent = free_list_;
+  free_list_ = index;
+}
+
+auto DynamicAABBTree::insert_leaf(std::uint32_t leaf) -> void
+{
+  if (root_ == null_node) {
+    root_ = leaf;
+    nodes_[leaf].parent = null_node;
+    return;
+  }
+
+  // Descends to the sibling that increases the surface area the least
+  const AABB3 leaf_box = nodes_[leaf].bounds;
+  std::uint32_t index = root_;
+  while (!nodes_[index].is_leaf()) {
+    const Node& node = nodes_[index];
+    const float area = half_surface_area(node.bounds);
+    const float combined_area =
+        half_surface_area(merge(node.bounds, leaf_box));
+
+    // The cost of making a new parent for this node and the new leaf
+    const float cost = 2 * combined_area;
+    // The minimum cost of pushing the leaf further down the tree
+    const float inheritance_cost = 2 * (combined_area - area);
+
+    const auto descend_cost = [&](std::uint32_t child) {
+      const Node& c = nodes_[child];
+      const float merged_area = half_surface_area(merge(leaf_box, c.bounds));
+      return (c.is_leaf() ? merged_area
+                          : merged_area - half_surface_area(c.bounds)) +
+             inheritance_cost;
+    };
+    const float cost1 = descend_cost(node.child1);
+    const float cost2 = descend_cost(node.child2);
+
+    if (cost < cost1 && cost < cost2) { break; }
+    index = cost1 < cost2 ? node.child1 : node.child2;
+  }
+  const std::uint32_t sibling = index;
+
+  const std::uint32_t old_parent = nodes_[sibling].parent;
+  const std::uint32_t new_parent = allocate_node();
+  Node& parent = nodes_[new_parent];
+  parent.parent = old_parent;
+  parent.bounds = merge(leaf_box, nodes_[sibling].bounds);
+  parent.height = nodes_[sibling].height + 1;
+  parent.child1 = sibling;
+  parent.child2 = leaf;
+  nodes_[sibling].parent = new_parent;
+  nodes_[leaf].parent = new_parent;
+
+  if (old_parent == null_node) {
+    root_ = new_parent;
+  } else if (nodes_[old_parent].child1 == sibling) {
+    nodes_[old_parent].child1 = new_parent;
+  } else {
+    nodes_[old_parent].child2 = new_parent;
+  }
+
+  // Walks back up the tree to fix the heights and bounds
+  index = nodes_[leaf].parent;
+  while (index != null_node) {
+    index = balance(index);
+    Node& node = nodes_[index];
+    const Node& child1 = nodes_[node.child1];
+    const Node& child2 = nodes_[node.child2];
+    node.height = 1 + std::max(child1.height, child2.height);
+    node.bounds = merge(child1.bounds, child2.bounds);
+    index = node.parent;
+  }
+}
+
+auto DynamicAABBTree::remove_leaf(std::uint32_t leaf) -> void
+{
+  if (leaf == root_) {
+    root_ = null_node;
+    return;
+  }
+
+  const std::uint32_t parent = nodes_[leaf].parent;
+  const std::uint32_t grand_parent = nodes_[parent].parent;
+  const std::uint32_t sibling = nodes_[parent].child1 == leaf
+                                    ? nodes_[parent].child2
+                                    : nodes_[parent].child1;
+  free_node(parent);
+
+  if (grand_parent == null_node) {
+    root_ = sibling;
+    nodes_[sibling].parent = null_node;
+    return;
+  }
+
+  // Replaces the parent with the sibling
+  if (nodes_[grand_parent].child1 == parent) {
+    nodes_[grand_parent].child1 = sibling;
+  } else {
+    nodes_[grand_parent].child2 = sibling;
+  }
+  nodes_[sibling].parent = grand_parent;
+
+  std::uint32_t index = grand_parent;
+  while (index != null_node) {
+    index = balance(index);
+    Node& node = nodes_[index];
+    const Node& child1 = nodes_[node.child1];
+    const Node& child2 = nodes_[node.child2];
+    node.height = 1 + std::max(child1.height, child2.height);
+    node.bounds = merge(child1.bounds, child2.bounds);
+    index = node.parent;
+  }
+}
+
+// Rotates the taller child of node A up if the heights of the children of A
+// differ by more than one. Returns the index of the node now at the place of A
+auto DynamicAABBTree::balance(std::uint32_t index_a) -> std::uint32_t
+{
+  Node& a = nodes_[index_a];
+  if (a.is_leaf() || a.height < 2) { return index_a; }
+
+  const std::uint32_t index_b = a.child1;
+  const std::uint32_t index_c = a.child2;
+  Node& b = nodes_[index_b];
+  Node& c = nodes_[index_c];
+
+  // Makes `up`, a child of A, the parent of A. The taller child of `up`
+  // stays with it and the shorter one goes to A in place of `up`
+  const auto rotate_up = [&](std::uint32_t index_up, Node& up, Node& other,
+                             std::uint32_t& a_slot) {
+    const std::uint32_t index_f = up.child1;
+    const std::uint32_t index_g = up.child2;
+    Node& f = nodes_[index_f];
+    Node& g = nodes_[index_g];
+
+    up.child1 = index_a;
+    up.parent = a.parent;
+    a.parent = index_up;
+
+    if (up.parent == null_node) {
+      root_ = index_up;
+    } else if (nodes_[up.parent].child1 == index_a) {
+      nodes_[up.parent].child1 = index_up;
+    } else {
+      nodes_[up.parent].child2 = index_up;
+    }
+
+    const bool f_taller = f.height > g.height;
+    const std::uint32_t index_taller = f_taller ? index_f : index_g;
+    const std::uint32_t index_shorter = f_taller ? index_g : index_f;
+    Node& taller = nodes_[index_taller];
+    Node& shorter = nodes_[index_shorter];
+
+    up.child2 = index_taller;
+    a_slot = index_shorter;
+    shorter.parent = index_a;
+    a.bounds = merge(other.bounds, shorter.bounds);
+    up.bounds = merge(a.bounds, taller.bounds);
+    a.height = 1 + std::max(other.height, shorter.height);
+    up.height = 1 + std::max(a.height, taller.height);
+    return index_up;
+  };
+
+  const std::int32_t balance_factor = c.height - b.height;
+  if (balance_factor > 1) { return rotate_up(index_c, c, b, a.child2); }
+  if (balance_factor < -1) { return rotate_up(index_b, b, c, a.child1); }
+  return index_a;
+}
+
+} // namespace beyond
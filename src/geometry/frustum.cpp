@@ -0,0 +1,169 @@
+#include "beyond/geometry/frustum.hpp"
+#include "beyond/geometry/ray_packet.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace beyond {
+
+namespace {
+
+#ifdef BEYOND_SIMD_AVX
+constexpr std::size_t lane_count = 8;
+#else
+constexpr std::size_t lane_count = 4;
+#endif
+using Lanes = WideFloat<lane_count>;
+using LaneMask = WideMask<lane_count>;
+
+// A frustum plane with every component broadcast to all lanes
+struct WidePlane {
+  Lanes nx, ny, nz, d;
+  // The absolute values of the normal, to project box extents on it
+  Lanes abs_nx, abs_ny, abs_nz;
+
+  explicit WidePlane(const Frustum::Plane& plane) noexcept
+      : nx{plane.normal.x},
+        ny{plane.normal.y},
+        nz{plane.normal.z},
+        d{plane.distance},
+        abs_nx{std::abs(plane.normal.x)},
+        abs_ny{std::abs(plane.normal.y)},
+        abs_nz{std::abs(plane.normal.z)}
+  {
+  }
+};
+
+auto wide_planes(std::span<const Frustum::Plane, 6> planes) noexcept
+    -> std::array<WidePlane, 6>
+{
+  return {WidePlane{planes[0]}, WidePlane{planes[1]}, WidePlane{planes[2]},
+          WidePlane{planes[3]}, WidePlane{planes[4]}, WidePlane{planes[5]}};
+}
+
+// Writes the first `count` lanes of `visible_lanes` to `visible`, and returns
+// how many of them are set
+auto write_lanes(LaneMask visible_lanes, std::size_t count,
+                 bool* visible) noexcept -> std::size_t
+{
+  const unsigned bits = visible_lanes.bits() & ((1u << count) - 1);
+  for (std::size_t i = 0; i < count; ++i) {
+    visible[i] = (bits >> i & 1u) != 0;
+  }
+  return static_cast<std::size_t>(std::popcount(bits));
+}
+
+} // anonymous namespace
+
+Frustum::Frustum(const Mat4& view_projection, ClipDepth depth) noexcept
+{
+  // Gribb and Hartmann, "Fast Extraction of Viewing Frustum Planes from the
+  // World-View-Projection Matrix". Each clip plane such as x >= -w is a
+  // combination of the rows of the matrix
+  const auto row = [&](std::size_t i) {
+    return Vec4{view_projection(i, 0), view_projection(i, 1),
+                view_projection(i, 2), view_projection(i, 3)};
+  };
+  const Vec4 x = row(0);
+  const Vec4 y = row(1);
+  const Vec4 z = row(2);
+  const Vec4 w = row(3);
+
+  const std::array<Vec4, 6> coefficients = {
+      w + x, w - x, w + y, w - y,
+      depth == ClipDepth::zero_to_one ? z : w + z, w - z};
+  for (std::size_t i = 0; i < planes_.size(); ++i) {
+    const Vec4& c = coefficients[i];
+    const Vec3 normal{c.x, c.y, c.z};
+    const float inv_length = 1 / normal.length();
+    planes_[i] = Plane{normal * inv_length, c.w * inv_length};
+  }
+}
+
+auto Frustum::classify(const AABB3& box) const noexcept -> Containment
+{
+  // Same operations as the SIMD version, so that both agree on every box
+  const Point3 min = box.min();
+  const Point3 max = box.max();
+  const Point3 center{(min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f,
+                      (min.z + max.z) * 0.5f};
+  const Vec3 extent{(max.x - min.x) * 0.5f, (max.y - min.y) * 0.5f,
+                    (max.z - min.z) * 0.5f};
+
+  Containment result = Containment::inside;
+  for (const Plane& plane : planes_) {
+    const float distance = plane.signed_distance(center);
+    const float radius = std::abs(plane.normal.x) * extent.x +
+                         std::abs(plane.normal.y) * extent.y +
+                         std::abs(plane.normal.z) * extent.z;
+    if (distance < -radius) { return Containment::outside; }
+    if (distance < radius) { result = Containment::intersecting; }
+  }
+  return result;
+}
+
+auto Frustum::intersects(std::span<const AABB3> boxes,
+                         std::span<bool> visible) const noexcept -> std::size_t
+{
+  BEYOND_ASSERT(visible.size() >= boxes.size());
+  const std::array<WidePlane, 6> planes = wide_planes(planes_);
+  const Lanes half{0.5f};
+
+  std::size_t visible_count = 0;
+  for (std::size_t first = 0; first < boxes.size(); first += lane_count) {
+    const std::size_t count = std::min(lane_count, boxes.size() - first);
+    const WideAABB3<lane_count> wide{boxes.subspan(first, count)};
+    const Lanes cx = (wide.min.x + wide.max.x) * half;
+    const Lanes cy = (wide.min.y + wide.max.y) * half;
+    const Lanes cz = (wide.min.z + wide.max.z) * half;
+    const Lanes ex = (wide.max.x - wide.min.x) * half;
+    const Lanes ey = (wide.max.y - wide.min.y) * half;
+    const Lanes ez = (wide.max.z - wide.min.z) * half;
+
+    // Lanes are outside if they are behind any of the planes. NaN in the
+    // unused lanes does not matter since they are discarded
+    LaneMask outside{};
+    for (const WidePlane& p : planes) {
+      const Lanes distance = p.nx * cx + p.ny * cy + p.nz * cz + p.d;
+      const Lanes radius = p.abs_nx * ex + p.abs_ny * ey + p.abs_nz * ez;
+      outside = outside | (distance < -radius);
+    }
+    visible_count += write_lanes(!outside, count, visible.data() + first);
+  }
+  return visible_count;
+}
+
+auto Frustum::intersects(std::span<const Sphere> spheres,
+                         std::span<bool> visible) const noexcept -> std::size_t
+{
+  BEYOND_ASSERT(visible.size() >= spheres.size());
+  const std::array<WidePlane, 6> planes = wide_planes(planes_);
+
+  std::size_t visible_count = 0;
+  for (std::size_t first = 0; first < spheres.size(); first += lane_count) {
+    const std::size_t count = std::min(lane_count, spheres.size() - first);
+    std::array<float, lane_count> x{}, y{}, z{}, r{};
+    for (std::size_t i = 0; i < count; ++i) {
+      const Sphere& sphere = spheres[first + i];
+      x[i] = sphere.center.x;
+      y[i] = sphere.center.y;
+      z[i] = sphere.center.z;
+      r[i] = sphere.radius;
+    }
+    const Lanes cx = Lanes::load(x.data());
+    const Lanes cy = Lanes::load(y.data());
+    const Lanes cz = Lanes::load(z.data());
+    const Lanes neg_radius = -Lanes::load(r.data());
+
+    LaneMask outside{};
+    for (const WidePlane& p : planes) {
+      const Lanes distance = p.nx * cx + p.ny * cy + p.nz * cz + p.d;
+      outside = outside | (distance < neg_radius);
+    }
+    visible_count += write_lanes(!outside, count, visible.data() + first);
+  }
+  return visible_count;
+}
+
+} // namespace beyond
@@ -0,0 +1,223 @@
+#include "beyond/geometry/bvh.hpp"
+
+#include "beyond/algorithm/radix_sort.hpp"
+#include "beyond/concurrency/thread_pool.hpp"
+#include "beyond/geometry/detail/bvh_build.hpp"
+#include "beyond/geometry/morton.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <numeric>
+
+namespace beyond {
+
+namespace {
+
+// The parallel build gives each task at least this many primitives
+constexpr std::size_t parallel_grain_size = 16384;
+
+[[nodiscard]] auto centroid(const AABB3& box) noexcept -> Point3
+{
+  return box.min() + (box.max() - box.min()) * 0.5f;
+}
+
+/*
+ * Lauterbach et al., "Fast BVH Construction on GPUs". The primitives are
+ * sorted by Morton code, so the primitives of every node are a contiguous
+ * range of codes that share a common prefix, and a node is split between the
+ * codes whose next bit is 0 and the ones whose next bit is 1. Each split
+ * removes at least one bit from the differing suffix, and nodes whose codes
+ * are all the same are split in half, so the depth is at most 30 plus the
+ * logarithm of the number of primitives.
+ */
+class LinearBuilder {
+public:
+  LinearBuilder(std::span<const AABB3> boxes, std::size_t max_leaf_size,
+                std::vector<std::uint32_t>& indices, ThreadPool* pool)
+      : boxes_{boxes}, max_leaf_size_{max_leaf_size}, indices_{indices}
+  {
+    const std::size_t size = boxes.size();
+    std::size_t chunk_count = 1;
+    if (pool != nullptr) {
+      chunk_count =
+          std::clamp(size / parallel_grain_size, std::size_t{1}, pool->size());
+    }
+
+    std::vector<AABB3> chunk_bounds(chunk_count);
+    parallel_for_chunks(
+        pool, chunk_count, 0, size,
+        [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+          AABB3 bounds{centroid(boxes[begin])};
+          for (std::size_t i = begin + 1; i < end; ++i) {
+            bounds = merge(bounds, AABB3{centroid(boxes[i])});
+          }
+          chunk_bounds[chunk] = bounds;
+        });
+    const AABB3 centroid_bounds =
+        std::reduce(chunk_bounds.begin() + 1, chunk_bounds.end(),
+                    chunk_bounds.front(), [](const AABB3& a, const AABB3& b) {
+                      return merge(a, b);
+                    });
+
+    codes_.resize(size);
+    indices_.resize(size);
+    parallel_for_chunks(
+        pool, chunk_count, 0, size,
+        [&](std::size_t, std::size_t begin, std::size_t end) {
+          for (std::size_t i = begin; i < end; ++i) {
+            codes_[i] = morton_encode(centroid(boxes[i]), centroid_bounds);
+            indices_[i] = static_cast<std::uint32_t>(i);
+          }
+        });
+
+    if (pool != nullptr) {
+      radix_sort_by_key(std::span{codes_}, std::span{indices_}, *pool);
+    } else {
+      radix_sort_by_key(std::span{codes_}, std::span{indices_});
+    }
+  }
+
+  // Builds the subtree over the sorted primitives in [begin, end) and appends
+  // its nodes to `nodes`. Child indices are relative to the start of `nodes`
+  auto build(std::size_t begin, std::size_t end, std::size_t depth,
+             std::vector<BVH::Node>& nodes) const -> void
+  {
+    BEYOND_ASSERT(depth < BVH::max_depth);
+    const std::size_t node_index = nodes.size();
+    nodes.emplace_back();
+
+    const std::size_t mid = split(begin, end);
+    if (mid == begin) {
+      AABB3 bounds = boxes_[indices_[begin]];
+      for (std::size_t i = begin + 1; i < end; ++i) {
+        bounds = merge(bounds, boxes_[indices_[i]]);
+      }
+      nodes[node_index] =
+          BVH::Node{bounds, static_cast<std::uint32_t>(begin),
+                    static_cast<std::uint32_t>(end - begin)};
+      return;
+    }
+
+    build(begin, mid, depth + 1, nodes);
+    const std::size_t right = nodes.size();
+    build(mid, end, depth + 1, nodes);
+    nodes[node_index] =
+        BVH::Node{merge(nodes[node_index + 1].bounds, nodes[right].bounds),
+                  static_cast<std::uint32_t>(right), 0};
+  }
+
+  // Splits the top of the tree on the calling thread, then builds the
+  // subtrees below it as independent tasks and stitches everything together
+  // in depth-first order
+  auto build_parallel(ThreadPool& pool, std::vector<BVH::Node>& nodes) const
+      -> void
+  {
+    std::vector<detail::BVHTopNode> top_nodes;
+    std::vector<detail::BVHSubtree> subtrees;
+    build_top(0, indices_.size(), 0, top_nodes, subtrees);
+
+    parallel_for(&pool, subtrees.size(), [&](std::size_t i) {
+      detail::BVHSubtree& subtree = subtrees[i];
+      subtree.nodes.reserve(2 * (subtree.end - subtree.begin));
+      build(subtree.begin, subtree.end, subtree.depth, subtree.nodes);
+    });
+
+    // Children come after their parents, so going backwards visits them first
+    for (std::size_t i = top_nodes.size(); i-- > 0;) {
+      detail::BVHTopNode& top = top_nodes[i];
+      if (top.subtree != detail::BVHTopNode::none) {
+        top.bounds = subtrees[top.subtree].nodes.front().bounds;
+      } else {
+        top.bounds =
+            merge(top_nodes[i + 1].bounds, top_nodes[top.right].bounds);
+      }
+    }
+
+    detail::stitch_bvh_subtrees(pool, top_nodes, subtrees, nodes);
+  }
+
+private:
+  std::span<const AABB3> boxes_;
+  std::size_t max_leaf_size_;
+  std::vector<std::uint32_t>& indices_;
+  std::vector<std::uint32_t> codes_;
+
+  // Gets the start of the right child of the node over [begin, end), or
+  // `begin` if the node is a leaf
+  [[nodiscard]] auto split(std::size_t begin, std::size_t end) const noexcept
+      -> std::size_t
+  {
+    if (end - begin <= max_leaf_size_) { return begin; }
+
+    const std::uint32_t first = codes_[begin];
+    const std::uint32_t last = codes_[end - 1];
+    if (first == last) { return begin + (end - begin) / 2; }
+
+    // The codes of the right child start with the common prefix followed by a
+    // 1 bit
+    const std::uint32_t bit = std::bit_width(first ^ last) - 1;
+    const std::uint32_t right_first = last >> bit << bit;
+    return static_cast<std::size_t>(
+        std::lower_bound(codes_.begin() + static_cast<std::ptrdiff_t>(begin),
+                         codes_.begin() + static_cast<std::ptrdiff_t>(end),
+                         right_first) -
+        codes_.begin());
+  }
+
+  // Builds the top of the tree and returns the index of the created node in
+  // `top_nodes`. The top of the tree is laid out left child first, the same
+  // as the final tree
+  auto build_top(std::size_t begin, std::size_t end, std::size_t depth,
+                 std::vector<detail::BVHTopNode>& top_nodes,
+                 std::vector<detail::BVHSubtree>& subtrees) const
+      -> std::size_t
+  {
+    const std::size_t top_index = top_nodes.size();
+    top_nodes.emplace_back();
+    if (end - begin <= std::max(parallel_grain_size, max_leaf_size_)) {
+      top_nodes[top_index].subtree = subtrees.size();
+      subtrees.push_back(detail::BVHSubtree{begin, end, depth, {}, 0});
+      return top_index;
+    }
+
+    const std::size_t mid = split(begin, end);
+    // Nodes above max_leaf_size_ primitives are never leaves
+    BEYOND_ASSERT(mid != begin);
+
+    build_top(begin, mid, depth + 1, top_nodes, subtrees);
+    const std::size_t right =
+        build_top(mid, end, depth + 1, top_nodes, subtrees);
+    top_nodes[top_index].right = right;
+    return top_index;
+  }
+};
+
+} // anonymous namespace
+
+BVH::BVH(std::span<const AABB3> boxes, linear_tag_t,
+         std::size_t max_leaf_size)
+{
+  BEYOND_ASSERT(max_leaf_size > 0);
+  BEYOND_ASSERT(boxes.size() < std::numeric_limits<std::uint32_t>::max());
+  if (boxes.empty()) { return; }
+
+  const LinearBuilder builder{boxes, max_leaf_size, primitive_indices_,
+                              nullptr};
+  nodes_.reserve(2 * boxes.size());
+  builder.build(0, boxes.size(), 0, nodes_);
+  nodes_.shrink_to_fit();
+}
+
+BVH::BVH(std::span<const AABB3> boxes, linear_tag_t, ThreadPool& pool,
+         std::size_t max_leaf_size)
+{
+  BEYOND_ASSERT(max_leaf_size > 0);
+  BEYOND_ASSERT(boxes.size() < std::numeric_limits<std::uint32_t>::max());
+  if (boxes.empty()) { return; }
+
+  const LinearBuilder builder{boxes, max_leaf_size, primitive_indices_, &pool};
+  builder.build_parallel(pool, nodes_);
+}
+
+} // namespace beyond
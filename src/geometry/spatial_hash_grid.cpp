@@ -0,0 +1,111 @@
+#include "beyond/geometry/spatial_hash_grid.hpp"
+
+#include "beyond/algorithm/radix_sort.hpp"
+#include "beyond/concurrency/thread_pool.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <utility>
+
+namespace beyond {
+
+namespace {
+
+// The parallel rebuild gives each task at least this many points
+constexpr std::size_t parallel_grain_size = 16384;
+
+} // anonymous namespace
+
+auto SpatialHashGrid::resize(std::size_t point_count) -> std::size_t
+{
+  BEYOND_ASSERT(point_count <
+                std::size_t{std::numeric_limits<std::int32_t>::max()});
+
+  // About one bucket per point keeps collisions rare
+  const std::size_t bucket_count = std::bit_ceil(std::max(point_count,
+                                                          std::size_t{1}));
+  bucket_mask_ = static_cast<std::uint32_t>(bucket_count - 1);
+
+  point_buckets_.resize(point_count);
+  bucket_start_.resize(bucket_count + 1);
+  sorted_points_.resize(point_count);
+  sorted_indices_.resize(point_count);
+  return bucket_count;
+}
+
+auto SpatialHashGrid::rebuild(std::span<const Point3> points) -> void
+{
+  const std::size_t point_count = points.size();
+  const std::size_t bucket_count = resize(point_count);
+
+  // A counting sort, where bucket_offsets_ first counts the points of each
+  // bucket and then holds where the next one goes
+  bucket_offsets_.assign(bucket_count, 0);
+  for (std::size_t i = 0; i < point_count; ++i) {
+    const std::uint32_t bucket = bucket_of(cell_of(points[i]));
+    point_buckets_[i] = bucket;
+    ++bucket_offsets_[bucket];
+  }
+
+  std::uint32_t offset = 0;
+  for (std::size_t bucket = 0; bucket < bucket_count; ++bucket) {
+    bucket_start_[bucket] = offset;
+    offset += std::exchange(bucket_offsets_[bucket], offset);
+  }
+  bucket_start_[bucket_count] = static_cast<std::uint32_t>(point_count);
+
+  for (std::size_t i = 0; i < point_count; ++i) {
+    const std::uint32_t destination = bucket_offsets_[point_buckets_[i]]++;
+    sorted_points_[destination] = points[i];
+    sorted_indices_[destination] = static_cast<std::uint32_t>(i);
+  }
+}
+
+auto SpatialHashGrid::rebuild(std::span<const Point3> points, ThreadPool& pool)
+    -> void
+{
+  const std::size_t point_count = points.size();
+  resize(point_count);
+  const std::size_t chunk_count = std::clamp(
+      point_count / parallel_grain_size, std::size_t{1}, pool.size());
+
+  parallel_for_chunks(
+      &pool, chunk_count, 0, point_count,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          point_buckets_[i] = bucket_of(cell_of(points[i]));
+          sorted_indices_[i] = static_cast<std::uint32_t>(i);
+        }
+      });
+
+  // The radix sort is stable, so the points of a bucket stay ordered by index
+  // like in the counting sort
+  bucket_scratch_.resize(point_count);
+  index_scratch_.resize(point_count);
+  radix_sort_by_key(std::span{point_buckets_}, std::span{sorted_indices_},
+                    std::span{bucket_scratch_}, std::span{index_scratch_},
+                    pool);
+
+  // Every bucket starts at the first point whose bucket is not lower, so each
+  // one is written by the point where the sorted buckets step over it
+  parallel_for_chunks(
+      &pool, chunk_count, 0, point_count,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          sorted_points_[i] = points[sorted_indices_[i]];
+          const std::size_t first =
+              i == 0 ? 0 : std::size_t{point_buckets_[i - 1]} + 1;
+          for (std::size_t bucket = first; bucket <= point_buckets_[i];
+               ++bucket) {
+            bucket_start_[bucket] = static_cast<std::uint32_t>(i);
+          }
+        }
+      });
+  const std::size_t first =
+      point_count == 0 ? 0 : std::size_t{point_buckets_.back()} + 1;
+  std::fill(bucket_start_.begin() + static_cast<std::ptrdiff_t>(first),
+            bucket_start_.end(), static_cast<std::uint32_t>(point_count));
+}
+
+} // namespace beyond
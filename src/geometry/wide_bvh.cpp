@@ -0,0 +1,106 @@
+#include "beyond/geometry/wide_bvh.hpp"
+
+#include <algorithm>
+
+namespace beyond {
+
+template <std::size_t N>
+WideBVH<N>::WideBVH(const BVH& bvh)
+    : primitive_indices_(bvh.primitive_indices().begin(),
+                         bvh.primitive_indices().end())
+{
+  if (bvh.empty()) { return; }
+  nodes_.emplace_back();
+  collapse(bvh.nodes(), 0, 0);
+}
+
+// Fills the wide node `index` from the binary node `binary_index`, and
+// collapses the interior children below it
+template <std::size_t N>
+auto WideBVH<N>::collapse(std::span<const BVH::Node> binary_nodes,
+                          std::uint32_t binary_index, std::uint32_t index)
+    -> void
+{
+  std::array<std::uint32_t, N> children;
+  std::size_t child_count = 0;
+  const BVH::Node& binary_node = binary_nodes[binary_index];
+  if (binary_node.is_leaf()) {
+    // Only happens at the root of a BVH that is a single leaf
+    children[child_count++] = binary_index;
+  } else {
+    children[child_count++] = binary_index + 1;
+    children[child_count++] = binary_node.offset;
+  }
+
+  // Replaces the interior child with the largest surface area by its two
+  // children until the node is full
+  while (child_count < N) {
+    std::size_t largest = child_count;
+    float largest_area = -1;
+    for (std::size_t i = 0; i < child_count; ++i) {
+      const BVH::Node& child = binary_nodes[children[i]];
+      if (child.is_leaf()) { continue; }
+      const float area = half_surface_area(child.bounds);
+      if (area > largest_area) {
+        largest = i;
+        largest_area = area;
+      }
+    }
+    if (largest == child_count) { break; }
+
+    const std::uint32_t expanded = children[largest];
+    children[largest] = expanded + 1;
+    children[child_count++] = binary_nodes[expanded].offset;
+  }
+
+  std::array<AABB3, N> bounds;
+  Node node;
+  std::array<std::uint32_t, N> binary_children{};
+  std::size_t interior_count = 0;
+  for (std::size_t i = 0; i < child_count; ++i) {
+    const BVH::Node& child = binary_nodes[children[i]];
+    bounds[i] = child.bounds;
+    if (child.is_leaf()) {
+      node.offset[i] = child.offset;
+      node.primitive_count[i] = child.primitive_count;
+    } else {
+      node.offset[i] = static_cast<std::uint32_t>(nodes_.size());
+      nodes_.emplace_back();
+      binary_children[interior_count++] = children[i];
+    }
+  }
+  node.bounds = WideAABB3<N>{std::span{bounds}.first(child_count)};
+
+  // The interior children were allocated in order, right after each other
+  const std::uint32_t first_child = static_cast<std::uint32_t>(
+      nodes_.size() - interior_count);
+  nodes_[index] = node;
+  for (std::size_t i = 0; i < interior_count; ++i) {
+    collapse(binary_nodes, binary_children[i],
+             first_child + static_cast<std::uint32_t>(i));
+  }
+}
+
+template <std::size_t N>
+auto WideBVH<N>::intersect(const Ray& ray, std::span<const AABB3> boxes,
+                           float t_min, float t_max) const -> optional<Hit>
+{
+  const PrecomputedRay precomputed{ray};
+  return intersect(ray, t_min, t_max,
+                   [&](std::uint32_t primitive, float t_near,
+                       float t_far) -> optional<float> {
+                     BEYOND_ASSERT(primitive < boxes.size());
+                     const float t = detail::ray_box_entry(
+                         boxes[primitive], precomputed.origin,
+                         precomputed.inv_direction, t_near, t_far);
+                     if (t == std::numeric_limits<float>::infinity()) {
+                       return nullopt;
+                     }
+                     return t;
+                   });
+}
+
+template class WideBVH<4>;
+template class WideBVH<8>;
+
+} // namespace beyond
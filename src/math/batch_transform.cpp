@@ -0,0 +1,208 @@
+#include "beyond/math/batch_transform.hpp"
+
+#include <type_traits>
+
+namespace beyond {
+
+namespace {
+
+static_assert(sizeof(Point3) == 3 * sizeof(float) &&
+                  std::is_standard_layout_v<Point3>,
+              "Batch transforms treat arrays of Point3 as arrays of float");
+static_assert(sizeof(Vec3) == 3 * sizeof(float) &&
+                  std::is_standard_layout_v<Vec3>,
+              "Batch transforms treat arrays of Vec3 as arrays of float");
+
+// w is 1 for points and 0 for vectors
+template <bool is_point>
+auto transform_scalar(const Mat4& m, const float* in, float* out) noexcept
+    -> void
+{
+  const float x = in[0];
+  const float y = in[1];
+  const float z = in[2];
+  for (std::size_t i = 0; i < 3; ++i) {
+    float r = m.data[i] * x + m.data[4 + i] * y + m.data[8 + i] * z;
+    if constexpr (is_point) { r += m.data[12 + i]; }
+    out[i] = r;
+  }
+}
+
+#ifdef BEYOND_SIMD_SSE
+
+// Transforms 4 elements in SoA layout
+template <bool is_point>
+auto transform4(const Mat4& m, __m128 x, __m128 y, __m128 z, __m128& rx,
+                __m128& ry, __m128& rz) noexcept -> void
+{
+  using detail::simd::madd;
+  const float* d = m.data;
+  rx = madd(_mm_set1_ps(d[0]), x,
+            madd(_mm_set1_ps(d[4]), y, _mm_mul_ps(_mm_set1_ps(d[8]), z)));
+  ry = madd(_mm_set1_ps(d[1]), x,
+            madd(_mm_set1_ps(d[5]), y, _mm_mul_ps(_mm_set1_ps(d[9]), z)));
+  rz = madd(_mm_set1_ps(d[2]), x,
+            madd(_mm_set1_ps(d[6]), y, _mm_mul_ps(_mm_set1_ps(d[10]), z)));
+  if constexpr (is_point) {
+    rx = _mm_add_ps(rx, _mm_set1_ps(d[12]));
+    ry = _mm_add_ps(ry, _mm_set1_ps(d[13]));
+    rz = _mm_add_ps(rz, _mm_set1_ps(d[14]));
+  }
+}
+
+// Transforms 4 elements in AoS layout, that is 12 floats of xyzxyz...
+template <bool is_point>
+auto transform4_aos(const Mat4& m, const float* in, float* out) noexcept
+    -> void
+{
+  // (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3)
+  const __m128 a = _mm_loadu_ps(in);
+  const __m128 b = _mm_loadu_ps(in + 4);
+  const __m128 c = _mm_loadu_ps(in + 8);
+
+  const __m128 x2x2x3x3 = BEYOND_SIMD_SHUFFLE(b, c, 2, 2, 1, 1);
+  const __m128 y0y0y1y1 = BEYOND_SIMD_SHUFFLE(a, b, 1, 1, 0, 0);
+  const __m128 y2y2y3y3 = BEYOND_SIMD_SHUFFLE(b, c, 3, 3, 2, 2);
+  const __m128 z0z0z1z1 = BEYOND_SIMD_SHUFFLE(a, b, 2, 2, 1, 1);
+  const __m128 z2z2z3z3 = BEYOND_SIMD_SHUFFLE(c, c, 0, 0, 3, 3);
+  const __m128 x = BEYOND_SIMD_SHUFFLE(a, x2x2x3x3, 0, 3, 0, 2);
+  const __m128 y = BEYOND_SIMD_SHUFFLE(y0y0y1y1, y2y2y3y3, 0, 2, 0, 2);
+  const __m128 z = BEYOND_SIMD_SHUFFLE(z0z0z1z1, z2z2z3z3, 0, 2, 0, 2);
+
+  __m128 rx, ry, rz;
+  transform4<is_point>(m, x, y, z, rx, ry, rz);
+
+  // Interleaves the results back to (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3)
+  const __m128 x0x0y0y0 = BEYOND_SIMD_SHUFFLE(rx, ry, 0, 0, 0, 0);
+  const __m128 z0z0x1x1 = BEYOND_SIMD_SHUFFLE(rz, rx, 0, 0, 1, 1);
+  const __m128 y1y1z1z1 = BEYOND_SIMD_SHUFFLE(ry, rz, 1, 1, 1, 1);
+  const __m128 x2x2y2y2 = BEYOND_SIMD_SHUFFLE(rx, ry, 2, 2, 2, 2);
+  const __m128 z2z2x3x3 = BEYOND_SIMD_SHUFFLE(rz, rx, 2, 2, 3, 3);
+  const __m128 y3y3z3z3 = BEYOND_SIMD_SHUFFLE(ry, rz, 3, 3, 3, 3);
+  _mm_storeu_ps(out, BEYOND_SIMD_SHUFFLE(x0x0y0y0, z0z0x1x1, 0, 2, 0, 2));
+  _mm_storeu_ps(out + 4, BEYOND_SIMD_SHUFFLE(y1y1z1z1, x2x2y2y2, 0, 2, 0, 2));
+  _mm_storeu_ps(out + 8, BEYOND_SIMD_SHUFFLE(z2z2x3x3, y3y3z3z3, 0, 2, 0, 2));
+}
+
+#endif
+
+#ifdef BEYOND_SIMD_AVX
+
+// Transforms 8 elements in SoA layout
+template <bool is_point>
+auto transform8(const Mat4& m, const float* x, const float* y, const float* z,
+                float* out_x, float* out_y, float* out_z) noexcept -> void
+{
+  const float* d = m.data;
+  const __m256 vx = _mm256_loadu_ps(x);
+  const __m256 vy = _mm256_loadu_ps(y);
+  const __m256 vz = _mm256_loadu_ps(z);
+
+  const auto row = [&](std::size_t i) {
+    __m256 r = _mm256_mul_ps(_mm256_set1_ps(d[8 + i]), vz);
+#ifdef BEYOND_SIMD_FMA
+    r = _mm256_fmadd_ps(_mm256_set1_ps(d[4 + i]), vy, r);
+    r = _mm256_fmadd_ps(_mm256_set1_ps(d[i]), vx, r);
+#else
+    r = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(d[4 + i]), vy), r);
+    r = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(d[i]), vx), r);
+#endif
+    if constexpr (is_point) {
+      r = _mm256_add_ps(r, _mm256_set1_ps(d[12 + i]));
+    }
+    return r;
+  };
+
+  // Computes all rows before storing in case the input and output alias
+  const __m256 rx = row(0);
+  const __m256 ry = row(1);
+  const __m256 rz = row(2);
+  _mm256_storeu_ps(out_x, rx);
+  _mm256_storeu_ps(out_y, ry);
+  _mm256_storeu_ps(out_z, rz);
+}
+
+#endif
+
+template <bool is_point>
+auto transform_aos(const Mat4& m, const float* in, float* out,
+                   std::size_t count) noexcept -> void
+{
+  std::size_t i = 0;
+#ifdef BEYOND_SIMD_SSE
+  for (; i + 4 <= count; i += 4) {
+    transform4_aos<is_point>(m, in + i * 3, out + i * 3);
+  }
+#endif
+  for (; i < count; ++i) {
+    transform_scalar<is_point>(m, in + i * 3, out + i * 3);
+  }
+}
+
+template <bool is_point>
+auto transform_soa(const Mat4& m, SoASpan3<const float> in,
+                   SoASpan3<float> out) noexcept -> void
+{
+  BEYOND_ASSERT(in.y.size() == in.size() && in.z.size() == in.size());
+  BEYOND_ASSERT(out.x.size() >= in.size() && out.y.size() >= in.size() &&
+                out.z.size() >= in.size());
+
+  const std::size_t count = in.size();
+  std::size_t i = 0;
+#ifdef BEYOND_SIMD_AVX
+  for (; i + 8 <= count; i += 8) {
+    transform8<is_point>(m, &in.x[i], &in.y[i], &in.z[i], &out.x[i],
+                         &out.y[i], &out.z[i]);
+  }
+#endif
+#ifdef BEYOND_SIMD_SSE
+  for (; i + 4 <= count; i += 4) {
+    __m128 rx, ry, rz;
+    transform4<is_point>(m, _mm_loadu_ps(&in.x[i]), _mm_loadu_ps(&in.y[i]),
+                         _mm_loadu_ps(&in.z[i]), rx, ry, rz);
+    _mm_storeu_ps(&out.x[i], rx);
+    _mm_storeu_ps(&out.y[i], ry);
+    _mm_storeu_ps(&out.z[i], rz);
+  }
+#endif
+  for (; i < count; ++i) {
+    const float p[3] = {in.x[i], in.y[i], in.z[i]};
+    float r[3];
+    transform_scalar<is_point>(m, p, r);
+    out.x[i] = r[0];
+    out.y[i] = r[1];
+    out.z[i] = r[2];
+  }
+}
+
+} // anonymous namespace
+
+auto transform_points(const Mat4& m, std::span<const Point3> points,
+                      std::span<Point3> out) noexcept -> void
+{
+  BEYOND_ASSERT(out.size() >= points.size());
+  transform_aos<true>(m, reinterpret_cast<const float*>(points.data()),
+                      reinterpret_cast<float*>(out.data()), points.size());
+}
+
+auto transform_vectors(const Mat4& m, std::span<const Vec3> vectors,
+                       std::span<Vec3> out) noexcept -> void
+{
+  BEYOND_ASSERT(out.size() >= vectors.size());
+  transform_aos<false>(m, reinterpret_cast<const float*>(vectors.data()),
+                       reinterpret_cast<float*>(out.data()), vectors.size());
+}
+
+auto transform_points(const Mat4& m, SoASpan3<const float> points,
+                      SoASpan3<float> out) noexcept -> void
+{
+  transform_soa<true>(m, points, out);
+}
+
+auto transform_vectors(const Mat4& m, SoASpan3<const float> vectors,
+                       SoASpan3<float> out) noexcept -> void
+{
+  transform_soa<false>(m, vectors, out);
+}
+
+} // namespace beyond
@@ -0,0 +1,233 @@
+#include "beyond/math/quat.hpp"
+#include "beyond/math/wide_float.hpp"
+
+#include <array>
+#include <type_traits>
+
+namespace beyond {
+
+namespace {
+
+static_assert(sizeof(Quat) == 4 * sizeof(float) &&
+                  std::is_standard_layout_v<Quat>,
+              "Batch operations treat arrays of Quat as arrays of float");
+
+#ifdef BEYOND_SIMD_AVX
+constexpr std::size_t lane_count = 8;
+#else
+constexpr std::size_t lane_count = 4;
+#endif
+using Lanes = WideFloat<lane_count>;
+
+// Scalar counterpart of select(WideMask, WideFloat, WideFloat)
+auto select(bool condition, float a, float b) noexcept -> float
+{
+  return condition ? a : b;
+}
+
+// slerp(q1, q2, t) = q1 * sin((1 - t)θ) / sin(θ) + q2 * sin(tθ) / sin(θ)
+//
+// The weights are evaluated with the polynomial approximation from David
+// Eberly, "A Fast and Accurate Algorithm for Computing SLERP", which only
+// needs multiplications and additions, and thus vectorizes. sin(tθ) / sin(θ)
+// is expanded as t(1 + b[0](1 + b[1](1 + ...))), where
+// b[i] = (u[i] t² - v[i])(cos(θ) - 1), u[i] = 1 / ((i + 1)(2i + 3)) and
+// v[i] = (i + 1) / (2i + 3). The last terms are scaled by mu to compensate the
+// truncation of the series.
+constexpr float mu = 1.85298109240830f;
+constexpr std::array<float, 8> series_u = {
+    1.f / (1 * 3), 1.f / (2 * 5),  1.f / (3 * 7),  1.f / (4 * 9),
+    1.f / (5 * 11), 1.f / (6 * 13), 1.f / (7 * 15), mu / (8 * 17)};
+constexpr std::array<float, 8> series_v = {
+    1.f / 3,  2.f / 5,  3.f / 7,  4.f / 9,
+    5.f / 11, 6.f / 13, 7.f / 15, mu * 8 / 17};
+
+template <typename T>
+auto slerp_weight(T cos_theta_minus_1, T t) noexcept -> T
+{
+  const T t2 = t * t;
+  T result{1.f};
+  for (std::size_t i = series_u.size(); i-- > 0;) {
+    const T b = (T{series_u[i]} * t2 - T{series_v[i]}) * cos_theta_minus_1;
+    result = T{1.f} + b * result;
+  }
+  return t * result;
+}
+
+template <typename T>
+auto slerp_approx(const TQuat<T>& q1, const TQuat<T>& q2, const T& t) noexcept
+    -> TQuat<T>
+{
+  // Negates q2 when needed to take the shortest path
+  const T cos_theta = dot(q1, q2);
+  const T sign = select(cos_theta < T{0.f}, T{-1.f}, T{1.f});
+  const T cos_theta_minus_1 = cos_theta * sign - T{1.f};
+  return q1 * slerp_weight(cos_theta_minus_1, T{1.f} - t) +
+         q2 * (sign * slerp_weight(cos_theta_minus_1, t));
+}
+
+template <typename T>
+auto nlerp_impl(const TQuat<T>& q1, const TQuat<T>& q2, const T& t) noexcept
+    -> TQuat<T>
+{
+  const T sign = select(dot(q1, q2) < T{0.f}, T{-1.f}, T{1.f});
+  return normalize(q1 * (T{1.f} - t) + q2 * (sign * t));
+}
+
+#ifdef BEYOND_SIMD_SSE
+
+// Transposes 4 quaternions into registers of their x, y, z and w components,
+// or back when applied again
+auto transpose4(const Quat* quats, __m128& x, __m128& y, __m128& z,
+                __m128& w) noexcept -> void
+{
+  const auto* data = reinterpret_cast<const float*>(quats);
+  x = _mm_loadu_ps(data);
+  y = _mm_loadu_ps(data + 4);
+  z = _mm_loadu_ps(data + 8);
+  w = _mm_loadu_ps(data + 12);
+  _MM_TRANSPOSE4_PS(x, y, z, w);
+}
+
+auto transpose4_store(__m128 x, __m128 y, __m128 z, __m128 w,
+                      Quat* quats) noexcept -> void
+{
+  auto* data = reinterpret_cast<float*>(quats);
+  _MM_TRANSPOSE4_PS(x, y, z, w);
+  _mm_storeu_ps(data, x);
+  _mm_storeu_ps(data + 4, y);
+  _mm_storeu_ps(data + 8, z);
+  _mm_storeu_ps(data + 12, w);
+}
+
+#endif
+
+// Transposes lane_count quaternions into one quaternion of SIMD lanes
+auto load_lanes(const Quat* quats) noexcept -> TQuat<Lanes>
+{
+#if defined(BEYOND_SIMD_AVX)
+  __m128 x0, y0, z0, w0, x1, y1, z1, w1;
+  transpose4(quats, x0, y0, z0, w0);
+  transpose4(quats + 4, x1, y1, z1, w1);
+  return TQuat<Lanes>(
+      Lanes{_mm256_set_m128(w1, w0)}, Lanes{_mm256_set_m128(x1, x0)},
+      Lanes{_mm256_set_m128(y1, y0)}, Lanes{_mm256_set_m128(z1, z0)});
+#elif defined(BEYOND_SIMD_SSE)
+  __m128 x, y, z, w;
+  transpose4(quats, x, y, z, w);
+  return TQuat<Lanes>(Lanes{w}, Lanes{x}, Lanes{y}, Lanes{z});
+#else
+  std::array<float, lane_count> x, y, z, w;
+  for (std::size_t i = 0; i < lane_count; ++i) {
+    x[i] = quats[i].x;
+    y[i] = quats[i].y;
+    z[i] = quats[i].z;
+    w[i] = quats[i].w;
+  }
+  return TQuat<Lanes>(Lanes::load(w.data()), Lanes::load(x.data()),
+                      Lanes::load(y.data()), Lanes::load(z.data()));
+#endif
+}
+
+auto store_lanes(const TQuat<Lanes>& q, Quat* quats) noexcept -> void
+{
+#if defined(BEYOND_SIMD_AVX)
+  const auto low = [](const Lanes& v) {
+    return _mm256_castps256_ps128(v.native());
+  };
+  const auto high = [](const Lanes& v) {
+    return _mm256_extractf128_ps(v.native(), 1);
+  };
+  transpose4_store(low(q.x), low(q.y), low(q.z), low(q.w), quats);
+  transpose4_store(high(q.x), high(q.y), high(q.z), high(q.w), quats + 4);
+#elif defined(BEYOND_SIMD_SSE)
+  transpose4_store(q.x.native(), q.y.native(), q.z.native(), q.w.native(),
+                   quats);
+#else
+  std::array<float, lane_count> x, y, z, w;
+  q.x.store(x.data());
+  q.y.store(y.data());
+  q.z.store(z.data());
+  q.w.store(w.data());
+  for (std::size_t i = 0; i < lane_count; ++i) {
+    quats[i] = Quat(w[i], x[i], y[i], z[i]);
+  }
+#endif
+}
+
+auto load_t(std::span<const float> t, std::size_t i) noexcept -> Lanes
+{
+  return Lanes::load(&t[i]);
+}
+auto load_t(float t, std::size_t /*i*/) noexcept -> Lanes
+{
+  return Lanes{t};
+}
+auto scalar_t(std::span<const float> t, std::size_t i) noexcept -> float
+{
+  return t[i];
+}
+auto scalar_t(float t, std::size_t /*i*/) noexcept -> float
+{
+  return t;
+}
+
+// Interpolates lane_count quaternions at a time, then the remaining ones one
+// by one. `interpolate` is called with either TQuat<Lanes> or Quat.
+template <typename TSource, typename Interpolate>
+auto interpolate_all(std::span<const Quat> from, std::span<const Quat> to,
+                     TSource t, std::span<Quat> out,
+                     Interpolate interpolate) noexcept -> void
+{
+  BEYOND_ASSERT(to.size() == from.size());
+  BEYOND_ASSERT(out.size() == from.size());
+
+  const std::size_t count = from.size();
+  std::size_t i = 0;
+  for (; i + lane_count <= count; i += lane_count) {
+    store_lanes(interpolate(load_lanes(&from[i]), load_lanes(&to[i]),
+                            load_t(t, i)),
+                &out[i]);
+  }
+  for (; i < count; ++i) {
+    out[i] = interpolate(from[i], to[i], scalar_t(t, i));
+  }
+}
+
+constexpr auto slerp_fn = [](const auto& q1, const auto& q2, auto t) {
+  return slerp_approx(q1, q2, t);
+};
+
+constexpr auto nlerp_fn = [](const auto& q1, const auto& q2, auto t) {
+  return nlerp_impl(q1, q2, t);
+};
+
+} // anonymous namespace
+
+auto slerp(std::span<const Quat> from, std::span<const Quat> to,
+           std::span<const float> t, std::span<Quat> out) noexcept -> void
+{
+  BEYOND_ASSERT(t.size() == from.size());
+  interpolate_all(from, to, t, out, slerp_fn);
+}
+
+auto slerp(std::span<const Quat> from, std::span<const Quat> to, float t,
+           std::span<Quat> out) noexcept -> void
+{
+  interpolate_all(from, to, t, out, slerp_fn);
+}
+
+auto nlerp(std::span<const Quat> from, std::span<const Quat> to,
+           std::span<const float> t, std::span<Quat> out) noexcept -> void
+{
+  BEYOND_ASSERT(t.size() == from.size());
+  interpolate_all(from, to, t, out, nlerp_fn);
+}
+
+auto nlerp(std::span<const Quat> from, std::span<const Quat> to, float t,
+           std::span<Quat> out) noexcept -> void
+{
+  interpolate_all(from, to, t, out, nlerp_fn);
+}
+
+} // namespace beyond
@@ -0,0 +1,170 @@
+#include "beyond/math/transform3.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace beyond {
+
+namespace {
+
+#ifdef BEYOND_SIMD_SSE
+
+static_assert(std::is_standard_layout_v<Transform3> &&
+                  sizeof(Transform3) == 10 * sizeof(float) &&
+                  offsetof(Transform3, rotation) == 3 * sizeof(float) &&
+                  offsetof(Transform3, scale) == 7 * sizeof(float),
+              "The SIMD composition treats Transform3 as 10 packed floats");
+
+// A Transform3 in registers. The w components of translation and scale are 0
+struct SimdTransform {
+  __m128 translation;
+  __m128 rotation;
+  __m128 scale;
+};
+
+auto load(const Transform3& transform) noexcept -> SimdTransform
+{
+  const auto* data = reinterpret_cast<const float*>(&transform);
+  const __m128 xyz_mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+  // Loads (rotation.w, scale) to not read past the end of the object
+  const __m128 w_scale = _mm_loadu_ps(data + 6);
+  return {_mm_and_ps(_mm_loadu_ps(data), xyz_mask), _mm_loadu_ps(data + 3),
+          _mm_and_ps(BEYOND_SIMD_SWIZZLE(w_scale, 1, 2, 3, 3), xyz_mask)};
+}
+
+auto store(const SimdTransform& transform, Transform3& out) noexcept -> void
+{
+  auto* data = reinterpret_cast<float*>(&out);
+  // The w lane of the translation is overwritten by the rotation
+  _mm_storeu_ps(data, transform.translation);
+  _mm_storeu_ps(data + 3, transform.rotation);
+  _mm_storel_pi(reinterpret_cast<__m64*>(data + 7), transform.scale);
+  _mm_store_ss(data + 9, BEYOND_SIMD_SWIZZLE(transform.scale, 2, 2, 2, 2));
+}
+
+// Hamilton product of two quaternions stored as (x, y, z, w)
+auto quat_mul(__m128 a, __m128 b) noexcept -> __m128
+{
+  using detail::simd::madd;
+  const __m128 ax = BEYOND_SIMD_SWIZZLE(a, 0, 0, 0, 0);
+  const __m128 ay = BEYOND_SIMD_SWIZZLE(a, 1, 1, 1, 1);
+  const __m128 az = BEYOND_SIMD_SWIZZLE(a, 2, 2, 2, 2);
+  const __m128 aw = BEYOND_SIMD_SWIZZLE(a, 3, 3, 3, 3);
+  __m128 result = _mm_mul_ps(aw, b);
+  result = madd(_mm_mul_ps(ax, _mm_setr_ps(1, -1, 1, -1)),
+                BEYOND_SIMD_SWIZZLE(b, 3, 2, 1, 0), result);
+  result = madd(_mm_mul_ps(ay, _mm_setr_ps(1, 1, -1, -1)),
+                BEYOND_SIMD_SWIZZLE(b, 2, 3, 0, 1), result);
+  result = madd(_mm_mul_ps(az, _mm_setr_ps(-1, 1, 1, -1)),
+                BEYOND_SIMD_SWIZZLE(b, 1, 0, 3, 2), result);
+  return result;
+}
+
+// Rotates v by the unit quaternion q
+auto quat_rotate(__m128 q, __m128 v) noexcept -> __m128
+{
+  using detail::simd::cross3;
+  using detail::simd::madd;
+  const __m128 t = cross3(q, _mm_add_ps(v, v));
+  return _mm_add_ps(madd(BEYOND_SIMD_SWIZZLE(q, 3, 3, 3, 3), t, v),
+                    cross3(q, t));
+}
+
+auto compose(const SimdTransform& parent, const SimdTransform& child) noexcept
+    -> SimdTransform
+{
+  const __m128 scaled = _mm_mul_ps(parent.scale, child.translation);
+  return {_mm_add_ps(parent.translation, quat_rotate(parent.rotation, scaled)),
+          quat_mul(parent.rotation, child.rotation),
+          _mm_mul_ps(parent.scale, child.scale)};
+}
+
+// Column j of the matrix is the j-th axis, scaled and then rotated
+auto to_matrix(const SimdTransform& transform, Mat4& out) noexcept -> void
+{
+  const __m128 x = _mm_move_ss(_mm_setzero_ps(), transform.scale);
+  const __m128 y = _mm_and_ps(transform.scale,
+                              _mm_castsi128_ps(_mm_setr_epi32(0, -1, 0, 0)));
+  const __m128 z = _mm_and_ps(transform.scale,
+                              _mm_castsi128_ps(_mm_setr_epi32(0, 0, -1, 0)));
+  _mm_storeu_ps(out.data, quat_rotate(transform.rotation, x));
+  _mm_storeu_ps(out.data + 4, quat_rotate(transform.rotation, y));
+  _mm_storeu_ps(out.data + 8, quat_rotate(transform.rotation, z));
+  _mm_storeu_ps(out.data + 12,
+                _mm_or_ps(transform.translation, _mm_setr_ps(0, 0, 0, 1)));
+}
+
+#else
+
+using SimdTransform = Transform3;
+
+auto load(const Transform3& transform) noexcept -> const Transform3&
+{
+  return transform;
+}
+
+auto store(const Transform3& transform, Transform3& out) noexcept -> void
+{
+  out = transform;
+}
+
+auto compose(const Transform3& parent, const Transform3& child) noexcept
+    -> Transform3
+{
+  return parent * child;
+}
+
+auto to_matrix(const Transform3& transform, Mat4& out) noexcept -> void
+{
+  out = to_mat4(transform);
+}
+
+#endif
+
+// Parents come before their children, so a single forward pass sees the world
+// transformation of every parent before its children
+template <typename Visit>
+auto propagate(std::span<const Transform3> local,
+               std::span<const std::uint32_t> parents,
+               std::span<Transform3> world, Visit visit) noexcept -> void
+{
+  BEYOND_ASSERT(parents.size() == local.size());
+  BEYOND_ASSERT(world.size() == local.size());
+
+  for (std::size_t i = 0; i < local.size(); ++i) {
+    const std::uint32_t parent = parents[i];
+    BEYOND_ASSERT_MSG(parent == no_parent || parent < i,
+                      "Parents shall come before children");
+    // Passes the result in registers to `visit`, since reading it back right
+    // after the partial stores of `store` stalls store forwarding
+    const SimdTransform transform =
+        parent == no_parent ? SimdTransform{load(local[i])}
+                            : compose(load(world[parent]), load(local[i]));
+    store(transform, world[i]);
+    visit(i, transform);
+  }
+}
+
+} // anonymous namespace
+
+auto propagate_transforms(std::span<const Transform3> local,
+                          std::span<const std::uint32_t> parents,
+                          std::span<Transform3> world) noexcept -> void
+{
+  propagate(local, parents, world,
+            [](std::size_t, const SimdTransform&) {});
+}
+
+auto propagate_transforms(std::span<const Transform3> local,
+                          std::span<const std::uint32_t> parents,
+                          std::span<Transform3> world,
+                          std::span<Mat4> world_matrices) noexcept -> void
+{
+  BEYOND_ASSERT(world_matrices.size() == local.size());
+  propagate(local, parents, world,
+            [&](std::size_t i, const SimdTransform& transform) {
+              to_matrix(transform, world_matrices[i]);
+            });
+}
+
+} // namespace beyond
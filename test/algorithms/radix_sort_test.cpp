@@ -0,0 +1,188 @@
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "beyond/algorithm/radix_sort.hpp"
+#include "beyond/concurrency/thread_pool.hpp"
+#include "beyond/random/generators/xorshift32.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+template <typename Key>
+auto random_keys(std::size_t count, Key max, std::uint32_t seed)
+    -> std::vector<Key>
+{
+  beyond::xorshift32 rng{seed};
+  std::uniform_int_distribution<std::uint64_t> dist{0, max};
+  std::vector<Key> keys(count);
+  for (Key& key : keys) { key = static_cast<Key>(dist(rng)); }
+  return keys;
+}
+
+// Sorts the keys with std::stable_sort, and gives the permutation applied to
+// them
+template <typename Key>
+auto expected_order(const std::vector<Key>& keys) -> std::vector<std::uint32_t>
+{
+  std::vector<std::uint32_t> order(keys.size());
+  std::iota(order.begin(), order.end(), std::uint32_t{0});
+  std::ranges::stable_sort(order, {}, [&](std::uint32_t i) { return keys[i]; });
+  return order;
+}
+
+} // anonymous namespace
+
+TEMPLATE_TEST_CASE("Radix sort by key", "[beyond.core.algorithm.radix_sort]",
+                   std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t)
+{
+  using Key = TestType;
+
+  SECTION("Empty and single element ranges")
+  {
+    std::vector<Key> keys;
+    std::vector<int> mapped;
+    beyond::radix_sort_by_key(std::span{keys}, std::span{mapped});
+    REQUIRE(keys.empty());
+
+    keys = {Key{3}};
+    mapped = {7};
+    beyond::radix_sort_by_key(std::span{keys}, std::span{mapped});
+    REQUIRE(keys.front() == 3);
+    REQUIRE(mapped.front() == 7);
+  }
+
+  SECTION("Sorts stably")
+  {
+    // Few distinct keys, so that many of them are equal
+    for (const Key max : {Key{7}, std::numeric_limits<Key>::max()}) {
+      std::vector<Key> keys = random_keys<Key>(5000, max, 11);
+      const std::vector<std::uint32_t> expected = expected_order(keys);
+
+      std::vector<std::uint32_t> mapped(keys.size());
+      std::iota(mapped.begin(), mapped.end(), std::uint32_t{0});
+      beyond::radix_sort_by_key(std::span{keys}, std::span{mapped});
+      REQUIRE(std::ranges::is_sorted(keys));
+      REQUIRE(mapped == expected);
+    }
+  }
+
+  SECTION("Moves the mapped values")
+  {
+    std::vector<Key> keys = random_keys<Key>(300, Key{100}, 12);
+    std::vector<std::string> mapped;
+    for (const Key key : keys) {
+      mapped.push_back("a long string that is not inlined " +
+                       std::to_string(key));
+    }
+    beyond::radix_sort_by_key(std::span{keys}, std::span{mapped});
+    bool all_match = true;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      all_match = all_match &&
+                  mapped[i] == "a long string that is not inlined " +
+                                   std::to_string(keys[i]);
+    }
+    REQUIRE(all_match);
+  }
+}
+
+TEMPLATE_TEST_CASE("Radix sort by signed and floating point keys",
+                   "[beyond.core.algorithm.radix_sort]", std::int8_t,
+                   std::int32_t, std::int64_t, float, double)
+{
+  using Key = TestType;
+
+  beyond::xorshift32 rng{14};
+  std::uniform_int_distribution<int> dist{-100, 100};
+  std::vector<Key> keys;
+  for (int i = 0; i < 3000; ++i) {
+    if constexpr (std::is_floating_point_v<Key>) {
+      keys.push_back(static_cast<Key>(dist(rng)) / 8);
+    } else {
+      keys.push_back(static_cast<Key>(dist(rng)));
+    }
+  }
+  keys.push_back(std::numeric_limits<Key>::lowest());
+  keys.push_back(std::numeric_limits<Key>::max());
+  if constexpr (std::is_floating_point_v<Key>) {
+    keys.push_back(std::numeric_limits<Key>::infinity());
+    keys.push_back(-std::numeric_limits<Key>::infinity());
+    keys.push_back(std::numeric_limits<Key>::denorm_min());
+  }
+  const std::vector<std::uint32_t> expected = expected_order(keys);
+
+  std::vector<std::uint32_t> mapped(keys.size());
+  std::iota(mapped.begin(), mapped.end(), std::uint32_t{0});
+  beyond::radix_sort_by_key(std::span{keys}, std::span{mapped});
+  REQUIRE(std::ranges::is_sorted(keys));
+  REQUIRE(mapped == expected);
+}
+
+TEST_CASE("Radix sort with caller provided scratch buffers",
+          "[beyond.core.algorithm.radix_sort]")
+{
+  std::vector<std::uint64_t> key_scratch;
+  std::vector<std::uint32_t> mapped_scratch;
+  beyond::ThreadPool pool{2};
+  // The same buffers are reused for several sorts, some larger than needed
+  for (const std::size_t size : {100u, 40'000u, 1000u}) {
+    std::vector<std::uint64_t> keys =
+        random_keys<std::uint64_t>(size, std::uint64_t{1} << 40, 15);
+    const std::vector<std::uint32_t> expected = expected_order(keys);
+    key_scratch.resize(std::max(key_scratch.size(), size));
+    mapped_scratch.resize(std::max(mapped_scratch.size(), size));
+
+    std::vector<std::uint64_t> parallel_keys = keys;
+    std::vector<std::uint32_t> mapped(size);
+    std::iota(mapped.begin(), mapped.end(), std::uint32_t{0});
+    std::vector<std::uint32_t> parallel_mapped = mapped;
+
+    beyond::radix_sort_by_key(std::span{keys}, std::span{mapped},
+                              std::span{key_scratch},
+                              std::span{mapped_scratch});
+    REQUIRE(mapped == expected);
+    beyond::radix_sort_by_key(std::span{parallel_keys},
+                              std::span{parallel_mapped},
+                              std::span{key_scratch},
+                              std::span{mapped_scratch}, pool);
+    REQUIRE(parallel_mapped == expected);
+  }
+}
+
+TEST_CASE("Parallel radix sort by key", "[beyond.core.algorithm.radix_sort]")
+{
+  SECTION("Same result as the sequential sort for any number of threads")
+  {
+    // Large enough to be split into several chunks
+    const std::vector<std::uint32_t> keys =
+        random_keys<std::uint32_t>(100'000, (1u << 30) - 1, 13);
+    const std::vector<std::uint32_t> expected = expected_order(keys);
+
+    for (const std::size_t thread_count : {1u, 3u}) {
+      beyond::ThreadPool pool{thread_count};
+      std::vector<std::uint32_t> sorted_keys = keys;
+      std::vector<std::uint32_t> mapped(keys.size());
+      std::iota(mapped.begin(), mapped.end(), std::uint32_t{0});
+      beyond::radix_sort_by_key(std::span{sorted_keys}, std::span{mapped},
+                                pool);
+      REQUIRE(std::ranges::is_sorted(sorted_keys));
+      REQUIRE(mapped == expected);
+    }
+  }
+
+  SECTION("Identical keys")
+  {
+    std::vector<std::uint64_t> keys(50'000, 42);
+    std::vector<std::uint32_t> mapped(keys.size());
+    std::iota(mapped.begin(), mapped.end(), std::uint32_t{0});
+    beyond::ThreadPool pool{2};
+    beyond::radix_sort_by_key(std::span{keys}, std::span{mapped}, pool);
+    REQUIRE(std::ranges::is_sorted(mapped));
+  }
+}
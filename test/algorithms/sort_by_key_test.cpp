@@ -1,9 +1,15 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include "beyond/algorithm/sort_by_key.hpp"
+#include "beyond/concurrency/thread_pool.hpp"
+#include "beyond/random/generators/xorshift32.hpp"
 
 #include <array>
+#include <numeric>
+#include <random>
+#include <string>
 #include <string_view>
+#include <vector>
 
 static_assert(
     std::random_access_iterator<beyond::detail::SortByKeyIterator<int*, int*>>);
@@ -44,4 +50,245 @@ TEST_CASE("Sort by key", "[beyond.core.algorithm.sort_by_key]")
     REQUIRE(std::ranges::equal(result.keys, keys_expected));
     REQUIRE(std::ranges::equal(result.mapped, mapped_expected));
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Sort by key with the radix sort",
+          "[beyond.core.algorithm.sort_by_key]")
+{
+  // Large enough for the parallel radix sort to split the keys into two chunks
+  constexpr std::size_t size = 2 * beyond::detail::radix_parallel_grain_size;
+  beyond::xorshift32 rng{1};
+  // Few distinct keys, so that many of them are equal
+  std::uniform_int_distribution<int> dist{-100, 100};
+  std::vector<float> keys;
+  std::vector<std::size_t> mapped;
+  for (std::size_t i = 0; i < size; ++i) {
+    keys.push_back(static_cast<float>(dist(rng)) * 0.5f);
+    mapped.push_back(i);
+  }
+
+  std::vector<float> sequential_keys = keys;
+  std::vector<std::size_t> sequential_mapped = mapped;
+  beyond::sort_by_key(sequential_keys.begin(), sequential_keys.end(),
+                      sequential_mapped.begin());
+
+  SECTION("Sequential")
+  {
+    // The radix sort is stable
+    std::vector<std::size_t> expected = mapped;
+    std::ranges::stable_sort(expected, {},
+                             [&](std::size_t i) { return keys[i]; });
+    REQUIRE(std::ranges::is_sorted(sequential_keys));
+    REQUIRE(sequential_mapped == expected);
+  }
+
+  SECTION("Parallel")
+  {
+    beyond::ThreadPool pool{2};
+    beyond::sort_by_key(keys.begin(), keys.end(), mapped.begin(), pool);
+    REQUIRE(keys == sequential_keys);
+    REQUIRE(mapped == sequential_mapped);
+  }
+}
+
+namespace {
+
+// A mapped value that can only be moved, and remembers the index of its key
+// before sorting
+struct Payload {
+  explicit Payload(std::size_t index_) : index{index_} {}
+  Payload(Payload&&) noexcept = default;
+  auto operator=(Payload&&) noexcept -> Payload& = default;
+
+  std::size_t index;
+};
+
+struct SortByKeyInput {
+  std::vector<int> original_keys;
+  std::vector<int> keys;
+  std::vector<Payload> mapped;
+};
+
+auto random_input(std::size_t size) -> SortByKeyInput
+{
+  beyond::xorshift32 rng{2};
+  // Many duplicates
+  std::uniform_int_distribution<int> dist{-50, 50};
+  SortByKeyInput input;
+  for (std::size_t i = 0; i < size; ++i) {
+    input.original_keys.push_back(dist(rng));
+    input.mapped.emplace_back(i);
+  }
+  input.keys = input.original_keys;
+  return input;
+}
+
+// Whether the mapped values are a permutation of the original ones that
+// still match their keys
+auto mapped_follow_keys(const SortByKeyInput& input) -> bool
+{
+  std::vector<char> seen(input.keys.size());
+  for (std::size_t i = 0; i < input.keys.size(); ++i) {
+    const std::size_t index = input.mapped[i].index;
+    if (seen[index] != 0 || input.original_keys[index] != input.keys[i]) {
+      return false;
+    }
+    seen[index] = 1;
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Stable sort by key", "[beyond.core.algorithm.sort_by_key]")
+{
+  for (const std::size_t size : {500u, 5000u}) {
+    SortByKeyInput input = random_input(size);
+    beyond::stable_sort_by_key(input.keys.begin(), input.keys.end(),
+                               input.mapped.begin());
+    REQUIRE(std::ranges::is_sorted(input.keys));
+    REQUIRE(mapped_follow_keys(input));
+    // Equal keys keep their original order
+    bool stable = true;
+    for (std::size_t i = 1; i < size; ++i) {
+      stable = stable && (input.keys[i - 1] != input.keys[i] ||
+                          input.mapped[i - 1].index < input.mapped[i].index);
+    }
+    REQUIRE(stable);
+  }
+
+  SECTION("Radix sortable keys")
+  {
+    SortByKeyInput input = random_input(5000);
+    std::vector<std::size_t> indices(input.keys.size());
+    std::iota(indices.begin(), indices.end(), std::size_t{0});
+    std::vector<std::size_t> expected = indices;
+    std::ranges::stable_sort(expected, {}, [&](std::size_t i) {
+      return input.original_keys[i];
+    });
+    beyond::stable_sort_by_key(input.keys.begin(), input.keys.end(),
+                               indices.begin());
+    REQUIRE(indices == expected);
+  }
+
+  SECTION("Keys that are not radix sortable")
+  {
+    std::vector<std::string> keys{"pear", "apple", "fig", "apple", "kiwi"};
+    std::vector<int> mapped{0, 1, 2, 3, 4};
+    beyond::stable_sort_by_key(keys.begin(), keys.end(), mapped.begin());
+    REQUIRE(keys == std::vector<std::string>{"apple", "apple", "fig", "kiwi",
+                                             "pear"});
+    REQUIRE(mapped == std::vector<int>{1, 3, 2, 4, 0});
+  }
+
+  SECTION("Large mapped values")
+  {
+    // Large mapped values are moved along the cycles of the permutation
+    // instead of being gathered into a buffer
+    SortByKeyInput input = random_input(500);
+    const auto long_string = [](std::size_t i) {
+      return "a long string that is not inlined " + std::to_string(i);
+    };
+    std::vector<std::string> mapped;
+    for (std::size_t i = 0; i < input.keys.size(); ++i) {
+      mapped.push_back(long_string(i));
+    }
+    std::vector<std::size_t> order(input.keys.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::ranges::stable_sort(
+        order, {}, [&](std::size_t i) { return input.original_keys[i]; });
+
+    beyond::stable_sort_by_key(input.keys.begin(), input.keys.end(),
+                               mapped.begin());
+    bool all_match = true;
+    for (std::size_t i = 0; i < order.size(); ++i) {
+      all_match = all_match && mapped[i] == long_string(order[i]);
+    }
+    REQUIRE(all_match);
+  }
+}
+
+TEST_CASE("Partial sort by key", "[beyond.core.algorithm.sort_by_key]")
+{
+  SortByKeyInput input = random_input(1000);
+  std::vector<int> expected = input.keys;
+  std::ranges::sort(expected);
+
+  for (const std::size_t middle : {0u, 1u, 16u, 1000u}) {
+    beyond::partial_sort_by_key(
+        input.keys.begin(),
+        input.keys.begin() + static_cast<std::ptrdiff_t>(middle),
+        input.keys.end(), input.mapped.begin());
+    REQUIRE(std::ranges::equal(
+        input.keys.begin(),
+        input.keys.begin() + static_cast<std::ptrdiff_t>(middle),
+        expected.begin(),
+        expected.begin() + static_cast<std::ptrdiff_t>(middle)));
+    REQUIRE(mapped_follow_keys(input));
+  }
+}
+
+TEST_CASE("Nth element by key", "[beyond.core.algorithm.sort_by_key]")
+{
+  static_assert(
+      !beyond::detail::ProxySortableByKey<std::vector<int>::iterator,
+                                          std::vector<Payload>::iterator>);
+  static_assert(
+      beyond::detail::ProxySortableByKey<std::vector<int>::iterator,
+                                         std::vector<std::size_t>::iterator>);
+
+  const std::size_t size = 1000;
+  const auto partitioned_at = [](const std::vector<int>& keys,
+                                 std::size_t nth) {
+    const auto nth_itr = keys.begin() + static_cast<std::ptrdiff_t>(nth);
+    return std::all_of(keys.begin(), nth_itr,
+                       [&](int key) { return key <= *nth_itr; }) &&
+           std::all_of(nth_itr, keys.end(),
+                       [&](int key) { return key >= *nth_itr; });
+  };
+
+  SECTION("Mapped values that are not default constructible")
+  {
+    SortByKeyInput input = random_input(size);
+    std::vector<int> expected = input.keys;
+    std::ranges::sort(expected);
+
+    for (const std::size_t nth : {0u, 10u, 500u, 999u}) {
+      beyond::nth_element_by_key(
+          input.keys.begin(),
+          input.keys.begin() + static_cast<std::ptrdiff_t>(nth),
+          input.keys.end(), input.mapped.begin());
+      REQUIRE(input.keys[nth] == expected[nth]);
+      REQUIRE(partitioned_at(input.keys, nth));
+      REQUIRE(mapped_follow_keys(input));
+    }
+  }
+
+  SECTION("Trivial mapped values")
+  {
+    const SortByKeyInput input = random_input(size);
+    std::vector<int> keys = input.keys;
+    std::vector<std::size_t> mapped(size);
+    std::iota(mapped.begin(), mapped.end(), std::size_t{0});
+    std::vector<int> expected = keys;
+    std::ranges::sort(expected);
+
+    for (const std::size_t nth : {0u, 10u, 500u, 999u}) {
+      beyond::nth_element_by_key(
+          keys.begin(), keys.begin() + static_cast<std::ptrdiff_t>(nth),
+          keys.end(), mapped.begin());
+      REQUIRE(keys[nth] == expected[nth]);
+      REQUIRE(partitioned_at(keys, nth));
+      // The mapped values are a permutation of the indices that still match
+      // their keys
+      std::vector<char> seen(size);
+      bool follow_keys = true;
+      for (std::size_t i = 0; i < size; ++i) {
+        follow_keys = follow_keys && seen[mapped[i]] == 0 &&
+                      input.original_keys[mapped[i]] == keys[i];
+        seen[mapped[i]] = 1;
+      }
+      REQUIRE(follow_keys);
+    }
+  }
+}
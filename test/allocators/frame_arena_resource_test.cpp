@@ -0,0 +1,97 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <beyond/allocators/frame_arena_resource.hpp>
+
+#include <cstdint>
+
+#include "../counting_resource.hpp"
+
+namespace {
+
+auto is_aligned(void* p, std::size_t alignment) -> bool
+{
+  return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+} // anonymous namespace
+
+TEST_CASE("FrameArenaResource", "[beyond.core.allocators.frame_arena]")
+{
+  CountingResource upstream;
+
+  {
+    beyond::FrameArenaResource arena{256, 2, upstream};
+    REQUIRE(arena.frames_in_flight() == 2);
+    REQUIRE(arena.frame_capacity() >= 256);
+    REQUIRE(upstream.allocations == 1);
+
+    SECTION("Allocations within a frame are bump allocated")
+    {
+      arena.begin_frame();
+      void* p1 = arena.allocate(16, 16);
+      void* p2 = arena.allocate(8, 8);
+      void* p3 = arena.allocate(32, 32);
+      REQUIRE(is_aligned(p1, 16));
+      REQUIRE(is_aligned(p2, 8));
+      REQUIRE(is_aligned(p3, 32));
+      REQUIRE(static_cast<std::byte*>(p2) > static_cast<std::byte*>(p1));
+      REQUIRE(static_cast<std::byte*>(p3) > static_cast<std::byte*>(p2));
+      REQUIRE(arena.bytes_allocated() == 56);
+      arena.deallocate(p1, 16, 16);
+      arena.end_frame();
+
+      REQUIRE(upstream.allocations == 1);
+    }
+
+    SECTION("Arenas are recycled after frames_in_flight frames")
+    {
+      arena.begin_frame();
+      void* frame0 = arena.allocate(64);
+      arena.end_frame();
+
+      arena.begin_frame();
+      void* frame1 = arena.allocate(64);
+      REQUIRE(frame1 != frame0);
+      arena.end_frame();
+
+      arena.begin_frame();
+      REQUIRE(arena.bytes_allocated() == 0);
+      void* frame2 = arena.allocate(64);
+      REQUIRE(frame2 == frame0);
+      arena.end_frame();
+      REQUIRE(arena.frame_count() == 3);
+    }
+
+    SECTION("Spills into upstream when a frame is over budget")
+    {
+      arena.begin_frame();
+      void* big = arena.allocate(1024);
+      REQUIRE(big != nullptr);
+      REQUIRE(upstream.allocations == 2);
+      void* small = arena.allocate(16);
+      REQUIRE(small != nullptr);
+      arena.end_frame();
+
+      arena.begin_frame();
+      arena.end_frame();
+      REQUIRE(upstream.deallocations == 0);
+
+      // Recycling the arena of the first frame releases the overflow block
+      arena.begin_frame();
+      REQUIRE(upstream.deallocations == 1);
+      arena.end_frame();
+    }
+  }
+
+  REQUIRE(upstream.allocations == upstream.deallocations);
+}
+
+TEST_CASE("FrameArenaResource equality",
+          "[beyond.core.allocators.frame_arena]")
+{
+  beyond::FrameArenaResource arena1{64};
+  beyond::FrameArenaResource arena2{64};
+  REQUIRE(arena1 == arena1);
+  REQUIRE(!(arena1 == arena2));
+  REQUIRE(arena1.upstream_resource() == beyond::get_default_resource());
+}
@@ -0,0 +1,71 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <beyond/concurrency/fixed_task_queue.hpp>
+
+#include <atomic>
+#include <latch>
+#include <vector>
+
+#include <jthread.hpp>
+
+#include "../counting_resource.hpp"
+
+TEST_CASE("Fixed task queue push and pop",
+          "[beyond.core.concurrency.fixed_task_queue]")
+{
+  CountingResource resource;
+  beyond::MemoryResource& previous = beyond::set_default_resource(resource);
+
+  {
+    beyond::FixedTaskQueue<2> queue;
+    STATIC_REQUIRE(decltype(queue)::max_size() == 2);
+    REQUIRE(queue.empty());
+
+    std::vector<int> output;
+    output.reserve(3);
+    REQUIRE(queue.try_push([&]() { output.push_back(1); }));
+    REQUIRE(queue.try_push([&]() { output.push_back(2); }));
+    REQUIRE(!queue.try_push([&]() { output.push_back(3); }));
+
+    auto task = queue.try_pop();
+    REQUIRE(task != beyond::nullopt);
+    (*task)();
+    REQUIRE(queue.try_push([&]() { output.push_back(3); }));
+
+    while (auto next = queue.try_pop()) {
+      (*next)();
+    }
+    REQUIRE(output == std::vector{1, 2, 3});
+    REQUIRE(queue.try_pop() == beyond::nullopt);
+  }
+
+  beyond::set_default_resource(previous);
+  REQUIRE(resource.allocations == 0);
+}
+
+TEST_CASE("Fixed task queue across threads",
+          "[beyond.core.concurrency.fixed_task_queue]")
+{
+  beyond::FixedTaskQueue<4> queue;
+  std::atomic<int> sum = 0;
+  std::latch finished{100};
+
+  {
+    nostd::jthread consumer{[&]() {
+      while (auto task = queue.pop()) {
+        (*task)();
+      }
+    }};
+
+    for (int i = 1; i <= 100; ++i) {
+      queue.push([&sum, &finished, i]() {
+        sum += i;
+        finished.count_down();
+      });
+    }
+    finished.wait();
+    queue.done();
+  }
+
+  REQUIRE(sum == 5050);
+}
@@ -77,3 +77,19 @@ TEST_CASE("Task Queue push and pop", "[beyond.core.concurrency.task_queue]")
     REQUIRE(output.size() == 6);
   }
 }
+
+TEST_CASE("Task Queue try_push", "[beyond.core.concurrency.task_queue]")
+{
+  // try_push used to return false exactly when it managed to take the lock,
+  // so it never pushed anything when the queue was not contended
+  beyond::TaskQueue queue;
+  int counter = 0;
+  REQUIRE(queue.try_push([&counter]() { ++counter; }));
+  REQUIRE(!queue.empty());
+
+  auto task = queue.try_pop();
+  REQUIRE(task != beyond::nullopt);
+  (*task)();
+  REQUIRE(counter == 1);
+  REQUIRE(queue.empty());
+}
@@ -1,116 +1,122 @@
-// #include <atomic>
-// #include <cstdint>
-// #include <jthread.hpp>
-//
-// #include <beyond/concurrency/task_queue.hpp>
-//
-//  namespace beyond {
-//
-///**
-// * @addtogroup core
-// * @{
-// * @addtogroup concurrency
-// * @{
-// */
-//
-// class ThreadPool {
-//  std::size_t count_ = std::thread::hardware_concurrency();
-//  std::vector<nostd::jthread> threads_;
-//  std::vector<TaskQueue> queues_{count_};
-//  std::atomic<std::size_t> index_ = 0;
-//
-// public:
-//  ThreadPool()
-//  {
-//    threads_.reserve(count_);
-//    for (std::uint32_t i = 0; i < count_; ++i) {
-//      threads_.emplace_back([this, i] { run(i); });
-//    }
-//  }
-//
-//  ~ThreadPool()
-//  {
-//    for (auto& queue : queues_) {
-//      queue.done();
-//    }
-//  }
-//
-//  ThreadPool(const ThreadPool&) = delete;
-//  auto operator=(const ThreadPool&) & -> ThreadPool& = delete;
-//  ThreadPool(ThreadPool&&) noexcept = delete;
-//  auto operator=(ThreadPool&&) & noexcept -> ThreadPool = delete;
-//
-//  [[nodiscard]] auto size() const noexcept -> std::size_t
-//  {
-//    return threads_.size();
-//  }
-//
-//  template <typename F> auto async(F&& f) -> void
-//  {
-//    const auto i = index_++;
-//
-//    for (std::size_t n = 0; n != count_; ++n) {
-//      if (queues_[(i + n) % count_].try_push(std::forward<F>(f))) return;
-//    }
-//
-//    queues_[i % count_].push(std::forward<F>(f));
-//  }
-//
-// private:
-//  auto run(unsigned i) -> void
-//  {
-//    beyond::unique_function<void() const> f;
-//
-//    while (true) {
-//      for (std::size_t n = 0; n != count_; ++n) {
-//        if (auto f_out = queues_[(i + n) % count_].try_pop();
-//            f_out != beyond::nullopt) {
-//          f = std::move(*f_out);
-//          break;
-//        }
-//      }
-//      if (f) {
-//        f();
-//      } else {
-//        auto f_opt = queues_[i].pop();
-//        if (!f_opt) break;
-//        (*f_opt)();
-//      }
-//    }
-//  }
-//};
-//
-///** @}@} */
-//
-//} // namespace beyond
-//
-// #include <catch2/catch_test_macros.hpp>
-//
-// TEST_CASE("Thread Pool", "[beyond.core.concurrency.thread_pool]")
-//{
-//  beyond::ThreadPool thread_pool;
-//  REQUIRE(thread_pool.size() == std::thread::hardware_concurrency());
-//
-//  int x = 0;
-//  int y = 1;
-//  std::atomic<bool> done_flag = false;
-//  std::atomic<bool> done_flag2 = false;
-//
-//  thread_pool.async([&]() {
-//    std::cout << "Task 1" << std::endl;
-//    x = 42;
-//    done_flag.store(true);
-//  });
-//
-//  thread_pool.async([&]() {
-//    std::cout << "Task 2" << std::endl;
-//    y = 42;
-//    done_flag2.store(true);
-//  });
-//
-//  while (!done_flag.load()) {}
-//  while (!done_flag2.load()) {}
-//
-//  REQUIRE(x == 42);
-//  REQUIRE(y == 42);
-//}
+#include <catch2/catch_test_macros.hpp>
+
+#include <beyond/concurrency/thread_pool.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <latch>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Thread Pool", "[beyond.core.concurrency.thread_pool]")
+{
+  beyond::ThreadPool thread_pool;
+  REQUIRE(thread_pool.size() ==
+          std::max(std::thread::hardware_concurrency(), 1u));
+
+  int x = 0;
+  int y = 1;
+  std::atomic<bool> done_flag = false;
+  std::atomic<bool> done_flag2 = false;
+
+  thread_pool.async([&]() {
+    x = 42;
+    done_flag.store(true);
+  });
+
+  thread_pool.async([&]() {
+    y = 42;
+    done_flag2.store(true);
+  });
+
+  while (!done_flag.load()) {}
+  while (!done_flag2.load()) {}
+
+  REQUIRE(x == 42);
+  REQUIRE(y == 42);
+}
+
+TEST_CASE("Thread Pool runs every task", "[beyond.core.concurrency.thread_pool]")
+{
+  constexpr int task_count = 1000;
+  std::atomic<int> counter = 0;
+
+  {
+    beyond::ThreadPool thread_pool{4};
+    REQUIRE(thread_pool.size() == 4);
+
+    for (int i = 0; i < task_count; ++i) {
+      thread_pool.async([&]() { counter.fetch_add(1); });
+    }
+    while (counter.load() != task_count) {}
+  }
+
+  REQUIRE(counter.load() == task_count);
+}
+
+TEST_CASE("Thread Pool finishes pending tasks before it is destroyed",
+          "[beyond.core.concurrency.thread_pool]")
+{
+  constexpr int task_count = 100;
+  std::atomic<int> counter = 0;
+  std::latch release{1};
+
+  {
+    beyond::ThreadPool thread_pool{1};
+    // Keeps the only worker busy, so that every other task is still queued
+    // when the destructor runs
+    thread_pool.async([&]() { release.wait(); });
+    for (int i = 0; i < task_count; ++i) {
+      thread_pool.async([&]() {
+        counter.fetch_add(1);
+        // Tasks started while the pool is being destroyed also run
+        thread_pool.async([&]() { counter.fetch_add(1); });
+      });
+    }
+    release.count_down();
+  }
+
+  REQUIRE(counter.load() == 2 * task_count);
+}
+
+TEST_CASE("parallel_for", "[beyond.core.concurrency.thread_pool]")
+{
+  beyond::ThreadPool thread_pool{2};
+
+  SECTION("Runs every index once")
+  {
+    std::vector<int> runs(100);
+    beyond::parallel_for(&thread_pool, runs.size(),
+                         [&](std::size_t i) { ++runs[i]; });
+    REQUIRE(std::ranges::all_of(runs, [](int n) { return n == 1; }));
+  }
+
+  SECTION("Runs on the calling thread without a pool")
+  {
+    const auto caller = std::this_thread::get_id();
+    bool on_caller = true;
+    beyond::parallel_for(nullptr, 10, [&](std::size_t) {
+      on_caller = on_caller && std::this_thread::get_id() == caller;
+    });
+    REQUIRE(on_caller);
+  }
+
+  SECTION("Chunks cover the range")
+  {
+    constexpr std::size_t chunk_count = 3;
+    std::vector<int> runs(100);
+    std::array<std::size_t, chunk_count> sizes{};
+    beyond::parallel_for_chunks(
+        &thread_pool, chunk_count, 10, runs.size(),
+        [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+          sizes[chunk] = end - begin;
+          for (std::size_t i = begin; i < end; ++i) { ++runs[i]; }
+        });
+    REQUIRE(std::ranges::all_of(runs.begin(), runs.begin() + 10,
+                                [](int n) { return n == 0; }));
+    REQUIRE(std::ranges::all_of(runs.begin() + 10, runs.end(),
+                                [](int n) { return n == 1; }));
+    REQUIRE(sizes == std::array<std::size_t, chunk_count>{30, 30, 30});
+  }
+}
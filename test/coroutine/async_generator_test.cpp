@@ -0,0 +1,160 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <beyond/concurrency/thread_pool.hpp>
+#include <beyond/coroutine/async_generator.hpp>
+#include <beyond/coroutine/task.hpp>
+
+#include "../counting_resource.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+namespace {
+
+// Stands in for a file whose chunks are read asynchronously on a thread pool
+class FakeFileReader {
+public:
+  FakeFileReader(std::string_view contents, std::size_t chunk_size,
+                 beyond::ThreadPool& pool)
+      : contents_{contents}, chunk_size_{chunk_size}, pool_{&pool}
+  {
+  }
+
+  // Returns an empty chunk at the end of the file
+  auto read_chunk() -> beyond::Task<std::string_view>
+  {
+    co_await beyond::schedule_on(*pool_);
+    const auto chunk = contents_.substr(0, chunk_size_);
+    contents_.remove_prefix(chunk.size());
+    co_return chunk;
+  }
+
+private:
+  std::string_view contents_;
+  std::size_t chunk_size_;
+  beyond::ThreadPool* pool_;
+};
+
+auto stream_chunks(FakeFileReader& reader)
+    -> beyond::AsyncGenerator<std::string_view>
+{
+  while (true) {
+    const auto chunk = co_await reader.read_chunk();
+    if (chunk.empty()) { break; }
+    co_yield chunk;
+  }
+}
+
+auto concat(beyond::AsyncGenerator<std::string_view> chunks)
+    -> beyond::Task<std::string>
+{
+  std::string result;
+  for (auto itr = co_await chunks.begin(); itr != chunks.end();
+       co_await ++itr) {
+    result += *itr;
+    result += '|';
+  }
+  co_return result;
+}
+
+auto count_to(int n) -> beyond::AsyncGenerator<int>
+{
+  for (int i = 0; i < n; ++i) {
+    co_yield i;
+  }
+}
+
+auto count_to(std::allocator_arg_t, beyond::MemoryResource&, int n)
+    -> beyond::AsyncGenerator<int>
+{
+  for (int i = 0; i < n; ++i) {
+    co_yield i;
+  }
+}
+
+auto sum(beyond::AsyncGenerator<int> gen) -> beyond::Task<int>
+{
+  int result = 0;
+  for (auto itr = co_await gen.begin(); itr != gen.end(); co_await ++itr) {
+    result += *itr;
+  }
+  co_return result;
+}
+
+// Consumes and destroys the generator on a worker thread of `pool`
+auto sum_on(beyond::ThreadPool& pool, beyond::AsyncGenerator<int> gen)
+    -> beyond::Task<int>
+{
+  co_await beyond::schedule_on(pool);
+  co_return co_await sum(std::move(gen));
+}
+
+auto throw_after_one() -> beyond::AsyncGenerator<int>
+{
+  co_yield 1;
+  throw std::runtime_error{"read error"};
+}
+
+} // anonymous namespace
+
+TEST_CASE("AsyncGenerator", "[beyond.core.coroutine.async_generator]")
+{
+  SECTION("Synchronous generator")
+  {
+    REQUIRE(beyond::sync_wait(sum(count_to(5))) == 10);
+    REQUIRE(beyond::sync_wait(sum(count_to(0))) == 0);
+  }
+
+  SECTION("Awaits between yields")
+  {
+    beyond::ThreadPool pool{2};
+    FakeFileReader reader{"Hello, world!", 5, pool};
+    REQUIRE(beyond::sync_wait(concat(stream_chunks(reader))) ==
+            "Hello|, wor|ld!|");
+  }
+
+  SECTION("Exceptions propagate to the consumer")
+  {
+    REQUIRE_THROWS_AS(beyond::sync_wait(sum(throw_after_one())),
+                      std::runtime_error);
+  }
+}
+
+TEST_CASE("AsyncGenerator frame allocation",
+          "[beyond.core.coroutine.async_generator]")
+{
+  CountingResource upstream;
+
+  SECTION("Allocates from the resource passed by allocator_arg")
+  {
+    REQUIRE(beyond::sync_wait(sum(count_to(std::allocator_arg, upstream, 4))) ==
+            6);
+    REQUIRE(upstream.allocations == 1);
+    REQUIRE(upstream.deallocations == 1);
+  }
+
+  SECTION("Ignores the thread-local resource")
+  {
+    beyond::CoroutineFramePool pool{upstream};
+    auto& previous = beyond::set_coroutine_frame_resource(pool);
+    REQUIRE(beyond::sync_wait(sum(count_to(4))) == 6);
+    beyond::set_coroutine_frame_resource(previous);
+    REQUIRE(upstream.allocations == 0);
+  }
+
+  SECTION("Can be destroyed on a pool worker")
+  {
+    // Created with a pool set on this thread, and destroyed on a worker
+    beyond::CoroutineFramePool frame_pool{upstream};
+    auto& previous = beyond::set_coroutine_frame_resource(frame_pool);
+    beyond::ThreadPool pool{2};
+    for (int i = 0; i < 100; ++i) {
+      REQUIRE(beyond::sync_wait(sum_on(pool, count_to(i))) == i * (i - 1) / 2);
+    }
+    beyond::set_coroutine_frame_resource(previous);
+    REQUIRE(upstream.allocations == 0);
+  }
+}
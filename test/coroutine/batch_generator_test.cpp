@@ -0,0 +1,87 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <beyond/coroutine/batch_generator.hpp>
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+auto iota_batches(int count) -> beyond::BatchGenerator<int>
+{
+  std::array<int, 16> buffer{};
+  for (int i = 0; i < count; i += static_cast<int>(buffer.size())) {
+    const auto n = std::min(buffer.size(), static_cast<std::size_t>(count - i));
+    std::iota(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(n),
+              i);
+    co_yield std::span<const int>{buffer}.first(n);
+  }
+}
+
+auto with_empty_batches() -> beyond::BatchGenerator<int>
+{
+  const std::array buffer{1, 2, 3};
+  co_yield {};
+  co_yield std::span{buffer}.first(1);
+  co_yield {};
+  co_yield {};
+  co_yield std::span{buffer}.subspan(1);
+  co_yield {};
+}
+
+auto throw_after_one_batch() -> beyond::BatchGenerator<int>
+{
+  const std::array buffer{1, 2};
+  co_yield std::span{buffer};
+  throw std::runtime_error{"Generator Throw"};
+}
+
+} // anonymous namespace
+
+static_assert(std::ranges::input_range<beyond::BatchGenerator<int>>);
+
+TEST_CASE("BatchGenerator", "[beyond.core.coroutine.batch_generator]")
+{
+  SECTION("next_batch")
+  {
+    auto gen = iota_batches(40);
+    REQUIRE(gen.next_batch().size() == 16);
+    const auto batch = gen.next_batch();
+    REQUIRE(batch.size() == 16);
+    REQUIRE(batch.front() == 16);
+    REQUIRE(gen.next_batch().size() == 8);
+    REQUIRE(gen.next_batch().empty());
+    REQUIRE(gen.next_batch().empty());
+  }
+
+  SECTION("Iterates over the elements of all batches")
+  {
+    std::vector<int> expected(40);
+    std::iota(expected.begin(), expected.end(), 0);
+    REQUIRE(std::ranges::equal(iota_batches(40), expected));
+    REQUIRE(std::ranges::equal(iota_batches(32),
+                               expected | std::views::take(32)));
+
+    auto empty = iota_batches(0);
+    REQUIRE(empty.begin() == empty.end());
+  }
+
+  SECTION("Skips empty batches")
+  {
+    REQUIRE(std::ranges::equal(with_empty_batches(), std::array{1, 2, 3}));
+  }
+
+  SECTION("Generator that throw")
+  {
+    auto gen = throw_after_one_batch();
+    auto itr = gen.begin();
+    REQUIRE(*itr == 1);
+    ++itr;
+    REQUIRE(*itr == 2);
+    REQUIRE_THROWS(++itr);
+  }
+}
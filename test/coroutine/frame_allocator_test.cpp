@@ -0,0 +1,150 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <beyond/coroutine/frame_allocator.hpp>
+#include <beyond/coroutine/generator.hpp>
+
+#include "../counting_resource.hpp"
+
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <thread>
+
+namespace {
+
+auto range(int low, int high) -> beyond::Generator<int>
+{
+  for (int i = low; i < high; ++i) {
+    co_yield i;
+  }
+}
+
+auto range(std::allocator_arg_t, beyond::MemoryResource&, int low, int high)
+    -> beyond::Generator<int>
+{
+  for (int i = low; i < high; ++i) {
+    co_yield i;
+  }
+}
+
+struct Counter {
+  int count = 0;
+
+  auto range(std::allocator_arg_t, beyond::MemoryResource&) const
+      -> beyond::Generator<int>
+  {
+    for (int i = 0; i < count; ++i) {
+      co_yield i;
+    }
+  }
+};
+
+auto sum(beyond::Generator<int> gen) -> int
+{
+  int result = 0;
+  for (int x : gen) {
+    result += x;
+  }
+  return result;
+}
+
+} // anonymous namespace
+
+TEST_CASE("CoroutineFramePool", "[beyond.core.coroutine.frame_allocator]")
+{
+  CountingResource upstream;
+
+  {
+    beyond::CoroutineFramePool pool{upstream};
+    REQUIRE(&pool.upstream_resource() == &upstream);
+
+    SECTION("Recycles blocks of the same size class")
+    {
+      void* p1 = pool.allocate(100);
+      pool.deallocate(p1, 100);
+      void* p2 = pool.allocate(120);
+      REQUIRE(p2 == p1);
+      pool.deallocate(p2, 120);
+      REQUIRE(upstream.allocations == 1);
+    }
+
+    SECTION("Different size classes do not share blocks")
+    {
+      void* p1 = pool.allocate(64);
+      pool.deallocate(p1, 64);
+      void* p2 = pool.allocate(65);
+      pool.deallocate(p2, 65);
+      REQUIRE(upstream.allocations == 2);
+    }
+
+    SECTION("Large blocks go to the upstream resource")
+    {
+      constexpr auto size = beyond::CoroutineFramePool::max_pooled_size + 1;
+      void* p = pool.allocate(size);
+      pool.deallocate(p, size);
+      REQUIRE(upstream.allocations == 1);
+      REQUIRE(upstream.deallocations == 1);
+    }
+
+    SECTION("release returns the cached blocks")
+    {
+      pool.deallocate(pool.allocate(10), 10);
+      pool.release();
+      REQUIRE(upstream.deallocations == 1);
+    }
+  }
+
+  REQUIRE(upstream.allocations == upstream.deallocations);
+}
+
+TEST_CASE("Generator frame allocation",
+          "[beyond.core.coroutine.frame_allocator]")
+{
+  CountingResource upstream;
+
+  SECTION("Allocates from the resource passed by allocator_arg")
+  {
+    REQUIRE(sum(range(std::allocator_arg, upstream, 0, 4)) == 6);
+    REQUIRE(upstream.allocations == 1);
+    REQUIRE(upstream.deallocations == 1);
+  }
+
+  SECTION("Member function coroutines")
+  {
+    const Counter counter{.count = 4};
+    REQUIRE(sum(counter.range(std::allocator_arg, upstream)) == 6);
+    REQUIRE(upstream.allocations == 1);
+    REQUIRE(upstream.deallocations == 1);
+  }
+
+  SECTION("Uses the global operator new by default")
+  {
+    REQUIRE(&beyond::get_coroutine_frame_resource() ==
+            &beyond::new_delete_resource());
+
+    // A generator created on one thread can be destroyed on another one, even
+    // after the thread that created it has exited
+    std::optional<beyond::Generator<int>> gen;
+    std::thread{[&] { gen.emplace(range(0, 4)); }}.join();
+    auto itr = gen->begin();
+    REQUIRE(*itr == 0);
+    std::thread{[&] { gen.reset(); }}.join();
+    REQUIRE(!gen.has_value());
+  }
+
+  SECTION("Recycles the frames through the thread-local resource")
+  {
+    {
+      beyond::CoroutineFramePool pool{upstream};
+      auto& previous = beyond::set_coroutine_frame_resource(pool);
+      for (int i = 0; i < 100; ++i) {
+        REQUIRE(sum(range(0, i)) == i * (i - 1) / 2);
+      }
+      REQUIRE(&beyond::set_coroutine_frame_resource(previous) == &pool);
+      REQUIRE(upstream.allocations == 1);
+    }
+    REQUIRE(upstream.deallocations == 1);
+    REQUIRE(&beyond::get_coroutine_frame_resource() ==
+            &beyond::new_delete_resource());
+  }
+}
@@ -6,6 +6,8 @@
 #include <iostream>
 #include <memory>
 #include <ranges>
+#include <stdexcept>
+#include <vector>
 
 static auto range(int low, int high) -> beyond::Generator<int>
 {
@@ -66,4 +68,101 @@ TEST_CASE("Generator that throw", "[beyond.core.coroutine.generator]")
   REQUIRE(*itr == 1);
   REQUIRE_THROWS(++itr);
   REQUIRE(itr == gen.end());
-}
\ No newline at end of file
+}
+namespace {
+
+struct Node {
+  int value = 0;
+  std::vector<Node> children;
+};
+
+auto pre_order(const Node& node) -> beyond::Generator<int>
+{
+  co_yield node.value;
+  for (const Node& child : node.children) {
+    co_yield beyond::elements_of(pre_order(child));
+  }
+}
+
+auto countdown(int n) -> beyond::Generator<int>
+{
+  if (n < 0) { co_return; }
+  co_yield n;
+  co_yield beyond::elements_of(countdown(n - 1));
+}
+
+auto nested_throw() -> beyond::Generator<int>
+{
+  co_yield 1;
+  co_yield beyond::elements_of(range_exp(2, 3));
+  co_yield 42;
+}
+
+auto flatten(const std::vector<int>& v) -> beyond::Generator<int>
+{
+  co_yield 0;
+  co_yield beyond::elements_of(std::views::iota(1, 3));
+  co_yield beyond::elements_of(v);
+}
+
+auto around(beyond::Generator<int> nested) -> beyond::Generator<int>
+{
+  co_yield 1;
+  co_yield beyond::elements_of(std::move(nested));
+  co_yield 2;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Recursive generator", "[beyond.core.coroutine.generator]")
+{
+  SECTION("Yields the elements of nested generators in order")
+  {
+    const Node tree{1,
+                    {Node{2, {Node{3, {}}, Node{4, {}}}}, Node{5, {}},
+                     Node{6, {Node{7, {}}}}}};
+    REQUIRE(std::ranges::equal(pre_order(tree),
+                               std::vector{1, 2, 3, 4, 5, 6, 7}));
+  }
+
+  SECTION("Deeply nested generators")
+  {
+    constexpr int depth = 10'000;
+    int expected = depth;
+    for (int x : countdown(depth)) {
+      REQUIRE(x == expected--);
+    }
+    REQUIRE(expected == -1);
+  }
+
+  SECTION("Destroying the outer generator destroys the nested ones")
+  {
+    REQUIRE(std::ranges::equal(countdown(100) | std::views::take(3),
+                               std::vector{100, 99, 98}));
+  }
+
+  SECTION("Exceptions propagate through the nested generators")
+  {
+    auto gen = nested_throw();
+    auto itr = gen.begin();
+    REQUIRE(*itr == 1);
+    ++itr;
+    REQUIRE(*itr == 2);
+    REQUIRE_THROWS_AS(++itr, std::runtime_error);
+    REQUIRE(itr == gen.end());
+  }
+
+  SECTION("Yielding a finished generator yields nothing")
+  {
+    auto finished = countdown(3);
+    for ([[maybe_unused]] int x : finished) {}
+    REQUIRE(std::ranges::equal(around(std::move(finished)),
+                               std::vector{1, 2}));
+  }
+
+  SECTION("Yields the elements of other ranges")
+  {
+    REQUIRE(std::ranges::equal(flatten(std::vector<int>{3, 4}),
+                               std::vector{0, 1, 2, 3, 4}));
+  }
+}
@@ -0,0 +1,127 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <beyond/concurrency/thread_pool.hpp>
+#include <beyond/coroutine/task.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+auto forty_two(bool& started) -> beyond::Task<int>
+{
+  started = true;
+  co_return 42;
+}
+
+auto add_one(beyond::Task<int> task) -> beyond::Task<int>
+{
+  co_return co_await std::move(task) + 1;
+}
+
+auto make_unique_int(int value) -> beyond::Task<std::unique_ptr<int>>
+{
+  co_return std::make_unique<int>(value);
+}
+
+auto ready(int value) -> beyond::Task<int>
+{
+  co_return value;
+}
+
+auto sum_many(int count) -> beyond::Task<int>
+{
+  int sum = 0;
+  for (int i = 0; i < count; ++i) {
+    sum += co_await ready(1);
+  }
+  co_return sum;
+}
+
+auto throws() -> beyond::Task<int>
+{
+  throw std::runtime_error{"task failed"};
+  co_return 0;
+}
+
+auto rethrows() -> beyond::Task<>
+{
+  co_await throws();
+}
+
+auto thread_id_on(beyond::ThreadPool& pool) -> beyond::Task<std::thread::id>
+{
+  co_await beyond::schedule_on(pool);
+  co_return std::this_thread::get_id();
+}
+
+} // anonymous namespace
+
+TEST_CASE("Task", "[beyond.core.coroutine.task]")
+{
+  SECTION("Task is lazily started")
+  {
+    bool started = false;
+    auto task = forty_two(started);
+    REQUIRE(!started);
+    REQUIRE(!task.is_ready());
+
+    REQUIRE(beyond::sync_wait(std::move(task)) == 42);
+    REQUIRE(started);
+  }
+
+  SECTION("Awaits other tasks")
+  {
+    bool started = false;
+    REQUIRE(beyond::sync_wait(add_one(add_one(forty_two(started)))) == 44);
+  }
+
+  SECTION("Move-only results")
+  {
+    const auto result = beyond::sync_wait(make_unique_int(3));
+    REQUIRE(result != nullptr);
+    REQUIRE(*result == 3);
+  }
+
+  SECTION("Awaiting a lot of synchronously completed tasks does not overflow "
+          "the stack")
+  {
+    // Symmetric transfer relies on tail calls, which compilers only guarantee
+    // to emit in optimized builds
+#ifdef NDEBUG
+    constexpr int count = 1'000'000;
+#else
+    constexpr int count = 1'000;
+#endif
+    REQUIRE(beyond::sync_wait(sum_many(count)) == count);
+  }
+
+  SECTION("Exceptions propagate to the awaiter")
+  {
+    REQUIRE_THROWS_AS(beyond::sync_wait(rethrows()), std::runtime_error);
+  }
+}
+
+TEST_CASE("Task with schedule_on", "[beyond.core.coroutine.task]")
+{
+  beyond::ThreadPool pool{2};
+  const auto id = beyond::sync_wait(thread_id_on(pool));
+  REQUIRE(id != std::this_thread::get_id());
+}
+
+TEST_CASE("sync_wait on tasks that complete on a worker thread",
+          "[beyond.core.coroutine.task]")
+{
+  // The task completes on a worker thread while the calling thread destroys
+  // the coroutine frame. Run with BEYOND_CORE_USE_ASAN or BEYOND_CORE_USE_TSAN
+  // to catch accesses to the frame after it is destroyed
+  beyond::ThreadPool pool{2};
+  const auto this_id = std::this_thread::get_id();
+  bool all_on_pool = true;
+  for (int i = 0; i < 5000; ++i) {
+    all_on_pool =
+        all_on_pool && beyond::sync_wait(thread_id_on(pool)) != this_id;
+  }
+  REQUIRE(all_on_pool);
+}
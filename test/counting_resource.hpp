@@ -0,0 +1,33 @@
+#ifndef BEYOND_CORE_TEST_COUNTING_RESOURCE_HPP
+#define BEYOND_CORE_TEST_COUNTING_RESOURCE_HPP
+
+#include <beyond/allocators/global_resource.hpp>
+
+// A memory resource that counts the allocations it forwards to the new-delete
+// resource
+struct CountingResource : beyond::MemoryResource {
+  int allocations = 0;
+  int deallocations = 0;
+
+private:
+  auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override
+  {
+    ++allocations;
+    return beyond::new_delete_resource().allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* p, std::size_t bytes,
+                     std::size_t alignment) override
+  {
+    ++deallocations;
+    beyond::new_delete_resource().deallocate(p, bytes, alignment);
+  }
+
+  [[nodiscard]] auto do_is_equal(const MemoryResource& other) const noexcept
+      -> bool override
+  {
+    return &other == this;
+  }
+};
+
+#endif // BEYOND_CORE_TEST_COUNTING_RESOURCE_HPP
@@ -89,6 +89,29 @@ TEST_CASE("AABB3 union", "[AABB3]")
           AABB3{{-1, -1, -1}, {1, 1, 1}, AABB3::unchecked_tag});
 }
 
+TEST_CASE("AABB3 overlap and containment", "[AABB3]")
+{
+  const auto make_box = [](Point3 min, Point3 max) {
+    return AABB3{min, max, AABB3::unchecked_tag};
+  };
+  const AABB3 box = make_box({0, 0, 0}, {1, 1, 1});
+
+  REQUIRE(overlaps(box, make_box({0.5, 0.5, 0.5}, {2, 2, 2})));
+  REQUIRE(overlaps(box, make_box({1, 1, 1}, {2, 2, 2})));
+  REQUIRE(!overlaps(box, make_box({1.5, 0, 0}, {2, 1, 1})));
+  REQUIRE(!overlaps(box, make_box({0, 0, -2}, {1, 1, -1})));
+
+  REQUIRE(contains(box, box));
+  REQUIRE(contains(box, make_box({0.2f, 0.2f, 0.2f}, {0.8f, 1, 0.5f})));
+  REQUIRE(!contains(box, make_box({0.2f, 0.2f, 0.2f}, {0.8f, 1.1f, 0.5f})));
+}
+
+TEST_CASE("AABB3 half surface area", "[AABB3]")
+{
+  REQUIRE(half_surface_area(AABB3{{0, 0, 0}, {1, 2, 3}}) == 11.f);
+  REQUIRE(half_surface_area(AABB3{{1, 1, 1}}) == 0.f);
+}
+
 TEST_CASE("AABB3 Serialization", "[AABB3]")
 {
   const auto expected = "AABB3(min: point(0, 0, 0), max: point(1, 1, 1))";
@@ -0,0 +1,298 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "beyond/concurrency/thread_pool.hpp"
+#include "beyond/geometry/bvh.hpp"
+#include "beyond/random/generators/xorshift32.hpp"
+
+#include "random_boxes.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+using beyond::AABB3;
+using beyond::BVH;
+using beyond::Point3;
+using beyond::Ray;
+using beyond::Vec3;
+
+namespace {
+
+constexpr float inf = std::numeric_limits<float>::infinity();
+
+// Checks the structure of the subtree at `index` and returns the index after
+// its last node
+auto check_subtree(const BVH& bvh, std::span<const AABB3> boxes,
+                   std::uint32_t index, std::size_t max_leaf_size,
+                   std::vector<int>& primitive_seen) -> std::uint32_t
+{
+  const BVH::Node& node = bvh.nodes()[index];
+  if (node.is_leaf()) {
+    REQUIRE(node.primitive_count <= max_leaf_size);
+    for (std::uint32_t i = 0; i < node.primitive_count; ++i) {
+      const std::uint32_t primitive =
+          bvh.primitive_indices()[node.offset + i];
+      REQUIRE(contains(node.bounds, boxes[primitive]));
+      ++primitive_seen[primitive];
+    }
+    return index + 1;
+  }
+
+  const BVH::Node& left = bvh.nodes()[index + 1];
+  const BVH::Node& right = bvh.nodes()[node.offset];
+  REQUIRE(contains(node.bounds, left.bounds));
+  REQUIRE(contains(node.bounds, right.bounds));
+  const std::uint32_t left_end =
+      check_subtree(bvh, boxes, index + 1, max_leaf_size, primitive_seen);
+  REQUIRE(left_end == node.offset);
+  return check_subtree(bvh, boxes, node.offset, max_leaf_size, primitive_seen);
+}
+
+auto brute_force_hit(const Ray& ray, std::span<const AABB3> boxes)
+    -> beyond::optional<BVH::Hit>
+{
+  const Vec3 inv_direction{1 / ray.direction.x, 1 / ray.direction.y,
+                           1 / ray.direction.z};
+  beyond::optional<BVH::Hit> result;
+  float nearest = inf;
+  for (std::size_t i = 0; i < boxes.size(); ++i) {
+    const float t = beyond::detail::ray_box_entry(boxes[i], ray.origin,
+                                                  inv_direction, 0, nearest);
+    if (t != inf) {
+      nearest = t;
+      result = BVH::Hit{static_cast<std::uint32_t>(i), t};
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("BVH construction", "[beyond.core.geometry.bvh]")
+{
+  SECTION("Empty BVH")
+  {
+    const BVH bvh;
+    REQUIRE(bvh.empty());
+    REQUIRE(!bvh.intersect(Ray{}, std::span<const AABB3>{}, 0, inf));
+
+    const BVH from_no_boxes{std::span<const AABB3>{}};
+    REQUIRE(from_no_boxes.empty());
+  }
+
+  SECTION("A single box is a leaf")
+  {
+    const AABB3 box{Point3{0, 0, 0}, Point3{1, 1, 1}};
+    const BVH bvh{std::span{&box, 1}};
+    REQUIRE(bvh.nodes().size() == 1);
+    REQUIRE(bvh.nodes()[0].is_leaf());
+    REQUIRE(bvh.bounds() == box);
+  }
+
+  SECTION("Every primitive is in exactly one leaf")
+  {
+    const std::vector<AABB3> boxes = random_boxes(1000, 42);
+    for (const std::size_t max_leaf_size : {1u, 4u, 16u}) {
+      const BVH bvh{boxes, max_leaf_size};
+      REQUIRE(bvh.primitive_indices().size() == boxes.size());
+
+      std::vector<int> primitive_seen(boxes.size());
+      const std::uint32_t end =
+          check_subtree(bvh, boxes, 0, max_leaf_size, primitive_seen);
+      REQUIRE(end == bvh.nodes().size());
+      for (const int seen : primitive_seen) { REQUIRE(seen == 1); }
+    }
+  }
+
+  SECTION("Identical boxes are still split into small leaves")
+  {
+    const std::vector<AABB3> boxes(100,
+                                   AABB3{Point3{0, 0, 0}, Point3{1, 1, 1}});
+    const BVH bvh{boxes, 4};
+    std::vector<int> primitive_seen(boxes.size());
+    check_subtree(bvh, boxes, 0, 4, primitive_seen);
+    for (const int seen : primitive_seen) { REQUIRE(seen == 1); }
+  }
+}
+
+TEST_CASE("Parallel BVH construction", "[beyond.core.geometry.bvh]")
+{
+  const auto require_same_tree = [](const BVH& lhs, const BVH& rhs) {
+    const auto same_node = [](const BVH::Node& a, const BVH::Node& b) {
+      return a.bounds == b.bounds && a.offset == b.offset &&
+             a.primitive_count == b.primitive_count;
+    };
+    REQUIRE(std::ranges::equal(lhs.nodes(), rhs.nodes(), same_node));
+    REQUIRE(std::ranges::equal(lhs.primitive_indices(),
+                               rhs.primitive_indices()));
+  };
+
+  SECTION("Empty BVH")
+  {
+    beyond::ThreadPool pool{2};
+    REQUIRE(BVH{std::span<const AABB3>{}, pool}.empty());
+  }
+
+  SECTION("Same tree as the sequential build for any number of threads")
+  {
+    // Large enough for several levels of data parallel splits
+    const std::vector<AABB3> boxes = random_boxes(40'000, 3);
+    const BVH expected{boxes};
+    for (const std::size_t thread_count : {1u, 3u}) {
+      beyond::ThreadPool pool{thread_count};
+      require_same_tree(BVH{boxes, pool}, expected);
+    }
+  }
+
+  SECTION("Identical boxes")
+  {
+    const std::vector<AABB3> boxes(20'000,
+                                   AABB3{Point3{0, 0, 0}, Point3{1, 1, 1}});
+    beyond::ThreadPool pool{2};
+    require_same_tree(BVH{boxes, pool}, BVH{boxes});
+  }
+}
+
+TEST_CASE("Linear BVH construction", "[beyond.core.geometry.bvh]")
+{
+  SECTION("Empty BVH")
+  {
+    REQUIRE(BVH{std::span<const AABB3>{}, BVH::linear_tag}.empty());
+  }
+
+  SECTION("Every primitive is in exactly one leaf")
+  {
+    const std::vector<AABB3> boxes = random_boxes(1000, 42);
+    for (const std::size_t max_leaf_size : {1u, 4u, 16u}) {
+      const BVH bvh{boxes, BVH::linear_tag, max_leaf_size};
+      REQUIRE(bvh.primitive_indices().size() == boxes.size());
+
+      std::vector<int> primitive_seen(boxes.size());
+      const std::uint32_t end =
+          check_subtree(bvh, boxes, 0, max_leaf_size, primitive_seen);
+      REQUIRE(end == bvh.nodes().size());
+      for (const int seen : primitive_seen) { REQUIRE(seen == 1); }
+    }
+  }
+
+  SECTION("Identical boxes are still split into small leaves")
+  {
+    const std::vector<AABB3> boxes(100,
+                                   AABB3{Point3{0, 0, 0}, Point3{1, 1, 1}});
+    const BVH bvh{boxes, BVH::linear_tag, 1};
+    std::vector<int> primitive_seen(boxes.size());
+    check_subtree(bvh, boxes, 0, 1, primitive_seen);
+    for (const int seen : primitive_seen) { REQUIRE(seen == 1); }
+  }
+
+  SECTION("Finds the same nearest hits as brute force")
+  {
+    const std::vector<AABB3> boxes = random_boxes(2000, 8);
+    const BVH bvh{boxes, BVH::linear_tag};
+    beyond::xorshift32 rng{124};
+    std::uniform_real_distribution<float> dist{-1.f, 1.f};
+    bool all_equal = true;
+    for (int i = 0; i < 500; ++i) {
+      const Ray ray{Point3{150 * dist(rng), 150 * dist(rng), 150 * dist(rng)},
+                    Vec3{dist(rng), dist(rng), dist(rng)}};
+      const auto expected = brute_force_hit(ray, boxes);
+      const auto hit = bvh.intersect(ray, boxes, 0, inf);
+      all_equal = all_equal && hit.has_value() == expected.has_value() &&
+                  (!hit || hit->t == expected->t);
+    }
+    REQUIRE(all_equal);
+  }
+
+  SECTION("Same tree with the parallel build for any number of threads")
+  {
+    const std::vector<AABB3> boxes = random_boxes(60'000, 4);
+    const BVH expected{boxes, BVH::linear_tag};
+    for (const std::size_t thread_count : {1u, 3u}) {
+      beyond::ThreadPool pool{thread_count};
+      const BVH bvh{boxes, BVH::linear_tag, pool};
+      REQUIRE(std::ranges::equal(
+          bvh.nodes(), expected.nodes(),
+          [](const BVH::Node& a, const BVH::Node& b) {
+            return a.bounds == b.bounds && a.offset == b.offset &&
+                   a.primitive_count == b.primitive_count;
+          }));
+      REQUIRE(std::ranges::equal(bvh.primitive_indices(),
+                                 expected.primitive_indices()));
+    }
+  }
+}
+
+TEST_CASE("BVH ray traversal", "[beyond.core.geometry.bvh]")
+{
+  const std::vector<AABB3> boxes = random_boxes(2000, 7);
+  const BVH bvh{boxes};
+
+  SECTION("Finds the same nearest hit as brute force")
+  {
+    beyond::xorshift32 rng{123};
+    std::uniform_real_distribution<float> dist{-1.f, 1.f};
+    for (int i = 0; i < 500; ++i) {
+      const Ray ray{Point3{150 * dist(rng), 150 * dist(rng), 150 * dist(rng)},
+                    Vec3{dist(rng), dist(rng), dist(rng)}};
+      const auto expected = brute_force_hit(ray, boxes);
+      const auto hit = bvh.intersect(ray, boxes, 0, inf);
+      REQUIRE(hit.has_value() == expected.has_value());
+      if (hit) { REQUIRE(hit->t == expected->t); }
+    }
+  }
+
+  SECTION("Axis aligned rays")
+  {
+    const Ray ray{Point3{-200, 0, 0}, Vec3{1, 0, 0}};
+    const auto expected = brute_force_hit(ray, boxes);
+    const auto hit = bvh.intersect(ray, boxes, 0, inf);
+    REQUIRE(hit.has_value() == expected.has_value());
+    if (hit) { REQUIRE(hit->primitive == expected->primitive); }
+  }
+
+  SECTION("Respects the ray interval")
+  {
+    const std::vector<AABB3> row{
+        AABB3{Point3{1, -1, -1}, Point3{2, 1, 1}},
+        AABB3{Point3{5, -1, -1}, Point3{6, 1, 1}},
+    };
+    const BVH row_bvh{row, 1};
+    const Ray ray{Point3{0, 0, 0}, Vec3{1, 0, 0}};
+
+    REQUIRE(row_bvh.intersect(ray, row, 0, inf)->primitive == 0);
+    REQUIRE(row_bvh.intersect(ray, row, 3, inf)->primitive == 1);
+    REQUIRE(!row_bvh.intersect(ray, row, 0, 0.5f));
+    REQUIRE(!row_bvh.intersect(Ray{Point3{0, 5, 0}, Vec3{1, 0, 0}}, row, 0,
+                               inf));
+  }
+
+  SECTION("Custom primitive intersection")
+  {
+    // Only accepts primitives with an even index. The ray passes through the
+    // center of the first box
+    const Point3 center =
+        boxes[0].min() + (boxes[0].max() - boxes[0].min()) / 2;
+    const Ray ray{Point3{-200, center.y, center.z}, Vec3{1, 0, 0}};
+    const Vec3 inv_direction{1, inf, inf};
+    const auto even_only = [&](std::uint32_t primitive, float t_min,
+                               float t_max) -> beyond::optional<float> {
+      if (primitive % 2 != 0) { return beyond::nullopt; }
+      const float t = beyond::detail::ray_box_entry(
+          boxes[primitive], ray.origin, inv_direction, t_min, t_max);
+      if (t == inf) { return beyond::nullopt; }
+      return t;
+    };
+
+    std::vector<AABB3> even_boxes;
+    for (std::size_t i = 0; i < boxes.size(); i += 2) {
+      even_boxes.push_back(boxes[i]);
+    }
+    const auto expected = brute_force_hit(ray, even_boxes);
+    const auto hit = bvh.intersect(ray, 0, inf, even_only);
+    REQUIRE(expected.has_value());
+    REQUIRE(hit.has_value());
+    REQUIRE(hit->primitive == expected->primitive * 2);
+    REQUIRE(hit->t == expected->t);
+  }
+}
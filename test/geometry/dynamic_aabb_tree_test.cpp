@@ -0,0 +1,238 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "beyond/geometry/dynamic_aabb_tree.hpp"
+#include "beyond/random/generators/xorshift32.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+using beyond::AABB3;
+using beyond::AABBProxy;
+using beyond::DynamicAABBTree;
+using beyond::Point3;
+using beyond::Ray;
+using beyond::Vec3;
+
+namespace {
+
+constexpr float inf = std::numeric_limits<float>::infinity();
+
+auto box_at(Point3 min, float size) -> AABB3
+{
+  return AABB3{min, min + Vec3{size, size, size}, AABB3::unchecked_tag};
+}
+
+auto query_all(const DynamicAABBTree& tree, const AABB3& box)
+    -> std::set<std::uint64_t>
+{
+  std::set<std::uint64_t> result;
+  tree.query(box, [&](AABBProxy proxy) {
+    result.insert(tree.user_data(proxy));
+  });
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("DynamicAABBTree insertion and removal",
+          "[beyond.core.geometry.dynamic_aabb_tree]")
+{
+  DynamicAABBTree tree{0.5f};
+  REQUIRE(tree.empty());
+  REQUIRE(tree.is_valid());
+
+  const AABBProxy a = tree.insert(box_at({0, 0, 0}, 1), 1);
+  REQUIRE(tree.size() == 1);
+  REQUIRE(tree.contains(a));
+  REQUIRE(tree.user_data(a) == 1);
+  REQUIRE(tree.fat_bounds(a) == AABB3{{-0.5f, -0.5f, -0.5f},
+                                      {1.5f, 1.5f, 1.5f},
+                                      AABB3::unchecked_tag});
+
+  const AABBProxy b = tree.insert(box_at({10, 0, 0}, 1), 2);
+  const AABBProxy c = tree.insert(box_at({0, 10, 0}, 1), 3);
+  REQUIRE(tree.size() == 3);
+  REQUIRE(tree.is_valid());
+
+  tree.remove(b);
+  REQUIRE(tree.size() == 2);
+  REQUIRE(!tree.contains(b));
+  REQUIRE(tree.contains(a));
+  REQUIRE(tree.contains(c));
+  REQUIRE(tree.is_valid());
+
+  SECTION("A stale proxy does not refer to a new object in the same slot")
+  {
+    const AABBProxy d = tree.insert(box_at({5, 5, 5}, 1), 4);
+    REQUIRE(tree.contains(d));
+    REQUIRE(!tree.contains(b));
+    REQUIRE(tree.is_valid());
+  }
+
+  SECTION("Removing every object")
+  {
+    tree.remove(a);
+    tree.remove(c);
+    REQUIRE(tree.empty());
+    REQUIRE(tree.is_valid());
+    REQUIRE(query_all(tree, box_at({-100, -100, -100}, 200)).empty());
+  }
+}
+
+TEST_CASE("DynamicAABBTree stays balanced",
+          "[beyond.core.geometry.dynamic_aabb_tree]")
+{
+  // Objects sorted along a line are the worst case without rotations
+  DynamicAABBTree tree;
+  std::vector<AABBProxy> proxies;
+  constexpr std::size_t count = 1024;
+  for (std::size_t i = 0; i < count; ++i) {
+    const float x = 2 * static_cast<float>(i);
+    proxies.push_back(tree.insert(box_at({x, 0, 0}, 1)));
+  }
+  REQUIRE(tree.is_valid());
+  // An AVL tree is at most 1.44 times as tall as a perfectly balanced one
+  REQUIRE(tree.height() <= 15);
+
+  for (std::size_t i = 0; i < count; i += 2) { tree.remove(proxies[i]); }
+  REQUIRE(tree.size() == count / 2);
+  REQUIRE(tree.is_valid());
+  REQUIRE(tree.height() <= 14);
+}
+
+TEST_CASE("DynamicAABBTree moving objects",
+          "[beyond.core.geometry.dynamic_aabb_tree]")
+{
+  DynamicAABBTree tree{0.5f};
+  const AABBProxy a = tree.insert(box_at({0, 0, 0}, 1), 1);
+  const AABBProxy b = tree.insert(box_at({10, 0, 0}, 1), 2);
+
+  SECTION("Small moves stay inside the fat AABB")
+  {
+    const AABB3 fat = tree.fat_bounds(a);
+    REQUIRE(!tree.move(a, box_at({0.2f, 0.2f, 0.2f}, 1)));
+    REQUIRE(tree.fat_bounds(a) == fat);
+  }
+
+  SECTION("Large moves update the tree")
+  {
+    REQUIRE(tree.move(a, box_at({9.5f, 0, 0}, 1)));
+    REQUIRE(tree.is_valid());
+    REQUIRE(query_all(tree, box_at({9.8f, 0, 0}, 0.1f)) ==
+            std::set<std::uint64_t>{1, 2});
+    REQUIRE(query_all(tree, box_at({0, 0, 0}, 0.1f)).empty());
+  }
+
+  SECTION("The fat AABB extends in the direction of the displacement")
+  {
+    REQUIRE(tree.move(a, box_at({3, 0, 0}, 1), Vec3{1, 0, 0}));
+    const AABB3& fat = tree.fat_bounds(a);
+    REQUIRE(fat.max().x > 4.5f);
+    REQUIRE(fat.min().x == -0.5f + 3);
+    REQUIRE(tree.contains(b));
+  }
+}
+
+TEST_CASE("DynamicAABBTree queries match brute force",
+          "[beyond.core.geometry.dynamic_aabb_tree]")
+{
+  beyond::xorshift32 rng{5};
+  std::uniform_real_distribution<float> position{-50.f, 50.f};
+  std::uniform_real_distribution<float> size{0.5f, 4.f};
+  std::uniform_real_distribution<float> step{-1.f, 1.f};
+
+  DynamicAABBTree tree{0.2f};
+  std::vector<AABBProxy> proxies;
+  std::vector<AABB3> boxes;
+  for (std::uint64_t i = 0; i < 500; ++i) {
+    boxes.push_back(box_at({position(rng), position(rng), position(rng)},
+                           size(rng)));
+    proxies.push_back(tree.insert(boxes.back(), i));
+  }
+
+  // Moves everything a few times like a simulation would
+  for (int frame = 0; frame < 5; ++frame) {
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+      const Vec3 d{step(rng), step(rng), step(rng)};
+      boxes[i] = AABB3{boxes[i].min() + d, boxes[i].max() + d,
+                       AABB3::unchecked_tag};
+      [[maybe_unused]] const bool moved = tree.move(proxies[i], boxes[i], d);
+    }
+  }
+  REQUIRE(tree.is_valid());
+
+  SECTION("Fat AABBs enclose the objects")
+  {
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+      REQUIRE(contains(tree.fat_bounds(proxies[i]), boxes[i]));
+    }
+  }
+
+  SECTION("Overlap query")
+  {
+    const AABB3 query_box = box_at({-10, -10, -10}, 20);
+    std::set<std::uint64_t> expected;
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+      if (overlaps(tree.fat_bounds(proxies[i]), query_box)) {
+        expected.insert(i);
+      }
+    }
+    REQUIRE(query_all(tree, query_box) == expected);
+  }
+
+  SECTION("Overlapping pairs")
+  {
+    std::set<std::pair<std::uint64_t, std::uint64_t>> expected;
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+      for (std::size_t j = i + 1; j < boxes.size(); ++j) {
+        if (overlaps(tree.fat_bounds(proxies[i]),
+                     tree.fat_bounds(proxies[j]))) {
+          expected.emplace(i, j);
+        }
+      }
+    }
+
+    std::set<std::pair<std::uint64_t, std::uint64_t>> pairs;
+    std::size_t pair_count = 0;
+    tree.query_pairs([&](AABBProxy lhs, AABBProxy rhs) {
+      const std::uint64_t i = tree.user_data(lhs);
+      const std::uint64_t j = tree.user_data(rhs);
+      pairs.emplace(std::min(i, j), std::max(i, j));
+      ++pair_count;
+    });
+    REQUIRE(pair_count == pairs.size());
+    REQUIRE(pairs == expected);
+  }
+
+  SECTION("Ray query finds the nearest object")
+  {
+    const Ray ray{Point3{-60, 0.5f, 0.3f}, Vec3{1, 0.01f, -0.02f}};
+    const Vec3 inv_direction{1 / ray.direction.x, 1 / ray.direction.y,
+                             1 / ray.direction.z};
+
+    const auto intersect_box = [&](std::size_t i, float t_min, float t_max) {
+      return beyond::detail::ray_box_entry(boxes[i], ray.origin, inv_direction,
+                                           t_min, t_max);
+    };
+    float nearest = inf;
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+      nearest = std::min(nearest, intersect_box(i, 0, inf));
+    }
+
+    const auto hit = tree.intersect(
+        ray, 0, inf,
+        [&](AABBProxy proxy, float t_min,
+            float t_max) -> beyond::optional<float> {
+          const float t = intersect_box(tree.user_data(proxy), t_min, t_max);
+          if (t == inf) { return beyond::nullopt; }
+          return t;
+        });
+    REQUIRE(hit.has_value() == (nearest != inf));
+    if (hit) { REQUIRE(hit->t == nearest); }
+  }
+}
@@ -0,0 +1,189 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "beyond/geometry/frustum.hpp"
+#include "beyond/math/transform.hpp"
+#include "beyond/random/generators/xorshift32.hpp"
+
+#include "random_boxes.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+using beyond::AABB3;
+using beyond::Containment;
+using beyond::Frustum;
+using beyond::Point3;
+using beyond::Sphere;
+using beyond::Vec3;
+
+namespace {
+
+using namespace beyond::literals;
+
+// A camera at the origin looking down -z, with a 90 degrees field of view,
+// so the frustum is bounded by |x| <= -z and |y| <= -z
+auto make_frustum() -> Frustum
+{
+  const beyond::Mat4 projection =
+      beyond::perspective(beyond::Radian{90._deg}, 1.f, 1.f, 100.f);
+  const beyond::Mat4 view =
+      beyond::look_at(Vec3{0, 0, 0}, Vec3{0, 0, -1}, Vec3{0, 1, 0});
+  return Frustum{projection * view};
+}
+
+auto box_around(Point3 center, float half_size) -> AABB3
+{
+  const Vec3 h{half_size, half_size, half_size};
+  return AABB3{center - h, center + h, AABB3::unchecked_tag};
+}
+
+} // anonymous namespace
+
+TEST_CASE("Frustum from a view-projection matrix",
+          "[beyond.core.geometry.frustum]")
+{
+  const Frustum frustum = make_frustum();
+
+  SECTION("Points")
+  {
+    REQUIRE(frustum.contains(Point3{0, 0, -50}));
+    REQUIRE(frustum.contains(Point3{40, -40, -50}));
+    REQUIRE(!frustum.contains(Point3{60, 0, -50}));
+    REQUIRE(!frustum.contains(Point3{0, -60, -50}));
+    // In front of the near plane and behind the far plane
+    REQUIRE(!frustum.contains(Point3{0, 0, -0.5f}));
+    REQUIRE(!frustum.contains(Point3{0, 0, -101}));
+    // Behind the camera
+    REQUIRE(!frustum.contains(Point3{0, 0, 50}));
+  }
+
+  SECTION("Planes are normalized")
+  {
+    for (const Frustum::Plane& plane : frustum.planes()) {
+      REQUIRE(std::abs(plane.normal.length() - 1) < 1e-5f);
+    }
+    // The near plane is z = -1
+    REQUIRE(std::abs(frustum.planes()[4].signed_distance(Point3{0, 0, -3}) -
+                     2) < 1e-4f);
+  }
+
+  SECTION("Boxes")
+  {
+    REQUIRE(frustum.classify(box_around({0, 0, -50}, 1)) ==
+            Containment::inside);
+    REQUIRE(frustum.classify(box_around({50, 0, -50}, 1)) ==
+            Containment::intersecting);
+    REQUIRE(frustum.classify(box_around({0, 0, -100}, 1)) ==
+            Containment::intersecting);
+    REQUIRE(frustum.classify(box_around({60, 0, -50}, 1)) ==
+            Containment::outside);
+    REQUIRE(frustum.classify(box_around({0, 0, 10}, 1)) ==
+            Containment::outside);
+    // A box containing the whole frustum
+    REQUIRE(frustum.classify(box_around({0, 0, 0}, 500)) ==
+            Containment::intersecting);
+  }
+
+  SECTION("Spheres")
+  {
+    REQUIRE(frustum.intersects(Sphere{{0, 0, -50}, 1}));
+    REQUIRE(frustum.intersects(Sphere{{52, 0, -50}, 2}));
+    REQUIRE(!frustum.intersects(Sphere{{60, 0, -50}, 2}));
+    REQUIRE(!frustum.intersects(Sphere{{0, 0, 5}, 2}));
+  }
+}
+
+TEST_CASE("Frustum with an OpenGL depth range",
+          "[beyond.core.geometry.frustum]")
+{
+  const Frustum frustum{beyond::ortho(-1.f, 1.f, -1.f, 1.f, 1.f, 10.f),
+                        beyond::ClipDepth::negative_one_to_one};
+  REQUIRE(frustum.contains(Point3{0, 0, -5}));
+  REQUIRE(frustum.contains(Point3{0.9f, -0.9f, -1.5f}));
+  REQUIRE(!frustum.contains(Point3{0, 0, -0.5f}));
+  REQUIRE(!frustum.contains(Point3{0, 0, -11}));
+  REQUIRE(!frustum.contains(Point3{1.5f, 0, -5}));
+}
+
+TEST_CASE("Frustum batch tests", "[beyond.core.geometry.frustum]")
+{
+  const Frustum frustum = make_frustum();
+
+  SECTION("Boxes agree with the scalar test")
+  {
+    // Not a multiple of the SIMD width
+    const std::vector<AABB3> boxes = random_boxes(1003, 1, 150.f);
+    std::vector<char> expected;
+    for (const AABB3& box : boxes) {
+      expected.push_back(frustum.intersects(box));
+    }
+
+    auto visible = std::make_unique<bool[]>(boxes.size());
+    const std::size_t count =
+        frustum.intersects(boxes, std::span{visible.get(), boxes.size()});
+    REQUIRE(std::ranges::equal(std::span{visible.get(), boxes.size()},
+                               expected,
+                               [](bool a, char b) { return a == (b != 0); }));
+    REQUIRE(count == static_cast<std::size_t>(std::ranges::count(
+                         expected, char{1})));
+    REQUIRE(count > 0);
+    REQUIRE(count < boxes.size());
+  }
+
+  SECTION("Spheres agree with the scalar test")
+  {
+    beyond::xorshift32 rng{2};
+    std::uniform_real_distribution<float> position{-150.f, 150.f};
+    std::uniform_real_distribution<float> radius{0.1f, 10.f};
+    std::vector<Sphere> spheres;
+    for (std::size_t i = 0; i < 1001; ++i) {
+      spheres.push_back(
+          Sphere{{position(rng), position(rng), position(rng)}, radius(rng)});
+    }
+
+    auto visible = std::make_unique<bool[]>(spheres.size());
+    const std::size_t count =
+        frustum.intersects(spheres, std::span{visible.get(), spheres.size()});
+    std::size_t expected_count = 0;
+    bool all_equal = true;
+    for (std::size_t i = 0; i < spheres.size(); ++i) {
+      const bool expected = frustum.intersects(spheres[i]);
+      all_equal = all_equal && visible[i] == expected;
+      expected_count += expected ? 1 : 0;
+    }
+    REQUIRE(all_equal);
+    REQUIRE(count == expected_count);
+    REQUIRE(count > 0);
+  }
+
+  SECTION("Empty spans")
+  {
+    REQUIRE(frustum.intersects(std::span<const AABB3>{}, {}) == 0);
+    REQUIRE(frustum.intersects(std::span<const Sphere>{}, {}) == 0);
+  }
+}
+
+TEST_CASE("Frustum culling over a BVH", "[beyond.core.geometry.frustum]")
+{
+  const Frustum frustum = make_frustum();
+  const std::vector<AABB3> boxes = random_boxes(5000, 3, 150.f);
+  const beyond::BVH bvh{boxes};
+
+  std::set<std::uint32_t> expected;
+  for (std::uint32_t i = 0; i < boxes.size(); ++i) {
+    if (frustum.intersects(boxes[i])) { expected.insert(i); }
+  }
+
+  std::vector<std::uint32_t> culled;
+  frustum.cull(bvh, boxes,
+               [&](std::uint32_t primitive) { culled.push_back(primitive); });
+  REQUIRE(culled.size() == expected.size());
+  REQUIRE(std::set<std::uint32_t>(culled.begin(), culled.end()) == expected);
+
+  std::size_t count = 0;
+  frustum.cull(beyond::BVH{}, {}, [&](std::uint32_t) { ++count; });
+  REQUIRE(count == 0);
+}
@@ -0,0 +1,61 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "beyond/geometry/morton.hpp"
+#include "beyond/random/generators/xorshift32.hpp"
+
+#include <random>
+
+using beyond::AABB3;
+using beyond::morton_decode;
+using beyond::morton_encode;
+using beyond::Point3;
+
+// The lookup tables are used in constant evaluation
+static_assert(morton_encode(1, 0, 0) == 0b001);
+static_assert(morton_encode(0, 1, 0) == 0b010);
+static_assert(morton_encode(0, 0, 1) == 0b100);
+static_assert(morton_encode(0b11, 0b01, 0b10) == 0b101'011);
+static_assert(morton_encode(1023, 1023, 1023) == (1u << 30) - 1);
+static_assert(morton_decode(0b101'011) ==
+              std::array<std::uint32_t, 3>{0b11, 0b01, 0b10});
+
+TEST_CASE("Morton codes", "[beyond.core.geometry.morton]")
+{
+  SECTION("Agrees with the constant evaluation")
+  {
+    REQUIRE(morton_encode(1, 0, 0) == 0b001);
+    REQUIRE(morton_encode(0b11, 0b01, 0b10) == 0b101'011);
+    REQUIRE(morton_encode(1023, 0, 0) == 0x0924'9249);
+    REQUIRE(morton_encode(0, 1023, 0) == 0x1249'2492);
+    REQUIRE(morton_encode(0, 0, 1023) == 0x2492'4924);
+  }
+
+  SECTION("Decoding gives back the coordinates")
+  {
+    beyond::xorshift32 rng{5};
+    std::uniform_int_distribution<std::uint32_t> coordinate{
+        0, beyond::morton_max_coordinate};
+    bool all_equal = true;
+    for (int i = 0; i < 10'000; ++i) {
+      const std::array<std::uint32_t, 3> xyz{coordinate(rng), coordinate(rng),
+                                             coordinate(rng)};
+      all_equal = all_equal &&
+                  morton_decode(morton_encode(xyz[0], xyz[1], xyz[2])) == xyz;
+    }
+    REQUIRE(all_equal);
+  }
+
+  SECTION("Codes of points in a box")
+  {
+    const AABB3 bounds{Point3{-1, 0, 2}, Point3{1, 4, 2}};
+    REQUIRE(morton_encode(Point3{-1, 0, 2}, bounds) == 0);
+    // The flat z axis maps to 0
+    REQUIRE(morton_encode(Point3{1, 4, 2}, bounds) == morton_encode(1023, 1023,
+                                                                     0));
+    REQUIRE(morton_decode(morton_encode(Point3{0, 1, 2}, bounds)) ==
+            std::array<std::uint32_t, 3>{512, 256, 0});
+    // Points outside of the box are clamped
+    REQUIRE(morton_encode(Point3{-5, 10, 0}, bounds) ==
+            morton_encode(0, 1023, 0));
+  }
+}
@@ -0,0 +1,29 @@
+#ifndef BEYOND_CORE_TEST_RANDOM_BOXES_HPP
+#define BEYOND_CORE_TEST_RANDOM_BOXES_HPP
+
+#include <beyond/geometry/aabb3.hpp>
+#include <beyond/random/generators/xorshift32.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Boxes whose min corners are uniformly distributed in [-extent, extent) and
+// whose sides are between `min_size` and `max_size` long
+inline auto random_boxes(std::size_t count, std::uint32_t seed,
+                         float extent = 100.f, float min_size = 0.1f,
+                         float max_size = 5.f) -> std::vector<beyond::AABB3>
+{
+  beyond::xorshift32 rng{seed};
+  std::uniform_real_distribution<float> position{-extent, extent};
+  std::uniform_real_distribution<float> size{min_size, max_size};
+  std::vector<beyond::AABB3> boxes;
+  for (std::size_t i = 0; i < count; ++i) {
+    const beyond::Point3 min{position(rng), position(rng), position(rng)};
+    boxes.emplace_back(min,
+                       min + beyond::Vec3{size(rng), size(rng), size(rng)});
+  }
+  return boxes;
+}
+
+#endif // BEYOND_CORE_TEST_RANDOM_BOXES_HPP
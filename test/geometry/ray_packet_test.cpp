@@ -0,0 +1,146 @@
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "beyond/geometry/bvh.hpp"
+#include "beyond/geometry/ray_packet.hpp"
+#include "beyond/random/generators/xorshift32.hpp"
+
+#include "random_boxes.hpp"
+
+#include <limits>
+#include <random>
+#include <vector>
+
+using beyond::AABB3;
+using beyond::Point3;
+using beyond::PrecomputedRay;
+using beyond::Ray;
+using beyond::Vec3;
+
+namespace {
+
+constexpr float inf = std::numeric_limits<float>::infinity();
+
+auto random_rays(std::size_t count, std::uint32_t seed) -> std::vector<Ray>
+{
+  beyond::xorshift32 rng{seed};
+  std::uniform_real_distribution<float> dist{-1.f, 1.f};
+  std::vector<Ray> rays;
+  for (std::size_t i = 0; i < count; ++i) {
+    rays.emplace_back(Point3{10 * dist(rng), 10 * dist(rng), 10 * dist(rng)},
+                      Vec3{dist(rng), dist(rng), dist(rng)});
+  }
+  return rays;
+}
+
+// The scalar test that the wide tests should agree with
+auto scalar_entry(const Ray& ray, const AABB3& box, float t_min, float t_max)
+    -> float
+{
+  const PrecomputedRay r{ray};
+  return beyond::detail::ray_box_entry(box, r.origin, r.inv_direction, t_min,
+                                       t_max);
+}
+
+} // anonymous namespace
+
+TEMPLATE_TEST_CASE("Ray packet vs AABB3", "[beyond.core.geometry.ray_packet]",
+                   beyond::Float4, beyond::Float8)
+{
+  constexpr std::size_t N = TestType::size();
+
+  SECTION("Agrees with the scalar test")
+  {
+    const std::vector<Ray> rays = random_rays(N * 64, 1);
+    const std::vector<AABB3> boxes = random_boxes(16, 2, 5.f, 0.5f);
+    std::size_t hit_count = 0;
+    for (std::size_t first = 0; first < rays.size(); first += N) {
+      const beyond::RayPacket<N> packet{std::span{rays}.subspan(first, N)};
+      for (const AABB3& box : boxes) {
+        const auto hit = intersect(packet, box, 0.f, 20.f);
+        for (std::size_t i = 0; i < N; ++i) {
+          const float expected = scalar_entry(rays[first + i], box, 0, 20);
+          const bool is_hit = (hit.mask.bits() >> i & 1u) != 0;
+          REQUIRE(is_hit == (expected != inf));
+          REQUIRE(hit.t[i] == expected);
+          hit_count += is_hit ? 1 : 0;
+        }
+      }
+    }
+    // Makes sure both outcomes are covered
+    REQUIRE(hit_count > 0);
+    REQUIRE(hit_count < rays.size() * boxes.size());
+  }
+
+  SECTION("Per-lane ray intervals")
+  {
+    const AABB3 box{Point3{1, -1, -1}, Point3{2, 1, 1}};
+    const std::vector<Ray> rays(N, Ray{Point3{0, 0, 0}, Vec3{1, 0, 0}});
+    const beyond::RayPacket<N> packet{rays};
+
+    std::array<float, N> t_max;
+    for (std::size_t i = 0; i < N; ++i) {
+      t_max[i] = i % 2 == 0 ? 0.5f : inf;
+    }
+    const auto hit = intersect(packet, box, 0.f, TestType::load(t_max.data()));
+    for (std::size_t i = 0; i < N; ++i) {
+      REQUIRE(hit.t[i] == (i % 2 == 0 ? inf : 1.f));
+    }
+  }
+
+  SECTION("Rays parallel to a slab")
+  {
+    const AABB3 box{Point3{-1, -1, -1}, Point3{1, 1, 1}};
+    const std::vector<Ray> rays{Ray{Point3{-5, 0, 0}, Vec3{1, 0, 0}},
+                                Ray{Point3{-5, 2, 0}, Vec3{1, 0, 0}}};
+    const beyond::RayPacket<N> packet{rays};
+    const auto hit = intersect(packet, box, 0.f, inf);
+    REQUIRE(hit.mask.bits() == 0b01u);
+    REQUIRE(hit.t[0] == 4.f);
+  }
+
+  SECTION("Partial packets have inactive lanes")
+  {
+    const AABB3 box{Point3{-1, -1, -1}, Point3{1, 1, 1}};
+    const std::vector<Ray> rays(N - 1, Ray{Point3{-5, 0, 0}, Vec3{1, 0, 0}});
+    const beyond::RayPacket<N> packet{rays};
+    REQUIRE(packet.active.bits() == (1u << (N - 1)) - 1);
+    REQUIRE(intersect(packet, box, 0.f, inf).mask.bits() ==
+            (1u << (N - 1)) - 1);
+  }
+}
+
+TEMPLATE_TEST_CASE("Ray vs wide AABB3", "[beyond.core.geometry.ray_packet]",
+                   beyond::Float4, beyond::Float8)
+{
+  constexpr std::size_t N = TestType::size();
+
+  SECTION("Agrees with the scalar test")
+  {
+    const std::vector<Ray> rays = random_rays(256, 3);
+    const std::vector<AABB3> boxes = random_boxes(N * 4, 4, 5.f, 0.5f);
+    for (std::size_t first = 0; first < boxes.size(); first += N) {
+      const beyond::WideAABB3<N> wide{std::span{boxes}.subspan(first, N)};
+      for (const Ray& ray : rays) {
+        const auto hit = intersect(PrecomputedRay{ray}, wide, 0, inf);
+        for (std::size_t i = 0; i < N; ++i) {
+          const float expected = scalar_entry(ray, boxes[first + i], 0, inf);
+          REQUIRE(((hit.mask.bits() >> i & 1u) != 0) == (expected != inf));
+          REQUIRE(hit.t[i] == expected);
+        }
+      }
+    }
+  }
+
+  SECTION("Unused lanes never hit")
+  {
+    const AABB3 box{Point3{-1, -1, -1}, Point3{1, 1, 1}};
+    const beyond::WideAABB3<N> wide{std::span{&box, 1}};
+    for (const Vec3 direction : {Vec3{1, 0, 0}, Vec3{-1, 0, 0},
+                                 Vec3{0.3f, -0.7f, 0.2f}}) {
+      const Ray ray{Point3{0, 0, 0} - direction * 5.f, direction};
+      const auto hit = intersect(PrecomputedRay{ray}, wide, 0, inf);
+      REQUIRE(hit.mask.bits() == 1u);
+    }
+  }
+}
@@ -0,0 +1,172 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "beyond/concurrency/thread_pool.hpp"
+#include "beyond/geometry/spatial_hash_grid.hpp"
+#include "beyond/random/generators/xorshift32.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using beyond::Point3;
+using beyond::SpatialHashGrid;
+
+namespace {
+
+auto random_points(std::size_t count, float extent, std::uint32_t seed)
+    -> std::vector<Point3>
+{
+  beyond::xorshift32 rng{seed};
+  std::uniform_real_distribution<float> position{-extent, extent};
+  std::vector<Point3> points;
+  for (std::size_t i = 0; i < count; ++i) {
+    points.emplace_back(position(rng), position(rng), position(rng));
+  }
+  return points;
+}
+
+auto query_sorted(const SpatialHashGrid& grid, Point3 center, float radius)
+    -> std::vector<std::uint32_t>
+{
+  std::vector<std::uint32_t> result;
+  grid.query_radius(center, radius,
+                    [&](std::uint32_t index) { result.push_back(index); });
+  std::ranges::sort(result);
+  return result;
+}
+
+auto brute_force(std::span<const Point3> points, Point3 center, float radius)
+    -> std::vector<std::uint32_t>
+{
+  std::vector<std::uint32_t> result;
+  for (std::uint32_t i = 0; i < points.size(); ++i) {
+    const float dx = points[i].x - center.x;
+    const float dy = points[i].y - center.y;
+    const float dz = points[i].z - center.z;
+    if (dx * dx + dy * dy + dz * dz <= radius * radius) {
+      result.push_back(i);
+    }
+  }
+  return result;
+}
+
+} // anonymous namespace
+
+TEST_CASE("SpatialHashGrid", "[beyond.core.geometry.spatial_hash_grid]")
+{
+  SpatialHashGrid grid{1.f};
+
+  SECTION("Empty grid")
+  {
+    REQUIRE(grid.empty());
+    REQUIRE(query_sorted(grid, Point3{0, 0, 0}, 10).empty());
+    grid.rebuild({});
+    REQUIRE(grid.empty());
+    REQUIRE(query_sorted(grid, Point3{0, 0, 0}, 10).empty());
+  }
+
+  SECTION("Points on cell boundaries and negative coordinates")
+  {
+    const std::vector<Point3> points{{0, 0, 0},    {1, 0, 0},  {-1, 0, 0},
+                                     {-0.5f, 0, 0}, {0, 2, 0}, {0, 0, -3}};
+    grid.rebuild(points);
+    REQUIRE(grid.size() == points.size());
+    REQUIRE(query_sorted(grid, Point3{0, 0, 0}, 1) ==
+            std::vector<std::uint32_t>{0, 1, 2, 3});
+    REQUIRE(query_sorted(grid, Point3{0, 0, 0}, 0.9f) ==
+            std::vector<std::uint32_t>{0, 3});
+    REQUIRE(query_sorted(grid, Point3{0, 0, -3}, 0.1f) ==
+            std::vector<std::uint32_t>{5});
+  }
+
+  SECTION("Queries match brute force")
+  {
+    // Dense enough for many points per cell, and a table small enough for
+    // hash collisions between cells
+    const std::vector<Point3> points = random_points(5000, 20, 1);
+    grid.rebuild(points);
+    REQUIRE(grid.size() == points.size());
+
+    const std::vector<Point3> centers = random_points(100, 22, 2);
+    for (const float radius : {0.5f, 1.f, 3.5f}) {
+      for (const Point3& center : centers) {
+        REQUIRE(query_sorted(grid, center, radius) ==
+                brute_force(points, center, radius));
+      }
+    }
+  }
+
+  SECTION("Radii much larger than the cells")
+  {
+    // Would visit about 6e13 cells
+    SpatialHashGrid fine_grid{0.5f};
+    const std::vector<Point3> points = random_points(1000, 20, 6);
+    fine_grid.rebuild(points);
+    REQUIRE(query_sorted(fine_grid, Point3{0, 0, 0}, 1e4f).size() ==
+            points.size());
+    REQUIRE(query_sorted(fine_grid, Point3{1, 2, 3}, 30) ==
+            brute_force(points, Point3{1, 2, 3}, 30));
+  }
+
+  SECTION("Coordinates beyond the range of the cell indices")
+  {
+    const std::vector<Point3> points{{0, 0, 0},
+                                     {1e20f, 0, 0},
+                                     {1e20f, 1, 0},
+                                     {-1e20f, 0, -1e20f},
+                                     {3e38f, -3e38f, 3e38f}};
+    grid.rebuild(points);
+    for (const Point3& center : points) {
+      for (const float radius : {0.f, 2.f, 1e10f}) {
+        REQUIRE(query_sorted(grid, center, radius) ==
+                brute_force(points, center, radius));
+      }
+    }
+  }
+
+  SECTION("Rebuilding with fewer points")
+  {
+    grid.rebuild(random_points(1000, 10, 3));
+    const std::vector<Point3> points = random_points(10, 10, 4);
+    grid.rebuild(points);
+    REQUIRE(grid.size() == 10);
+    REQUIRE(query_sorted(grid, Point3{0, 0, 0}, 100).size() == 10);
+  }
+}
+
+TEST_CASE("SpatialHashGrid parallel rebuild",
+          "[beyond.core.geometry.spatial_hash_grid]")
+{
+  SECTION("Matches the sequential rebuild")
+  {
+    // Large enough for several chunks
+    const std::vector<Point3> points = random_points(70'000, 50, 5);
+    SpatialHashGrid expected{2.f};
+    expected.rebuild(points);
+
+    for (const std::size_t thread_count : {1u, 3u, 4u}) {
+      beyond::ThreadPool pool{thread_count};
+      SpatialHashGrid grid{2.f};
+      grid.rebuild(points, pool);
+      REQUIRE(std::ranges::equal(grid.sorted_indices(),
+                                 expected.sorted_indices()));
+      REQUIRE(
+          std::ranges::equal(grid.sorted_points(), expected.sorted_points()));
+      for (const Point3& center : random_points(20, 50, 6)) {
+        REQUIRE(query_sorted(grid, center, 5) ==
+                brute_force(points, center, 5));
+      }
+    }
+  }
+
+  SECTION("Few points")
+  {
+    beyond::ThreadPool pool{2};
+    SpatialHashGrid grid{2.f};
+    grid.rebuild({}, pool);
+    REQUIRE(query_sorted(grid, Point3{0, 0, 0}, 10).empty());
+    const std::vector<Point3> points = random_points(10, 10, 7);
+    grid.rebuild(points, pool);
+    REQUIRE(query_sorted(grid, Point3{0, 0, 0}, 100).size() == 10);
+  }
+}
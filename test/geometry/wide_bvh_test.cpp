@@ -0,0 +1,155 @@
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "beyond/geometry/wide_bvh.hpp"
+#include "beyond/random/generators/xorshift32.hpp"
+
+#include "random_boxes.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+using beyond::AABB3;
+using beyond::BVH;
+using beyond::Point3;
+using beyond::Ray;
+using beyond::Vec3;
+
+namespace {
+
+constexpr float inf = std::numeric_limits<float>::infinity();
+
+// Gets the box in lane `lane`, whose min is above its max for unused lanes
+template <std::size_t N>
+auto lane_box(const beyond::WideAABB3<N>& bounds, std::size_t lane) -> AABB3
+{
+  return AABB3{Point3{bounds.min.x[lane], bounds.min.y[lane],
+                      bounds.min.z[lane]},
+               Point3{bounds.max.x[lane], bounds.max.y[lane],
+                      bounds.max.z[lane]},
+               AABB3::unchecked_tag};
+}
+
+auto is_unused(const AABB3& box) -> bool
+{
+  return box.min().x > box.max().x;
+}
+
+// Checks that the lanes of a wide node enclose the boxes below them, and
+// counts how many times each primitive is reached
+template <std::size_t N>
+auto check_subtree(const beyond::WideBVH<N>& bvh,
+                   std::span<const AABB3> boxes, std::uint32_t index,
+                   std::vector<int>& primitive_seen) -> void
+{
+  const auto& node = bvh.nodes()[index];
+  for (std::size_t lane = 0; lane < N; ++lane) {
+    const AABB3 bounds = lane_box(node.bounds, lane);
+    if (is_unused(bounds)) {
+      REQUIRE(node.primitive_count[lane] == 0);
+      continue;
+    }
+
+    if (node.primitive_count[lane] == 0) {
+      const auto& child = bvh.nodes()[node.offset[lane]];
+      for (std::size_t i = 0; i < N; ++i) {
+        const AABB3 child_bounds = lane_box(child.bounds, i);
+        if (!is_unused(child_bounds)) {
+          REQUIRE(contains(bounds, child_bounds));
+        }
+      }
+      check_subtree(bvh, boxes, node.offset[lane], primitive_seen);
+    } else {
+      for (std::uint32_t i = 0; i < node.primitive_count[lane]; ++i) {
+        const std::uint32_t primitive =
+            bvh.primitive_indices()[node.offset[lane] + i];
+        REQUIRE(contains(bounds, boxes[primitive]));
+        ++primitive_seen[primitive];
+      }
+    }
+  }
+}
+
+} // anonymous namespace
+
+TEMPLATE_TEST_CASE("Wide BVH collapse", "[beyond.core.geometry.wide_bvh]",
+                   beyond::BVH4, beyond::BVH8)
+{
+  SECTION("Empty BVH")
+  {
+    const TestType bvh{BVH{}};
+    REQUIRE(bvh.empty());
+    REQUIRE(!bvh.intersect(Ray{}, std::span<const AABB3>{}, 0, inf));
+  }
+
+  SECTION("A single leaf")
+  {
+    const AABB3 box{Point3{0, 0, 0}, Point3{1, 1, 1}};
+    const TestType bvh{BVH{std::span{&box, 1}}};
+    REQUIRE(bvh.nodes().size() == 1);
+    REQUIRE(bvh.nodes()[0].primitive_count[0] == 1);
+
+    const auto hit = bvh.intersect(Ray{Point3{-1, 0.5f, 0.5f}, Vec3{1, 0, 0}},
+                                   std::span{&box, 1}, 0, inf);
+    REQUIRE(hit.has_value());
+    REQUIRE(hit->t == 1);
+  }
+
+  SECTION("Every primitive is in exactly one leaf")
+  {
+    const std::vector<AABB3> boxes = random_boxes(1000, 11);
+    for (const std::size_t max_leaf_size : {1u, 4u}) {
+      const BVH binary{boxes, max_leaf_size};
+      const TestType bvh{binary};
+      // Collapsing removes most of the interior nodes
+      REQUIRE(bvh.nodes().size() < binary.nodes().size() / 2);
+
+      std::vector<int> primitive_seen(boxes.size());
+      check_subtree(bvh, boxes, 0, primitive_seen);
+      REQUIRE(std::ranges::all_of(primitive_seen,
+                                  [](int seen) { return seen == 1; }));
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("Wide BVH ray traversal", "[beyond.core.geometry.wide_bvh]",
+                   beyond::BVH4, beyond::BVH8)
+{
+  const std::vector<AABB3> boxes = random_boxes(2000, 7);
+  const BVH binary{boxes};
+  const TestType bvh{binary};
+
+  SECTION("Finds the same nearest hit as the binary BVH")
+  {
+    beyond::xorshift32 rng{123};
+    std::uniform_real_distribution<float> dist{-1.f, 1.f};
+    for (int i = 0; i < 500; ++i) {
+      const Ray ray{Point3{150 * dist(rng), 150 * dist(rng), 150 * dist(rng)},
+                    Vec3{dist(rng), dist(rng), dist(rng)}};
+      const auto expected = binary.intersect(ray, boxes, 0, inf);
+      const auto hit = bvh.intersect(ray, boxes, 0, inf);
+      REQUIRE(hit.has_value() == expected.has_value());
+      if (hit) { REQUIRE(hit->t == expected->t); }
+    }
+  }
+
+  SECTION("Respects the ray interval")
+  {
+    const std::vector<AABB3> row{
+        AABB3{Point3{1, -1, -1}, Point3{2, 1, 1}},
+        AABB3{Point3{5, -1, -1}, Point3{6, 1, 1}},
+        AABB3{Point3{9, -1, -1}, Point3{10, 1, 1}},
+    };
+    const TestType row_bvh{BVH{row, 1}};
+    const Ray ray{Point3{0, 0, 0}, Vec3{1, 0, 0}};
+
+    REQUIRE(row_bvh.intersect(ray, row, 0, inf)->primitive == 0);
+    REQUIRE(row_bvh.intersect(ray, row, 3, inf)->primitive == 1);
+    REQUIRE(row_bvh.intersect(ray, row, 7, inf)->primitive == 2);
+    REQUIRE(!row_bvh.intersect(ray, row, 0, 0.5f));
+    REQUIRE(!row_bvh.intersect(Ray{Point3{0, 5, 0}, Vec3{1, 0, 0}}, row, 0,
+                               inf));
+  }
+}
@@ -0,0 +1,115 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <beyond/math/batch_transform.hpp>
+#include <beyond/math/transform.hpp>
+
+#include "matrix_test_util.hpp"
+
+#include <vector>
+
+namespace {
+
+auto make_points(std::size_t count) -> std::vector<beyond::Point3>
+{
+  std::vector<beyond::Point3> points;
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto f = static_cast<float>(i);
+    points.emplace_back(f, 2.f * f - 5.f, 0.5f - f);
+  }
+  return points;
+}
+
+auto make_transform() -> beyond::Mat4
+{
+  return beyond::translate(1.f, -2.f, 3.f) *
+         beyond::rotate_y(beyond::Radian{0.5f}) *
+         beyond::scale(2.f, 3.f, 0.5f);
+}
+
+// The result of the scalar `m * v` that the batch transforms should match
+auto expected(const beyond::Mat4& m, float x, float y, float z, float w)
+    -> beyond::Vec3
+{
+  const beyond::Vec4 r = m * beyond::Vec4{x, y, z, w};
+  return beyond::Vec3{r.x, r.y, r.z};
+}
+
+auto to_vec3(const beyond::Point3& p) -> beyond::Vec3
+{
+  return beyond::Vec3{p.x, p.y, p.z};
+}
+
+} // anonymous namespace
+
+TEST_CASE("Batch transform in AoS layout", "[beyond.core.math.batch_transform]")
+{
+  const beyond::Mat4 m = make_transform();
+
+  // Covers every remainder of the SIMD loops
+  for (std::size_t count = 0; count < 20; ++count) {
+    const auto points = make_points(count);
+
+    std::vector<beyond::Point3> out_points(count);
+    beyond::transform_points(m, points, out_points);
+
+    std::vector<beyond::Vec3> vectors;
+    for (const auto& p : points) { vectors.push_back(to_vec3(p)); }
+    std::vector<beyond::Vec3> out_vectors(count);
+    beyond::transform_vectors(m, vectors, out_vectors);
+
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto& p = points[i];
+      vector_approx_match(to_vec3(out_points[i]),
+                          expected(m, p.x, p.y, p.z, 1));
+      vector_approx_match(out_vectors[i], expected(m, p.x, p.y, p.z, 0));
+    }
+  }
+
+  SECTION("In place")
+  {
+    auto points = make_points(11);
+    const auto original = points;
+    beyond::transform_points(m, points, points);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      const auto& p = original[i];
+      vector_approx_match(to_vec3(points[i]), expected(m, p.x, p.y, p.z, 1));
+    }
+  }
+}
+
+TEST_CASE("Batch transform in SoA layout", "[beyond.core.math.batch_transform]")
+{
+  const beyond::Mat4 m = make_transform();
+
+  for (std::size_t count = 0; count < 20; ++count) {
+    const auto points = make_points(count);
+    std::vector<float> xs, ys, zs;
+    for (const auto& p : points) {
+      xs.push_back(p.x);
+      ys.push_back(p.y);
+      zs.push_back(p.z);
+    }
+    const beyond::SoASpan3<const float> in{xs, ys, zs};
+
+    std::vector<float> px(count), py(count), pz(count);
+    beyond::transform_points(m, in, beyond::SoASpan3<float>{px, py, pz});
+
+    std::vector<float> vx(count), vy(count), vz(count);
+    beyond::transform_vectors(m, in, beyond::SoASpan3<float>{vx, vy, vz});
+
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto& p = points[i];
+      vector_approx_match(beyond::Vec3{px[i], py[i], pz[i]},
+                          expected(m, p.x, p.y, p.z, 1));
+      vector_approx_match(beyond::Vec3{vx[i], vy[i], vz[i]},
+                          expected(m, p.x, p.y, p.z, 0));
+    }
+
+    // Transforms in place
+    const beyond::SoASpan3<float> inout{xs, ys, zs};
+    beyond::transform_points(m, inout, inout);
+    CHECK(xs == px);
+    CHECK(ys == py);
+    CHECK(zs == pz);
+  }
+}
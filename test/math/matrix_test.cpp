@@ -568,4 +568,86 @@ TEST_CASE("Matrix inverse", "[beyond.core.math.mat]")
     matrix_approx_match(inverse(A), Ainv, "4x4 matrix inverse");
     matrix_approx_match(A, inverse(Ainv), "4x4 matrix inverse");
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Runtime Mat4 operations match compile-time evaluation",
+          "[beyond.core.math.mat]")
+{
+  // Constant evaluation always takes the scalar code path, while the runtime
+  // uses the SIMD kernels when they are available
+  static constexpr beyond::Mat4 A(
+      // clang-format off
+      -5,  2,  6, -8,
+       1, -5,  1,  8,
+       7,  7, -6, -7,
+       1, -3,  7,  4
+      // clang-format on
+  );
+  static constexpr beyond::Mat4 B(
+      // clang-format off
+       2,  1,  0,  3,
+       0, -1,  4,  1,
+       5,  2, -3,  0,
+       1,  0,  2,  6
+      // clang-format on
+  );
+  const beyond::Vec4 v{1, -2, 3, 0.5f};
+
+  static constexpr beyond::Mat4 AB = A * B;
+  static constexpr beyond::Mat4 AT = transpose(A);
+  static constexpr beyond::Mat4 Ainv = inverse(A);
+
+  REQUIRE(A * B == AB);
+  REQUIRE(transpose(A) == AT);
+
+  beyond::Vec4 Av;
+  for (std::size_t i = 0; i < 4; ++i) {
+    for (std::size_t j = 0; j < 4; ++j) {
+      Av[i] += A(i, j) * v[j];
+    }
+  }
+  vector_approx_match(A * v, Av);
+  matrix_approx_match(inverse(A), Ainv, "4x4 matrix inverse");
+  matrix_approx_match(A * inverse(A), beyond::Mat4::identity());
+  matrix_approx_match(inverse(B) * B, beyond::Mat4::identity());
+}
+
+TEST_CASE("Inverse of affine and rigid matrices", "[beyond.core.math.mat]")
+{
+  // A rotation of 90 degrees around the z axis followed by a translation
+  static constexpr beyond::Mat4 rigid(
+      // clang-format off
+      0, -1, 0, 1,
+      1,  0, 0, 2,
+      0,  0, 1, 3,
+      0,  0, 0, 1
+      // clang-format on
+  );
+  static constexpr beyond::Mat4 affine(
+      // clang-format off
+      2, 1, 0,  4,
+      0, 3, 1, -1,
+      1, 0, 2,  5,
+      0, 0, 0,  1
+      // clang-format on
+  );
+
+  static constexpr beyond::Mat4 rigid_inv = inverse_rigid(rigid);
+  static constexpr beyond::Mat4 affine_inv = inverse_affine(affine);
+
+  SECTION("Rigid")
+  {
+    matrix_approx_match(rigid_inv, inverse(rigid), "compile-time");
+    matrix_approx_match(inverse_rigid(rigid), inverse(rigid), "runtime");
+    matrix_approx_match(inverse_affine(rigid), inverse(rigid));
+    matrix_approx_match(rigid * inverse_rigid(rigid), beyond::Mat4::identity());
+  }
+
+  SECTION("Affine")
+  {
+    matrix_approx_match(affine_inv, inverse(affine), "compile-time");
+    matrix_approx_match(inverse_affine(affine), inverse(affine), "runtime");
+    matrix_approx_match(inverse_affine(affine) * affine,
+                        beyond::Mat4::identity());
+  }
+}
@@ -1,9 +1,11 @@
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <beyond/math/quat.hpp>
 #include <beyond/math/serial.hpp>
+#include <beyond/math/transform.hpp>
 
 #include "../serial_test_util.hpp"
 #include "matrix_test_util.hpp"
@@ -11,16 +13,17 @@
 using beyond::DQuat;
 using beyond::Quat;
 using beyond::TQuat;
+using beyond::Radian;
 using beyond::Vec3;
 
 template <typename T>
 void quat_match(const beyond::TQuat<T>& result,
                 const beyond::TQuat<T>& expected)
 {
-  CHECK(result.w == Approx(expected.w));
-  CHECK(result.x == Approx(expected.x));
-  CHECK(result.y == Approx(expected.y));
-  CHECK(result.z == Approx(expected.z));
+  CHECK(result.w == Approx(expected.w).margin(1e-5));
+  CHECK(result.x == Approx(expected.x).margin(1e-5));
+  CHECK(result.y == Approx(expected.y).margin(1e-5));
+  CHECK(result.z == Approx(expected.z).margin(1e-5));
 }
 
 TEST_CASE("Quaternion default constructor", "[beyond.core.math.quaternion]")
@@ -89,7 +92,7 @@ TEST_CASE("Quaternion product", "[beyond.core.math.quaternion]")
   constexpr Quat cq1{1, {2, 3, 4}};
   constexpr Quat cq2{5, {6, 7, 8}};
 
-  constexpr Quat expected{-8, {30, 24, -60}};
+  constexpr Quat expected{-60, {12, 30, 24}};
 
   constexpr Quat c_result = cq1 * cq2;
   quat_match(c_result, expected);
@@ -98,6 +101,152 @@ TEST_CASE("Quaternion product", "[beyond.core.math.quaternion]")
   quat_match(result, expected);
 }
 
+TEST_CASE("Quaternion product composes rotations",
+          "[beyond.core.math.quaternion]")
+{
+  const Quat q1 =
+      Quat::from_axis_angle(Radian{0.3f}, normalize(Vec3{1, 2, 3}));
+  const Quat q2 = Quat::from_axis_angle(Radian{-1.2f}, Vec3{0, 1, 0});
+  const Vec3 v{1, -2, 0.5f};
+
+  vector_approx_match(rotate(q1 * q2, v), rotate(q1, rotate(q2, v)));
+  vector_approx_match(rotate(Quat::identity(), v), v);
+}
+
+TEST_CASE("Quaternion normalize, conjugate, and inverse",
+          "[beyond.core.math.quaternion]")
+{
+  constexpr Quat q{1, {2, 3, 4}};
+
+  STATIC_REQUIRE(conjugate(q) == Quat{1, {-2, -3, -4}});
+  STATIC_REQUIRE(dot(q, q) == 30);
+  STATIC_REQUIRE(q.length_squared() == 30);
+
+  REQUIRE(q.length() == Approx(std::sqrt(30.f)));
+  REQUIRE(normalize(q).length() == Approx(1));
+  quat_match(normalize(q), q / std::sqrt(30.f));
+  quat_match(q * inverse(q), Quat::identity());
+  quat_match(inverse(q) * q, Quat::identity());
+
+  const Quat unit = normalize(q);
+  quat_match(conjugate(unit), inverse(unit));
+}
+
+TEST_CASE("Quaternion rotations match rotation matrices",
+          "[beyond.core.math.quaternion]")
+{
+  const Vec3 axis = normalize(Vec3{-1, 2, 0.5f});
+  const Radian angle{2.5f};
+  const Quat q = Quat::from_axis_angle(angle, axis);
+  const beyond::Mat4 m = beyond::rotate(angle, axis);
+  const Vec3 v{3, -1, 2};
+
+  matrix_approx_match(to_mat4(q), m);
+  matrix_approx_match(to_mat3(q) * inverse(to_mat3(q)),
+                      beyond::Mat3::identity());
+
+  const auto mv = m * beyond::Vec4{v, 0};
+  vector_approx_match(rotate(q, v), Vec3{mv.x, mv.y, mv.z});
+  vector_approx_match(to_mat3(q) * v, rotate(q, v));
+}
+
+TEST_CASE("Quaternion from rotation matrices", "[beyond.core.math.quaternion]")
+{
+  // Exercises every branch of the conversion, since each one is taken
+  // depending on the largest diagonal element
+  const Vec3 axes[] = {Vec3{1, 0, 0}, Vec3{0, 1, 0}, Vec3{0, 0, 1},
+                       normalize(Vec3{1, 1, 1})};
+  for (const Vec3& axis : axes) {
+    for (const float angle : {0.f, 1.f, 3.f}) {
+      const Quat q = Quat::from_axis_angle(Radian{angle}, axis);
+
+      const Quat from_mat4 =
+          Quat::from_matrix(beyond::rotate(Radian{angle}, axis));
+      const Quat from_mat3 = Quat::from_matrix(to_mat3(q));
+
+      // q and -q represent the same rotation
+      REQUIRE(std::abs(dot(from_mat4, q)) == Approx(1));
+      REQUIRE(std::abs(dot(from_mat3, q)) == Approx(1));
+    }
+  }
+}
+
+TEST_CASE("Quaternion interpolation", "[beyond.core.math.quaternion]")
+{
+  const Vec3 axis = normalize(Vec3{1, -1, 2});
+  const Quat q1 = Quat::from_axis_angle(Radian{0.2f}, axis);
+  const Quat q2 = Quat::from_axis_angle(Radian{1.4f}, axis);
+
+  SECTION("slerp moves at constant angular velocity")
+  {
+    quat_match(slerp(q1, q2, 0.f), q1);
+    quat_match(slerp(q1, q2, 1.f), q2);
+    quat_match(slerp(q1, q2, 0.25f),
+               Quat::from_axis_angle(Radian{0.5f}, axis));
+  }
+
+  SECTION("slerp takes the shortest path")
+  {
+    quat_match(slerp(q1, -q2, 0.25f),
+               Quat::from_axis_angle(Radian{0.5f}, axis));
+  }
+
+  SECTION("nlerp")
+  {
+    quat_match(nlerp(q1, q2, 0.f), q1);
+    quat_match(nlerp(q1, q2, 1.f), q2);
+    // The angular velocity of nlerp is not constant, but it is symmetric
+    quat_match(nlerp(q1, q2, 0.5f),
+               Quat::from_axis_angle(Radian{0.8f}, axis));
+    quat_match(nlerp(q1, -q2, 0.5f),
+               Quat::from_axis_angle(Radian{0.8f}, axis));
+  }
+}
+
+TEST_CASE("Batch quaternion interpolation", "[beyond.core.math.quaternion]")
+{
+  // Covers every remainder of the SIMD loops
+  for (std::size_t count = 0; count < 20; ++count) {
+    std::vector<Quat> from, to;
+    std::vector<float> ts;
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto f = static_cast<float>(i);
+      const Vec3 axis = normalize(Vec3{1.f + f, 2.f - f, 0.5f});
+      from.push_back(Quat::from_axis_angle(Radian{0.1f * f}, axis));
+      // Rotations more than 180 degrees apart exercise the shortest path
+      to.push_back(Quat::from_axis_angle(Radian{0.4f * f - 2.f}, axis));
+      ts.push_back(f / 19.f);
+    }
+
+    // The batch slerp approximates the weights, so the results only match
+    // the scalar slerp approximately
+    std::vector<Quat> out(count);
+    beyond::slerp(from, to, ts, out);
+    for (std::size_t i = 0; i < count; ++i) {
+      REQUIRE(dot(out[i], slerp(from[i], to[i], ts[i])) ==
+              Approx(1).margin(1e-4));
+    }
+
+    beyond::slerp(from, to, 0.3f, out);
+    for (std::size_t i = 0; i < count; ++i) {
+      REQUIRE(dot(out[i], slerp(from[i], to[i], 0.3f)) ==
+              Approx(1).margin(1e-4));
+    }
+
+    beyond::nlerp(from, to, ts, out);
+    for (std::size_t i = 0; i < count; ++i) {
+      quat_match(out[i], nlerp(from[i], to[i], ts[i]));
+    }
+
+    // In place
+    const auto original = from;
+    beyond::nlerp(from, to, 0.6f, from);
+    for (std::size_t i = 0; i < count; ++i) {
+      quat_match(from[i], nlerp(original[i], to[i], 0.6f));
+    }
+  }
+}
+
 TEST_CASE("Quaternion serialization", "[beyond.core.math.quaternion]")
 {
   constexpr Quat q{1, {2, 3, 4}};
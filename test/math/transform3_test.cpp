@@ -0,0 +1,121 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "beyond/math/serial.hpp"
+#include "beyond/math/transform.hpp"
+#include "beyond/math/transform3.hpp"
+
+#include "matrix_test_util.hpp"
+
+#include <vector>
+
+using beyond::Mat4;
+using beyond::Point3;
+using beyond::Quat;
+using beyond::Radian;
+using beyond::Transform3;
+using beyond::Vec3;
+using beyond::Vec4;
+
+namespace {
+
+auto make_transform(float angle, Vec3 axis, Vec3 translation, Vec3 scale)
+    -> Transform3
+{
+  return {translation, Quat::from_axis_angle(Radian{angle}, normalize(axis)),
+          scale};
+}
+
+auto apply(const Mat4& m, const Point3& p) -> Point3
+{
+  const Vec4 r = m * Vec4{p.x, p.y, p.z, 1};
+  return {r.x, r.y, r.z};
+}
+
+} // anonymous namespace
+
+TEST_CASE("Transform3", "[beyond.core.math.transform3]")
+{
+  const Transform3 a =
+      make_transform(0.7f, Vec3{1, 2, 3}, Vec3{1, -2, 3}, Vec3{2, 2, 2});
+  const Transform3 b = make_transform(-1.9f, Vec3{0, 1, -1},
+                                      Vec3{-4, 0.5f, 2}, Vec3{1, 3, 0.5f});
+  const Point3 p{0.5f, -1, 2};
+  const Vec3 v{3, 1, -2};
+
+  SECTION("Identity")
+  {
+    matrix_approx_match(to_mat4(Transform3::identity()), Mat4::identity());
+    vector_approx_match(transform_point(Transform3::identity(), p), p);
+  }
+
+  SECTION("Matches the equivalent matrix")
+  {
+    const Mat4 expected = beyond::translate(b.translation) *
+                          to_mat4(b.rotation) * beyond::scale(b.scale);
+    matrix_approx_match(to_mat4(b), expected);
+    vector_approx_match(transform_point(b, p), apply(expected, p));
+
+    const Vec4 expected_v = expected * Vec4{v, 0};
+    vector_approx_match(transform_vector(b, v),
+                        Vec3{expected_v.x, expected_v.y, expected_v.z});
+  }
+
+  SECTION("Composition")
+  {
+    // Exact since the scale of the parent is uniform
+    matrix_approx_match(to_mat4(a * b), to_mat4(a) * to_mat4(b));
+    vector_approx_match(transform_point(a * b, p),
+                        transform_point(a, transform_point(b, p)));
+  }
+
+  SECTION("Inverse")
+  {
+    vector_approx_match(transform_point(inverse(a), transform_point(a, p)), p);
+    matrix_approx_match(to_mat4(inverse(a)), inverse(to_mat4(a)));
+    matrix_approx_match(to_mat4(inverse(a) * a), Mat4::identity());
+
+    // Non-uniform scales round trip when there is no rotation
+    const Transform3 scaled{Vec3{1, 2, 3}, Quat::identity(), Vec3{2, 4, 0.5f}};
+    vector_approx_match(
+        transform_point(inverse(scaled), transform_point(scaled, p)), p);
+  }
+}
+
+TEST_CASE("Transform hierarchy propagation", "[beyond.core.math.transform3]")
+{
+  using beyond::no_parent;
+
+  // 0 -> 1 -> 2
+  // 0 -> 3
+  // 4
+  const std::vector<std::uint32_t> parents = {no_parent, 0, 1, 0, no_parent};
+  std::vector<Transform3> local;
+  for (std::size_t i = 0; i < parents.size(); ++i) {
+    const auto f = static_cast<float>(i);
+    local.push_back(make_transform(0.3f * f, Vec3{1, f, 2},
+                                   Vec3{f, 1 - f, 2 * f},
+                                   Vec3{1 + f, 1 + f, 1 + f}));
+  }
+
+  std::vector<Transform3> world(local.size());
+  std::vector<Mat4> world_matrices(local.size());
+  beyond::propagate_transforms(local, parents, world, world_matrices);
+
+  const std::vector<Mat4> expected = {
+      to_mat4(local[0]),
+      to_mat4(local[0]) * to_mat4(local[1]),
+      to_mat4(local[0]) * to_mat4(local[1]) * to_mat4(local[2]),
+      to_mat4(local[0]) * to_mat4(local[3]),
+      to_mat4(local[4]),
+  };
+  for (std::size_t i = 0; i < local.size(); ++i) {
+    matrix_approx_match(to_mat4(world[i]), expected[i]);
+    matrix_approx_match(world_matrices[i], expected[i]);
+  }
+
+  // In place
+  beyond::propagate_transforms(local, parents, local);
+  for (std::size_t i = 0; i < local.size(); ++i) {
+    matrix_approx_match(to_mat4(local[i]), expected[i]);
+  }
+}
@@ -232,6 +232,33 @@ TEST_CASE("Vec Floating point only test", "[beyond.core.math.vec]")
     REQUIRE(result.z == Approx(v1.z / v1.length()));
     REQUIRE(result.w == Approx(v1.w / v1.length()));
   }
+
+  SECTION("Vec4 arithmetic")
+  {
+    const beyond::Vec4 v1{x1, y1, z1, w1};
+    const beyond::Vec4 v2{-x2, 2.f, 0.5f, -3.f};
+
+    const beyond::Vec4 sum = v1 + v2;
+    REQUIRE(sum.x == Approx(x1 - x2));
+    REQUIRE(sum.y == Approx(y1 + 2.f));
+    REQUIRE(sum.z == Approx(z1 + 0.5f));
+    REQUIRE(sum.w == Approx(w1 - 3.f));
+
+    const beyond::Vec4 difference = v1 - v2;
+    REQUIRE(difference.x == Approx(x1 + x2));
+    REQUIRE(difference.y == Approx(y1 - 2.f));
+    REQUIRE(difference.z == Approx(z1 - 0.5f));
+    REQUIRE(difference.w == Approx(w1 + 3.f));
+
+    const beyond::Vec4 product = v1 * 2.f;
+    REQUIRE(product.x == Approx(x1 * 2));
+    REQUIRE(product.y == Approx(y1 * 2));
+    REQUIRE(product.z == Approx(z1 * 2));
+    REQUIRE(product.w == Approx(w1 * 2));
+
+    REQUIRE(dot(v1, v2) ==
+            Approx(-x1 * x2 + y1 * 2.f + z1 * 0.5f - w1 * 3.f));
+  }
 }
 
 TEST_CASE("Vec Swizzling test", "[beyond.core.math.vec]")
@@ -0,0 +1,158 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "beyond/math/serial.hpp"
+#include "beyond/math/wide_float.hpp"
+
+#include "./matrix_test_util.hpp"
+
+#include <array>
+
+using Catch::Approx;
+
+// The layout does not depend on the instruction set, so that the library and
+// its users can be compiled for different ones
+static_assert(sizeof(beyond::Float4) == 16 && alignof(beyond::Float4) == 16);
+static_assert(sizeof(beyond::Float8) == 32 && alignof(beyond::Float8) == 32);
+static_assert(sizeof(beyond::Mask4) == 16 && alignof(beyond::Mask4) == 16);
+static_assert(sizeof(beyond::Mask8) == 32 && alignof(beyond::Mask8) == 32);
+
+namespace {
+
+template <std::size_t N> auto iota_lanes(float start) -> beyond::WideFloat<N>
+{
+  std::array<float, N> lanes;
+  for (std::size_t i = 0; i < N; ++i) {
+    lanes[i] = start + static_cast<float>(i);
+  }
+  return beyond::WideFloat<N>::load(lanes.data());
+}
+
+} // anonymous namespace
+
+TEMPLATE_TEST_CASE("WideFloat arithmetic", "[beyond.core.math.wide_float]",
+                   beyond::Float4, beyond::Float8)
+{
+  constexpr std::size_t N = TestType::size();
+  const auto a = iota_lanes<N>(1.f);
+  const TestType b{2.f};
+
+  for (std::size_t i = 0; i < N; ++i) {
+    const float ai = 1.f + static_cast<float>(i);
+    REQUIRE(a[i] == ai);
+    REQUIRE(b[i] == 2.f);
+    REQUIRE((a + b)[i] == ai + 2.f);
+    REQUIRE((a - b)[i] == ai - 2.f);
+    REQUIRE((a * b)[i] == ai * 2.f);
+    REQUIRE((a / b)[i] == ai / 2.f);
+    REQUIRE((-a)[i] == -ai);
+    REQUIRE(min(a, b)[i] == std::min(ai, 2.f));
+    REQUIRE(max(a, b)[i] == std::max(ai, 2.f));
+    REQUIRE(sqrt(a)[i] == Approx(std::sqrt(ai)));
+    REQUIRE(abs(b - a)[i] == std::abs(2.f - ai));
+    REQUIRE(lerp(a, b, TestType{0.25f})[i] ==
+            Approx(beyond::lerp(ai, 2.f, 0.25f)));
+  }
+
+  SECTION("Load and store")
+  {
+    std::array<float, N> lanes{};
+    a.store(lanes.data());
+    const auto loaded = TestType::load(lanes.data());
+    for (std::size_t i = 0; i < N; ++i) { REQUIRE(loaded[i] == lanes[i]); }
+  }
+}
+
+TEMPLATE_TEST_CASE("WideFloat comparisons", "[beyond.core.math.wide_float]",
+                   beyond::Float4, beyond::Float8)
+{
+  constexpr std::size_t N = TestType::size();
+  constexpr unsigned all_lanes = (1u << N) - 1;
+  const auto a = iota_lanes<N>(0.f);
+  const TestType two{2.f};
+
+  // Lanes 0 and 1 are less than 2
+  REQUIRE((a < two).bits() == 0b11u);
+  REQUIRE((a <= two).bits() == 0b111u);
+  REQUIRE((a == two).bits() == 0b100u);
+  REQUIRE((a != two).bits() == (all_lanes & ~0b100u));
+  REQUIRE((a > two).bits() == (all_lanes & ~0b111u));
+  REQUIRE((a >= two).bits() == (all_lanes & ~0b11u));
+
+  REQUIRE(((a > two) | (a < TestType{1.f})).bits() == (all_lanes & ~0b110u));
+  REQUIRE(((a >= TestType{1.f}) & (a <= two)).bits() == 0b110u);
+  REQUIRE((!(a < two)).bits() == (all_lanes & ~0b11u));
+
+  REQUIRE(any(a == two));
+  REQUIRE(!all(a == two));
+  REQUIRE(all(a < TestType{100.f}));
+  REQUIRE(none(a > TestType{100.f}));
+
+  const auto selected = select(a < two, a, -a);
+  for (std::size_t i = 0; i < N; ++i) {
+    const float ai = static_cast<float>(i);
+    REQUIRE(selected[i] == (ai < 2.f ? ai : -ai));
+  }
+}
+
+TEMPLATE_TEST_CASE("Wide vectors match the scalar vector operations",
+                   "[beyond.core.math.wide_float]", beyond::Float4,
+                   beyond::Float8)
+{
+  constexpr std::size_t N = TestType::size();
+  using WideVec3 = beyond::TVec3<TestType>;
+
+  std::array<float, N> xs, ys, zs;
+  for (std::size_t i = 0; i < N; ++i) {
+    const auto f = static_cast<float>(i);
+    xs[i] = f + 1.f;
+    ys[i] = 2.f - f;
+    zs[i] = 0.5f * f;
+  }
+  const WideVec3 v = beyond::load_vec3<N>(xs.data(), ys.data(), zs.data());
+  const beyond::Vec3 u_scalar{0.5f, -1.f, 2.f};
+  const auto u = beyond::broadcast<N>(u_scalar);
+  const TestType t{0.3f};
+
+  const WideVec3 sum = v + u;
+  const WideVec3 diff = v - u;
+  const WideVec3 scaled = v * t;
+  const WideVec3 normalized = normalize(v);
+  const WideVec3 crossed = cross(v, u);
+  const WideVec3 lerped = lerp(v, u, t);
+  const TestType dotted = dot(v, u);
+  const TestType length = v.length();
+
+  for (std::size_t i = 0; i < N; ++i) {
+    const beyond::Vec3 vi{xs[i], ys[i], zs[i]};
+    vector_approx_match(extract(v, i), vi);
+    vector_approx_match(extract(sum, i), vi + u_scalar);
+    vector_approx_match(extract(diff, i), vi - u_scalar);
+    vector_approx_match(extract(scaled, i), vi * 0.3f);
+    vector_approx_match(extract(normalized, i), normalize(vi));
+    vector_approx_match(extract(crossed, i), cross(vi, u_scalar));
+    vector_approx_match(extract(lerped, i), lerp(vi, u_scalar, 0.3f));
+    REQUIRE(dotted[i] == Approx(dot(vi, u_scalar)));
+    REQUIRE(length[i] == Approx(vi.length()));
+  }
+
+  SECTION("Store")
+  {
+    std::array<float, N> out_x{}, out_y{}, out_z{};
+    beyond::store_vec3(v, out_x.data(), out_y.data(), out_z.data());
+    REQUIRE(out_x == xs);
+    REQUIRE(out_y == ys);
+    REQUIRE(out_z == zs);
+  }
+
+  SECTION("Points")
+  {
+    const beyond::TPoint3<TestType> p{v.x, v.y, v.z};
+    const beyond::TPoint3<TestType> q = p + u;
+    const TestType d = distance(p, q);
+    for (std::size_t i = 0; i < N; ++i) {
+      REQUIRE(d[i] == Approx(u_scalar.length()));
+    }
+  }
+}
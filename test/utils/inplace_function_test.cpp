@@ -0,0 +1,66 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <beyond/utils/inplace_function.hpp>
+
+#include <array>
+#include <memory>
+#include <type_traits>
+
+#include "../counting_resource.hpp"
+#include "../raii_counter.hpp"
+
+TEST_CASE("inplace_function", "[beyond.core.util.inplace_function]")
+{
+  CountingResource resource;
+  beyond::MemoryResource& previous = beyond::set_default_resource(resource);
+
+  {
+    using Array48 = std::array<std::byte, 48>;
+    beyond::inplace_function<std::size_t() const, 48> f{
+        [data = Array48{}]() { return data.size(); }};
+    REQUIRE(f() == 48);
+
+    auto f2 = std::move(f);
+    REQUIRE(f == nullptr);
+    REQUIRE(f2() == 48);
+
+    Counters counters;
+    {
+      beyond::inplace_function<void()> f3{Small{counters}};
+      f3();
+      beyond::inplace_function<void()> f4;
+      f4 = std::move(f3);
+      f4();
+    }
+    REQUIRE(counters.invoke == 2);
+    REQUIRE(counters.constructor + counters.move ==
+            counters.destructor + counters.copy);
+  }
+
+  beyond::set_default_resource(previous);
+  REQUIRE(resource.allocations == 0);
+}
+
+TEST_CASE("inplace_function rejects callables that do not fit",
+          "[beyond.core.util.inplace_function]")
+{
+  using Function = beyond::inplace_function<void(), 16>;
+  using ConstFunction = beyond::inplace_function<void() const, 16>;
+  using Fits = decltype([x = std::array<char, 16>{}]() {});
+  using TooLarge = decltype([x = std::array<char, 17>{}]() {});
+  struct alignas(32) OverAligned {
+    void operator()() const {}
+  };
+  struct ThrowingMove {
+    ThrowingMove() = default;
+    ThrowingMove(ThrowingMove&&) noexcept(false) {}
+    void operator()() const {}
+  };
+
+  STATIC_REQUIRE(std::is_constructible_v<Function, Fits>);
+  STATIC_REQUIRE(std::is_constructible_v<ConstFunction, Fits>);
+  STATIC_REQUIRE(!std::is_constructible_v<Function, TooLarge>);
+  STATIC_REQUIRE(!std::is_constructible_v<ConstFunction, TooLarge>);
+  STATIC_REQUIRE(!std::is_constructible_v<Function, OverAligned>);
+  STATIC_REQUIRE(!std::is_constructible_v<Function, ThrowingMove>);
+}
@@ -0,0 +1,141 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <beyond/concurrency/task_queue.hpp>
+#include <beyond/utils/unique_function.hpp>
+
+#include <array>
+#include <memory>
+
+#include "../counting_resource.hpp"
+#include "../raii_counter.hpp"
+
+TEST_CASE("unique_function invocation", "[beyond.core.util.unique_function]")
+{
+  beyond::unique_function<int(int) const> f{[](int x) { return x * 2; }};
+  REQUIRE(f != nullptr);
+  REQUIRE(f(21) == 42);
+
+  beyond::unique_function<int(int) const> empty;
+  REQUIRE(empty == nullptr);
+  REQUIRE_THROWS_AS(empty(1), std::bad_function_call);
+
+  empty = std::move(f);
+  REQUIRE(f == nullptr);
+  REQUIRE(empty(2) == 4);
+}
+
+TEST_CASE("unique_function owns move-only callables",
+          "[beyond.core.util.unique_function]")
+{
+  beyond::unique_function<int()> f{
+      [p = std::make_unique<int>(42)]() { return *p; }};
+  REQUIRE(f() == 42);
+
+  auto f2 = std::move(f);
+  REQUIRE(f2() == 42);
+}
+
+TEST_CASE("unique_function lifetime", "[beyond.core.util.unique_function]")
+{
+  Counters counters;
+  {
+    beyond::unique_function<void()> f{Small{counters}};
+    f();
+    auto f2 = std::move(f);
+    f2();
+  }
+  REQUIRE(counters.invoke == 2);
+  REQUIRE(counters.constructor + counters.move ==
+          counters.destructor + counters.copy);
+}
+
+TEST_CASE("unique_function with configurable inline size",
+          "[beyond.core.util.unique_function]")
+{
+  using Array64 = std::array<std::byte, 64>;
+  auto big = [data = Array64{}]() { return data.size(); };
+
+  using SmallFunction = beyond::unique_function<std::size_t() const>;
+  using BigFunction = beyond::unique_function<std::size_t() const, 64>;
+  STATIC_REQUIRE(!SmallFunction::stores_inline<decltype(big)>);
+  STATIC_REQUIRE(BigFunction::stores_inline<decltype(big)>);
+
+  CountingResource resource;
+  SECTION("Callables that do not fit spill into the memory resource")
+  {
+    {
+      SmallFunction f{std::allocator_arg, resource, big};
+      REQUIRE(resource.allocations == 1);
+      REQUIRE(f() == 64);
+
+      // Moves steal the heap allocation
+      SmallFunction f2 = std::move(f);
+      REQUIRE(resource.allocations == 1);
+      REQUIRE(f2() == 64);
+    }
+    REQUIRE(resource.deallocations == 1);
+  }
+
+  SECTION("Callables that fit are stored inline")
+  {
+    BigFunction f{std::allocator_arg, resource, big};
+    BigFunction f2 = std::move(f);
+    REQUIRE(f2() == 64);
+    REQUIRE(resource.allocations == 0);
+  }
+}
+
+TEST_CASE("unique_function stores small captures inline",
+          "[beyond.core.util.unique_function]")
+{
+  int x = 0;
+  auto pointer_capture = [&x]() { ++x; };
+  auto int_capture = [y = 1]() { return y; };
+  using Function = beyond::unique_function<void()>;
+  STATIC_REQUIRE(Function::stores_inline<decltype(pointer_capture)>);
+  STATIC_REQUIRE(Function::stores_inline<decltype(int_capture)>);
+
+  // Over-aligned callables do not fit the storage
+  struct alignas(32) OverAligned {
+    void operator()() const {}
+  };
+  STATIC_REQUIRE(!Function::stores_inline<OverAligned>);
+}
+
+TEST_CASE("TaskQueue::Task stores 64 bytes of captures inline",
+          "[beyond.core.util.unique_function]")
+{
+  auto task = [data = std::array<float, 16>{}]() { (void)data; };
+  STATIC_REQUIRE(beyond::TaskQueue::Task::stores_inline<decltype(task)>);
+  STATIC_REQUIRE(sizeof(beyond::TaskQueue::Task) == 80);
+}
+
+TEST_CASE("unique_function relocates trivial callables",
+          "[beyond.core.util.unique_function]")
+{
+  int x = 1;
+  auto trivial = [&x, y = 2]() { return x + y; };
+  auto non_trivial = [p = std::make_unique<int>(2)]() { return *p; };
+
+  using Function = beyond::unique_function<int()>;
+  STATIC_REQUIRE(Function::relocates_trivially<decltype(trivial)>);
+  STATIC_REQUIRE(!Function::relocates_trivially<decltype(non_trivial)>);
+
+  Function f{trivial};
+  Function f2{std::move(f)};
+  REQUIRE(f == nullptr);
+  REQUIRE(f2() == 3);
+
+  Function f3{std::move(non_trivial)};
+  f3 = std::move(f2);
+  REQUIRE(f2 == nullptr);
+  REQUIRE(f3() == 3);
+
+  beyond::TaskQueue queue;
+  int counter = 0;
+  queue.push([&counter]() { ++counter; });
+  auto task = queue.pop();
+  REQUIRE(task != beyond::nullopt);
+  (*task)();
+  REQUIRE(counter == 1);
+}